@@ -0,0 +1,204 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mActivityInputHandler.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for the input handler used to count the traffic on
+//              monitored ports.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-18
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mActivityInputHandler.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for the input handler used to count the traffic on monitored
+ ports. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+ActivityInputHandler::ActivityInputHandler(void) :
+    inherited(), _counters()
+{
+    ODL_ENTER(); //####
+    ODL_EXIT_P(this); //####
+} // ActivityInputHandler::ActivityInputHandler
+
+ActivityInputHandler::~ActivityInputHandler(void)
+{
+    ODL_OBJENTER(); //####
+    const ScopedWriteLock lock(_lock);
+
+    for (ActivityCounterMap::iterator walker(_counters.begin()); _counters.end() != walker;
+         ++walker)
+    {
+        delete walker->second;
+    }
+    _counters.clear();
+    ODL_OBJEXIT(); //####
+} // ActivityInputHandler::~ActivityInputHandler
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+ActivityInputHandler::addPort(const YarpString & portName)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("portName = ", portName); //####
+    const ScopedWriteLock lock(_lock);
+
+    if (_counters.end() == _counters.find(portName))
+    {
+        _counters.insert(ActivityCounterMap::value_type(portName, new ActivityCounter));
+    }
+    ODL_OBJEXIT(); //####
+} // ActivityInputHandler::addPort
+
+void
+ActivityInputHandler::collectSamples(const double        elapsedTime,
+                                     ActivitySampleMap & samples)
+{
+    ODL_OBJENTER(); //####
+    ODL_D1("elapsedTime = ", elapsedTime); //####
+    ODL_P1("samples = ", &samples); //####
+    // Only read access is needed, as the counters are reset without changing the set of counters.
+    const ScopedReadLock lock(_lock);
+    double               scale = ((0 < elapsedTime) ? (1000 / elapsedTime) : 0);
+
+    samples.clear();
+    for (ActivityCounterMap::const_iterator walker(_counters.begin()); _counters.end() != walker;
+         ++walker)
+    {
+        ActivitySample aSample;
+
+        aSample._bytesPerSecond = (walker->second->_bytes.exchange(0) * scale);
+        aSample._messagesPerSecond = (walker->second->_messages.exchange(0) * scale);
+        samples.insert(ActivitySampleMap::value_type(walker->first, aSample));
+    }
+    ODL_OBJEXIT(); //####
+} // ActivityInputHandler::collectSamples
+
+#if (! MAC_OR_LINUX_)
+# pragma warning(push)
+# pragma warning(disable: 4100)
+#endif // ! MAC_OR_LINUX_
+bool
+ActivityInputHandler::handleInput(const yarp::os::Bottle &     input,
+                                  const YarpString &           senderChannel,
+                                  yarp::os::ConnectionWriter * replyMechanism,
+                                  const size_t                 numBytes)
+{
+#if (! defined(ODL_ENABLE_LOGGING_))
+# if MAC_OR_LINUX_
+#  pragma unused(input,replyMechanism)
+# endif // MAC_OR_LINUX_
+#endif // ! defined(ODL_ENABLE_LOGGING_)
+    ODL_OBJENTER(); //####
+    ODL_S2s("senderChannel = ", senderChannel, "got ", input.toString()); //####
+    ODL_P1("replyMechanism = ", replyMechanism); //####
+    ODL_LL1("numBytes = ", numBytes); //####
+    bool                 result = true;
+    const ScopedReadLock lock(_lock);
+
+    // The message is only counted, so that a busy port costs no more than a lookup and two
+    // increments.
+    ActivityCounterMap::const_iterator match(_counters.find(senderChannel));
+
+    if (_counters.end() != match)
+    {
+        match->second->_bytes += static_cast<int64>(numBytes);
+        ++(match->second->_messages);
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ActivityInputHandler::handleInput
+#if (! MAC_OR_LINUX_)
+# pragma warning(pop)
+#endif // ! MAC_OR_LINUX_
+
+void
+ActivityInputHandler::removePort(const YarpString & portName)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("portName = ", portName); //####
+    const ScopedWriteLock lock(_lock);
+    ActivityCounterMap::iterator match(_counters.find(portName));
+
+    if (_counters.end() != match)
+    {
+        delete match->second;
+        _counters.erase(match);
+    }
+    ODL_OBJEXIT(); //####
+} // ActivityInputHandler::removePort
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
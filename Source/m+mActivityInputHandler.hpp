@@ -0,0 +1,146 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mActivityInputHandler.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for the input handler used to count the traffic on
+//              monitored ports.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-18
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmActivityInputHandler_HPP_))
+# define mpmActivityInputHandler_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# include <m+m/m+mBaseInputHandler.hpp>
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for the input handler used to count the traffic on monitored
+ ports. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    /*! @brief A handler that counts the messages received from monitored ports.
+
+     The messages are not examined or kept; only their number and size are recorded, against the
+     name of the port that sent them. */
+    class ActivityInputHandler : public MplusM::Common::BaseInputHandler
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The class that this class is derived from. */
+        typedef BaseInputHandler inherited;
+
+    public :
+
+        /*! @brief The constructor. */
+        ActivityInputHandler(void);
+
+        /*! @brief The destructor. */
+        virtual
+        ~ActivityInputHandler(void);
+
+        /*! @brief Start counting the messages from a port.
+         @param[in] portName The name of the port. */
+        void
+        addPort(const YarpString & portName);
+
+        /*! @brief Return the traffic on each port since the previous call and restart the counts.
+         @param[in] elapsedTime The time since the previous call, in milliseconds.
+         @param[out] samples The traffic on each port. */
+        void
+        collectSamples(const double        elapsedTime,
+                       ActivitySampleMap & samples);
+
+        /*! @brief Stop counting the messages from a port.
+         @param[in] portName The name of the port. */
+        void
+        removePort(const YarpString & portName);
+
+    protected :
+
+    private :
+
+        /*! @brief The copy constructor.
+         @param[in] other The object to be copied. */
+        ActivityInputHandler(const ActivityInputHandler & other);
+
+        /*! @brief Process partially-structured input data.
+         @param[in] input The partially-structured input data.
+         @param[in] senderChannel The name of the channel used to send the input data.
+         @param[in] replyMechanism @c NULL if no reply is expected and non-@c NULL otherwise.
+         @param[in] numBytes The number of bytes available on the connection.
+         @returns @c true if the input was correctly structured and successfully processed. */
+        virtual bool
+        handleInput(const yarp::os::Bottle &     input,
+                    const YarpString &           senderChannel,
+                    yarp::os::ConnectionWriter * replyMechanism,
+                    const size_t                 numBytes);
+
+        /*! @brief The assignment operator.
+         @param[in] other The object to be copied.
+         @returns The updated object. */
+        ActivityInputHandler &
+        operator =(const ActivityInputHandler & other);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The traffic counters for the monitored ports. */
+        ActivityCounterMap _counters;
+
+        /*! @brief A lock to manage access to the set of counters. Counting only needs read access,
+         so that messages from different ports can be counted at the same time. */
+        ReadWriteLock _lock;
+
+    }; // ActivityInputHandler
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmActivityInputHandler_HPP_)
@@ -0,0 +1,347 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mActivityThread.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for the background sampling of port activity.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-18
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mActivityThread.hpp"
+#include "m+mActivityInputHandler.hpp"
+#include "m+mContentPanel.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for the background sampling of port activity. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+using namespace std;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The time between samples of the traffic, in milliseconds. This caps the rate at which
+ the activity markers are redrawn. */
+static const int kSampleInterval = 200;
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+ActivityThread::ActivityThread(ContentPanel & owner) :
+    inherited("activity sampler"), _samples(), _pendingRequests(), _markedPorts(),
+    _monitoredPorts(), _owner(owner), _handler(new ActivityInputHandler), _tapChannel(NULL),
+    _lastSampleTime(0)
+{
+    ODL_ENTER(); //####
+    ODL_P1("owner = ", &owner); //####
+    ODL_EXIT_P(this); //####
+} // ActivityThread::ActivityThread
+
+ActivityThread::~ActivityThread(void)
+{
+    ODL_OBJENTER(); //####
+    stopThread(3000); // Give thread 3 seconds to shut down.
+    if (_tapChannel)
+    {
+        // Closing the channel drops the connections from the monitored ports.
+#if defined(MpM_DoExplicitClose)
+        _tapChannel->close();
+#endif // defined(MpM_DoExplicitClose)
+        Common::GeneralChannel::RelinquishChannel(_tapChannel);
+    }
+    _handler = NULL;
+    ODL_OBJEXIT(); //####
+} // ActivityThread::~ActivityThread
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+bool
+ActivityThread::applyRequests(void)
+{
+    ODL_OBJENTER(); //####
+    ActivityStateMap requests;
+
+    {
+        const ScopedLock lock(_lock);
+
+        requests.swap(_pendingRequests);
+    }
+    for (ActivityStateMap::const_iterator walker(requests.begin()); requests.end() != walker;
+         ++walker)
+    {
+        const YarpString & portName = walker->first;
+        bool               isMonitored = (_monitoredPorts.end() != _monitoredPorts.find(portName));
+
+        if (walker->second && openTapChannel())
+        {
+            // A port that is already monitored is connected again, as its connection is lost if
+            // the port went away and came back.
+            if (_monitoredPorts.empty())
+            {
+                _lastSampleTime = Time::getMillisecondCounterHiRes();
+            }
+            if (! isMonitored)
+            {
+                _handler->addPort(portName);
+            }
+            if (Utilities::NetworkConnectWithRetries(portName, _tapChannelName,
+                                                     STANDARD_WAIT_TIME_, false, CheckForExit,
+                                                     NULL))
+            {
+                _monitoredPorts.insert(portName);
+            }
+            else
+            {
+                char buffer1[DATE_TIME_BUFFER_SIZE_];
+                char buffer2[DATE_TIME_BUFFER_SIZE_];
+
+                _handler->removePort(portName);
+                _monitoredPorts.erase(portName);
+                _markedPorts.erase(portName);
+                Utilities::GetDateAndTime(buffer1, sizeof(buffer1), buffer2, sizeof(buffer2));
+                std::cerr << buffer1 << " " << buffer2 << " Unable to monitor the activity of " <<
+                            portName << std::endl;
+            }
+        }
+        else if ((! walker->second) && isMonitored)
+        {
+            if (! Utilities::NetworkDisconnectWithRetries(portName, _tapChannelName,
+                                                          STANDARD_WAIT_TIME_, CheckForExit, NULL))
+            {
+                ODL_LOG("(! Utilities::NetworkDisconnectWithRetries(portName, " //####
+                        "_tapChannelName, STANDARD_WAIT_TIME_, CheckForExit, NULL))"); //####
+            }
+            _handler->removePort(portName);
+            _monitoredPorts.erase(portName);
+            _markedPorts.erase(portName);
+            {
+                const ScopedLock lock(_lock);
+
+                _samples.erase(portName);
+            }
+        }
+    }
+    bool result = (! _monitoredPorts.empty());
+
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ActivityThread::applyRequests
+
+void
+ActivityThread::collectSamples(ActivityStateMap & changes)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("changes = ", &changes); //####
+    ActivitySampleMap samples;
+    double            now = Time::getMillisecondCounterHiRes();
+
+    _handler->collectSamples(now - _lastSampleTime, samples);
+    _lastSampleTime = now;
+    for (ActivitySampleMap::const_iterator walker(samples.begin()); samples.end() != walker;
+         ++walker)
+    {
+        bool wasMarked = (_markedPorts.end() != _markedPorts.find(walker->first));
+        // Continuous traffic makes the marker blink at half the sampling rate, so that it reads as
+        // activity rather than as a state.
+        bool isMarked = ((0 < walker->second._messagesPerSecond) && (! wasMarked));
+
+        if (isMarked != wasMarked)
+        {
+            changes[walker->first] = isMarked;
+            if (isMarked)
+            {
+                _markedPorts.insert(walker->first);
+            }
+            else
+            {
+                _markedPorts.erase(walker->first);
+            }
+        }
+    }
+    {
+        const ScopedLock lock(_lock);
+
+        _samples.swap(samples);
+    }
+    ODL_OBJEXIT(); //####
+} // ActivityThread::collectSamples
+
+bool
+ActivityThread::getActivity(const YarpString & portName,
+                            ActivitySample &   sample)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("portName = ", portName); //####
+    ODL_P1("sample = ", &sample); //####
+    const ScopedLock                  lock(_lock);
+    ActivitySampleMap::const_iterator match(_samples.find(portName));
+    bool                              result = (_samples.end() != match);
+
+    if (result)
+    {
+        sample = match->second;
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ActivityThread::getActivity
+
+bool
+ActivityThread::openTapChannel(void)
+{
+    ODL_OBJENTER(); //####
+    // The channel is opened when it's first needed, as the network might not be available when
+    // the thread is created.
+    if (! _tapChannel)
+    {
+        _tapChannel = new Common::GeneralChannel(false);
+        if (_tapChannel)
+        {
+            _tapChannelName = Common::GetRandomChannelName(HIDDEN_CHANNEL_PREFIX_ "activity_/"
+                                                           DEFAULT_CHANNEL_ROOT_);
+            _tapChannel->setInputMode(true);
+            _tapChannel->setOutputMode(false);
+            if (_tapChannel->openWithRetries(_tapChannelName, STANDARD_WAIT_TIME_))
+            {
+                _tapChannel->setReader(*_handler);
+            }
+            else
+            {
+                Common::GeneralChannel::RelinquishChannel(_tapChannel);
+                _tapChannel = NULL;
+            }
+        }
+    }
+    bool result = (NULL != _tapChannel);
+
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ActivityThread::openTapChannel
+
+void
+ActivityThread::requestMonitoring(const YarpString & portName,
+                                  const bool         monitor)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("portName = ", portName); //####
+    ODL_B1("monitor = ", monitor); //####
+    {
+        const ScopedLock lock(_lock);
+
+        _pendingRequests[portName] = monitor;
+    }
+    notify();
+    ODL_OBJEXIT(); //####
+} // ActivityThread::requestMonitoring
+
+void
+ActivityThread::run(void)
+{
+    ODL_OBJENTER(); //####
+    for ( ; ! threadShouldExit(); )
+    {
+        if (applyRequests())
+        {
+            wait(kSampleInterval);
+            if (! threadShouldExit())
+            {
+                ActivityStateMap changes;
+
+                collectSamples(changes);
+                if (! changes.empty())
+                {
+                    triggerMarkerUpdate(changes);
+                }
+            }
+        }
+        else
+        {
+            // Nothing is being monitored, so there's nothing to do until a request is made.
+            wait(-1);
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // ActivityThread::run
+
+void
+ActivityThread::triggerMarkerUpdate(const ActivityStateMap & changes)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("changes = ", &changes); //####
+    // Because this is a background thread, we mustn't do any UI work without first grabbing a
+    // MessageManagerLock.
+    const MessageManagerLock mml(Thread::getCurrentThread());
+
+    // If something is trying to kill this job, the lock will fail, in which case we'd better
+    // return.
+    if (mml.lockWasGained())
+    {
+        _owner.setActivityMarkers(changes);
+    }
+    ODL_OBJEXIT(); //####
+} // ActivityThread::triggerMarkerUpdate
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
@@ -0,0 +1,178 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mActivityThread.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for the background sampling of port activity.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-18
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmActivityThread_HPP_))
+# define mpmActivityThread_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for the background sampling of port activity. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    class ActivityInputHandler;
+    class ContentPanel;
+
+    /*! @brief A background thread that samples the traffic on monitored output ports.
+     A single hidden channel is connected to all the monitored ports. The messages that arrive on it
+     are only counted, and the counts are collected at a fixed interval, so that the activity
+     markers are updated at a capped rate however busy the ports are. */
+    class ActivityThread : public Thread
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The class that this class is derived from. */
+        typedef Thread inherited;
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in] owner The panel that displays the entities. */
+        explicit
+        ActivityThread(ContentPanel & owner);
+
+        /*! @brief The destructor. */
+        virtual
+        ~ActivityThread(void);
+
+        /*! @brief Return the traffic seen on a port during the most recent sampling interval.
+         @param[in] portName The name of the port.
+         @param[out] sample The traffic seen on the port.
+         @returns @c true if the port is being monitored and has been sampled and @c false
+         otherwise. */
+        bool
+        getActivity(const YarpString & portName,
+                    ActivitySample &   sample);
+
+        /*! @brief Request that a port be monitored or no longer be monitored.
+         @param[in] portName The name of the port.
+         @param[in] monitor @c true if the port is to be monitored and @c false if it is no longer
+         to be monitored. */
+        void
+        requestMonitoring(const YarpString & portName,
+                          const bool         monitor);
+
+    protected :
+
+    private :
+
+        /*! @brief Connect or disconnect the ports for which requests have been made.
+         @returns @c true if any ports are being monitored and @c false otherwise. */
+        bool
+        applyRequests(void);
+
+        /*! @brief Collect the traffic seen since the previous sample and work out which activity
+         markers need to change.
+         @param[out] changes The ports whose activity markers need to change, with their new
+         states. */
+        void
+        collectSamples(ActivityStateMap & changes);
+
+        /*! @brief Open the hidden channel that the monitored ports are connected to, if it is not
+         already open.
+         @returns @c true if the channel is open and @c false otherwise. */
+        bool
+        openTapChannel(void);
+
+        /*! @brief Perform the background sampling. */
+        virtual void
+        run(void);
+
+        /*! @brief Tell the displayed panel to update the activity markers.
+         @param[in] changes The ports whose activity markers need to change, with their new
+         states. */
+        void
+        triggerMarkerUpdate(const ActivityStateMap & changes);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The most recent traffic samples. */
+        ActivitySampleMap _samples;
+
+        /*! @brief The requests that have not yet been applied. */
+        ActivityStateMap _pendingRequests;
+
+        /*! @brief The ports whose activity markers are shown. */
+        PortSet _markedPorts;
+
+        /*! @brief The ports that are connected to the hidden channel. */
+        PortSet _monitoredPorts;
+
+        /*! @brief The name of the hidden channel. */
+        YarpString _tapChannelName;
+
+        /*! @brief A lock to manage access to shared resources. */
+        CriticalSection _lock;
+
+        /*! @brief The panel that displays the entities. */
+        ContentPanel & _owner;
+
+        /*! @brief The handler that counts the messages arriving on the hidden channel. */
+        ScopedPointer<ActivityInputHandler> _handler;
+
+        /*! @brief The hidden channel that the monitored ports are connected to. */
+        MplusM::Common::GeneralChannel * _tapChannel;
+
+        /*! @brief The time at which the traffic was last sampled, in milliseconds. */
+        double _lastSampleTime;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ActivityThread)
+
+    }; // ActivityThread
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmActivityThread_HPP_)
@@ -42,6 +42,7 @@
 #include "m+mContentPanel.hpp"
 #include "m+mEntitiesPanel.hpp"
 #include "m+mManagerApplication.hpp"
+#include "m+mMetricsThread.hpp"
 
 //#include <odlEnable.h>
 #include <odlInclude.h>
@@ -70,6 +71,13 @@ using namespace std;
 # pragma mark Private structures, constants and variables
 #endif // defined(__APPLE__)
 
+/*! @brief The colour to be used for the heading of a container that has raised a metrics
+ alert. */
+static const Colour & kAlertHeadingBackgroundColour(Colours::darkred);
+
+/*! @brief The opacity of a container that doesn't match the active search. */
+static const float kDimmedOpacity = 0.3;
+
 /*! @brief The colour to be used for the gap between entries. */
 static const Colour & kGapFillColour(Colours::grey);
 
@@ -79,9 +87,27 @@ static const Colour & kHeadingBackgroundColour(Colours::darkgrey);
 /*! @brief The colour to be used for text in the entry. */
 static const Colour & kHeadingTextColour(Colours::white);
 
+/*! @brief The colour to be used for the heading of a container that stands in for a host. */
+static const Colour & kHostHeadingBackgroundColour(Colours::darkslategrey);
+
+/*! @brief The colour to be used for the heading of a container that has not yet been confirmed
+ by a scan. */
+static const Colour & kStaleHeadingBackgroundColour(Colours::lightslategrey);
+
+/*! @brief The colour to be used for text in the heading of a container that has not yet been
+ confirmed by a scan. */
+static const Colour & kStaleHeadingTextColour(Colours::lightgrey);
+
 /*! @brief The amount of space between each row of the entries in the container. */
 static const float kEntryGap = 1;
 
+/*! @brief The colour used to draw the recent traffic of a service. */
+static const Colour kSparklineColour(Colours::lightgreen.withAlpha(0.6f));
+
+/*! @brief The amount of space around the container that might be touched by the selection
+ marker. */
+static const int kSelectionMargin = 8;
+
 /*! @brief The amount of space to the left of the text being displayed. */
 static const float kTextInset = 2;
 
@@ -110,12 +136,10 @@ ChannelContainer::ChannelContainer(const ContainerKind kind,
                                    const YarpString &  requests,
                                    EntitiesPanel &     owner) :
     inherited(title.c_str()), _behaviour(behaviour), _description(description),
-    _extraInfo(extraInfo), _IPAddress(ipAddress), _requests(requests),
-#if defined(USE_OGDF_POSITIONING_)
-    _node(NULL),
-#endif // defined(USE_OGDF_POSITIONING_)
-    _owner(owner), _kind(kind), _hidden(false), _newlyCreated(true), _selected(false),
-    _visited(false)
+    _extraInfo(extraInfo), _IPAddress(ipAddress), _requests(requests), _owner(owner),
+    _activePort(NULL), _hostGroup(NULL), _kind(kind), _alerting(false), _collapsed(false),
+    _dimmed(false), _drawAsGlyph(false), _hidden(false), _newlyCreated(true), _selected(false),
+    _stale(false), _visited(false)
 {
     ODL_ENTER(); //####
     ODL_S4s("title = ", title, "behaviour = ", behaviour, "description = ", description, //####
@@ -124,7 +148,7 @@ ChannelContainer::ChannelContainer(const ContainerKind kind,
     Font & headerFont = _owner.getNormalFont();
 
     _titleHeight = static_cast<int>(headerFont.getHeight());
-    setSize(static_cast<int>(headerFont.getStringWidthFloat(getName() + " ") + getTextInset()),
+    setSize(static_cast<int>(headerFont.getStringWidthFloat(getTitle() + " ") + getTextInset()),
             _titleHeight);
     ODL_LL2("width = ", getWidth(), "height = ", getHeight()); //####
     setOpaque(true);
@@ -145,7 +169,13 @@ ChannelContainer::~ChannelContainer(void)
             _owner.forgetPort(aPort);
         }
     }
-    deleteAllChildren();
+    for (ChannelEntryList::const_iterator walker(_ports.begin()); _ports.end() != walker; ++walker)
+    {
+        ChannelEntry * aPort = *walker;
+
+        delete aPort;
+    }
+    _ports.clear();
     for (size_t ii = 0, mm = _argumentList.size(); mm > ii; ++ii)
     {
         Utilities::BaseArgumentDescriptor * argDesc = _argumentList[ii];
@@ -181,22 +211,36 @@ ChannelContainer::addPort(const YarpString &  portName,
     ODL_S4s("portName = ", portName, "portNumber = ", portNumber, "portProtocol = ", //####
             portProtocol, "protocolDescription = ", protocolDescription); //####
     int            countBefore = getNumPorts();
+    int            oldWidth = getWidth();
     ChannelEntry * aPort = new ChannelEntry(this, portName, portNumber, portProtocol,
                                             protocolDescription, portKind, direction);
-    float          newWidth = static_cast<float>(jmax(aPort->getWidth(), getWidth()));
+    float          newWidth = static_cast<float>(jmax(aPort->getWidth(), oldWidth));
     float          newHeight = aPort->getHeight() + getHeight() + kEntryGap;
 
     ODL_LL2("newWidth = ", newWidth, "newHeight = ", newHeight); //####
     aPort->setTopLeftPosition(0, static_cast<int>(getHeight() + kEntryGap));
     setSize(static_cast<int>(newWidth), static_cast<int>(newHeight));
+    _ports.push_back(aPort);
+#if (! defined(USE_FLYWEIGHT_PORTS_))
     addAndMakeVisible(aPort);
-    for (int ii = 0; countBefore >= ii; ++ii)
+    if (_drawAsGlyph)
     {
-        ChannelEntry * bPort = getPort(ii);
-
-        if (bPort)
+        aPort->setVisible(false);
+    }
+#endif // ! defined(USE_FLYWEIGHT_PORTS_)
+    aPort->setSize(static_cast<int>(newWidth), aPort->getHeight());
+    // The earlier rows only need to be widened when the new port is wider than the container
+    // was, which avoids touching every row for each port that is added.
+    if (oldWidth < newWidth)
+    {
+        for (int ii = 0; countBefore > ii; ++ii)
         {
-            bPort->setSize(static_cast<int>(newWidth), bPort->getHeight());
+            ChannelEntry * bPort = getPort(ii);
+
+            if (bPort)
+            {
+                bPort->setSize(static_cast<int>(newWidth), bPort->getHeight());
+            }
         }
     }
     if (0 < countBefore)
@@ -384,6 +428,10 @@ ChannelContainer::displayAndProcessPopupMenu(void)
 
     switch (result)
     {
+        case kPopupCollapseHostGroup :
+            _owner.setHostGroupCollapsed(_hostGroup, true);
+            break;
+
         case kPopupConfigureService :
             configureTheService();
             break;
@@ -404,6 +452,10 @@ ChannelContainer::displayAndProcessPopupMenu(void)
             displayMetrics();
             break;
 
+        case kPopupExpandHostGroup :
+            _owner.setHostGroupCollapsed(this, false);
+            break;
+
         case kPopupHideEntity :
             hide();
             break;
@@ -441,6 +493,12 @@ ChannelContainer::displayInformation(const bool moreDetails)
             thePanelDescription = "A standard entity";
             break;
 
+        case kContainerKindHost :
+            thePanelDescription = "A host with ";
+            thePanelDescription += String(static_cast<int>(_groupMembers.size())).toStdString();
+            thePanelDescription += " standalone ports";
+            break;
+
         default :
             break;
 
@@ -518,68 +576,143 @@ ChannelContainer::displayMetrics(void)
 {
     ODL_OBJENTER(); //####
                        // Popup of metrics.
-    String      result;
-    StringArray metricsArray = getMetrics();
-    int         numRows = metricsArray.size();
+    String            result;
+    MetricsRecordList records = getMetrics();
 
-    for (int ii = 0; ii < numRows; ++ii)
+    for (MetricsRecordList::const_iterator walker(records.begin()); records.end() != walker;
+         ++walker)
     {
-        const String & aRow = metricsArray[ii];
-
-        if (0 < ii)
+        if (records.begin() != walker)
         {
             result += "\n";
         }
-        result += formatMetricRow(aRow) + "\n";
+        result += formatMetricsRecord(*walker) + "\n";
     }
     DisplayInformationPanel(this, result, String("Metrics for ") + getName());
     ODL_OBJEXIT(); //####
 } // ChannelContainer::displayMetrics
 
 void
-ChannelContainer::drawOutgoingConnections(Graphics & gg)
+ChannelContainer::drawMetricsSparkline(Graphics &                   gg,
+                                       const juce::Rectangle<int> & area)
 {
     ODL_OBJENTER(); //####
-    ODL_P1("gg = ", &gg); //####
+    ODL_P2("gg = ", &gg, "area = ", &area); //####
+    ContentPanel * content = _owner.getContent();
+    ChannelEntry * servicePort = getServicePort();
+    MetricsHistory history;
+
+    if (content && servicePort &&
+        content->getMetricsThread().getServiceHistory(servicePort->getPortName(), history))
+    {
+        MetricsRateList rates;
+
+        MetricsThread::getRateHistory(history, rates);
+        if (1 < rates.size())
+        {
+            double maxRate = 0;
+
+            for (MetricsRateList::const_iterator walker(rates.begin()); rates.end() != walker;
+                 ++walker)
+            {
+                maxRate = jmax(maxRate, *walker);
+            }
+            if (0 < maxRate)
+            {
+                // The line is scaled to the busiest interval in the history, and is spread over
+                // the whole heading so that it doesn't change the size of the container.
+                juce::Rectangle<float> lineArea(area.toFloat().reduced(1));
+                float                  step = (lineArea.getWidth() / (METRICS_HISTORY_SIZE_ - 2));
+                float                  xx = (lineArea.getRight() - (step * (rates.size() - 1)));
+                Path                   line;
+
+                for (size_t ii = 0, mm = rates.size(); mm > ii; ++ii, xx += step)
+                {
+                    float yy = static_cast<float>(lineArea.getBottom() - (lineArea.getHeight() *
+                                                                          rates[ii] / maxRate));
+
+                    if (0 == ii)
+                    {
+                        line.startNewSubPath(xx, yy);
+                    }
+                    else
+                    {
+                        line.lineTo(xx, yy);
+                    }
+                }
+                gg.setColour(kSparklineColour);
+                gg.strokePath(line, PathStrokeType(1));
+            }
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // ChannelContainer::drawMetricsSparkline
+
+size_t
+ChannelContainer::drawOutgoingConnections(Graphics &                   gg,
+                                          const juce::Rectangle<int> & drawArea)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("gg = ", &gg, "drawArea = ", &drawArea); //####
+    size_t count = 0;
+
     for (int ii = 0, mm = getNumPorts(); mm > ii; ++ii)
     {
         ChannelEntry * aPort = getPort(ii);
 
         if (aPort)
         {
-            aPort->drawOutgoingConnections(gg);
+            count += aPort->drawOutgoingConnections(gg, drawArea);
         }
     }
-    ODL_OBJEXIT(); //####
+    ODL_OBJEXIT_LL(count); //####
+    return count;
 } // ChannelContainer::drawOutgoingConnections
 
 String
-ChannelContainer::formatMetricRow(const String & aRow)
+ChannelContainer::formatMetricsRecord(const MetricsRecord & aRecord)
 {
     ODL_OBJENTER();
-    ODL_S1s("aRow = ", aRow.toStdString()); //####
-    String      result;
-    StringArray asPieces;
-
-    asPieces.addTokens(aRow, "\t", "");
-    if (7 == asPieces.size())
+    ODL_P1("aRecord = ", &aRecord); //####
+    const MetricsSample & counters = aRecord._counters;
+    String                result;
+    ContentPanel *        content = _owner.getContent();
+    MetricsHistory        history;
+    MetricsRates          rates;
+    StoredRates           storedRates;
+
+    result = String("Channel:      ") + aRecord._channelName.c_str() + "\n";
+    result += "In bytes:     " + String(counters._inBytes) + "\n";
+    result += "Out bytes:    " + String(counters._outBytes) + "\n";
+    result += "In messages:  " + String(counters._inMessages) + "\n";
+    result += "Out messages: " + String(counters._outMessages);
+    // The rates come from the background collection, as a single set of counters can't show them.
+    if (content && content->getMetricsThread().getChannelHistory(aRecord._channelName, history) &&
+        MetricsThread::getLatestRates(history, rates))
+    {
+        result += "\nIn bytes/s:   " + String(rates._inBytesPerSecond, 1) + "\n";
+        result += "Out bytes/s:  " + String(rates._outBytesPerSecond, 1) + "\n";
+        result += "In msgs/s:    " + String(rates._inMessagesPerSecond, 1) + "\n";
+        result += "Out msgs/s:   " + String(rates._outMessagesPerSecond, 1);
+    }
+    // The longer-term averages are worked out from the stored samples by the background
+    // collection, so that the disk isn't read here.
+    if (content && content->getMetricsThread().getStoredRates(aRecord._channelName, storedRates))
     {
-        // We are ignoring the date and time information.
-        String channelName = asPieces[0];
-        String inBytes = asPieces[3];
-        String outBytes = asPieces[4];
-        String inMessages = asPieces[5];
-        String outMessages = asPieces[6];
-
-        result = "Channel:      " + channelName + "\n";
-        result += "In bytes:     " + inBytes + "\n";
-        result += "Out bytes:    " + outBytes + "\n";
-        result += "In messages:  " + inMessages + "\n";
-        result += "Out messages: " + outMessages;
+        if (storedRates._hasHour)
+        {
+            result += "\nHour bytes/s: " + String(storedRates._hour._inBytesPerSecond, 1) +
+                      " in, " + String(storedRates._hour._outBytesPerSecond, 1) + " out";
+        }
+        if (storedRates._hasDay)
+        {
+            result += "\nDay bytes/s:  " + String(storedRates._day._inBytesPerSecond, 1) +
+                      " in, " + String(storedRates._day._outBytesPerSecond, 1) + " out";
+        }
     }
     ODL_OBJEXIT_S(result.toStdString().c_str());
     return result;
-} // ChannelContainer::formatMetricRow
+} // ChannelContainer::formatMetricsRecord
 
 MplusM::Utilities::BaseArgumentDescriptor *
 ChannelContainer::getArgumentDescriptor(const size_t idx)
@@ -601,11 +734,11 @@ const
     return result;
 } // ChannelContainer::getArgumentDescriptor
 
-StringArray
+MetricsRecordList
 ChannelContainer::getMetrics(void)
 {
     ODL_OBJENTER(); //####
-    StringArray result;
+    MetricsRecordList result;
 
     for (int ii = 0, mm = getNumPorts(); mm > ii; ++ii)
     {
@@ -613,14 +746,8 @@ ChannelContainer::getMetrics(void)
 
         if (aPort && aPort->isService())
         {
-            yarp::os::Bottle metrics;
-
-            if (Utilities::GetMetricsForService(aPort->getPortName(), metrics, STANDARD_WAIT_TIME_))
+            if (MetricsThread::getMetricsForService(aPort->getPortName(), result))
             {
-                String metricsString = Utilities::ConvertMetricsToString(metrics,
-                                                             Common::kOutputFlavourTabs).c_str();
-
-                result.addLines(metricsString);
                 break;
             }
 
@@ -634,36 +761,59 @@ bool
 ChannelContainer::getMetricsState(void)
 {
     ODL_OBJENTER(); //####
-    bool result = false;
+    ContentPanel * content = _owner.getContent();
+    ChannelEntry * servicePort = getServicePort();
+    bool           result = false;
+
+    if (content && servicePort)
+    {
+        // If the state isn't known yet, the result is left as 'not collecting'.
+        content->getMetricsThread().getMetricsState(servicePort->getPortName(), result);
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ChannelContainer::getMetricsState
+
+juce::Rectangle<int>
+ChannelContainer::getIncidentBounds(void)
+const
+{
+    ODL_OBJENTER(); //####
+    juce::Rectangle<int> result(getBounds().expanded(kSelectionMargin));
 
     for (int ii = 0, mm = getNumPorts(); mm > ii; ++ii)
     {
         ChannelEntry * aPort = getPort(ii);
 
-        if (aPort && aPort->isService())
+        if (aPort)
         {
-            if (Utilities::GetMetricsStateForService(aPort->getPortName(), result,
-                                                     STANDARD_WAIT_TIME_))
-            {
-                break;
-            }
-
+            result = result.getUnion(aPort->getIncomingConnectionBounds());
+            result = result.getUnion(aPort->getOutgoingConnectionBounds());
         }
     }
-    ODL_OBJEXIT_B(result); //####
+    ODL_OBJEXIT(); //####
     return result;
-} // ChannelContainer::getMetricsState
+} // ChannelContainer::getIncidentBounds
 
-#if defined(USE_OGDF_POSITIONING_)
-ogdf::node
-ChannelContainer::getNode(void)
+juce::Rectangle<int>
+ChannelContainer::getOutgoingConnectionBounds(void)
 const
 {
     ODL_OBJENTER(); //####
-    ODL_OBJEXIT_P(_node); //####
-    return _node;
-} // ChannelContainer::getNode
-#endif // defined(USE_OGDF_POSITIONING_)
+    juce::Rectangle<int> result;
+
+    for (int ii = 0, mm = getNumPorts(); mm > ii; ++ii)
+    {
+        ChannelEntry * aPort = getPort(ii);
+
+        if (aPort)
+        {
+            result = result.getUnion(aPort->getOutgoingConnectionBounds());
+        }
+    }
+    ODL_OBJEXIT(); //####
+    return result;
+} // ChannelContainer::getOutgoingConnectionBounds
 
 ChannelEntry *
 ChannelContainer::getPort(const int num)
@@ -675,7 +825,7 @@ const
 
     if ((0 <= num) && (getNumPorts() > num))
     {
-        result = reinterpret_cast<ChannelEntry *>(getChildComponent(num));
+        result = _ports[static_cast<size_t>(num)];
     }
     else
     {
@@ -696,6 +846,26 @@ const
     return result;
 } // ChannelContainer::getPositionInPanel
 
+ChannelEntry *
+ChannelContainer::getServicePort(void)
+const
+{
+    ODL_OBJENTER(); //####
+    ChannelEntry * result = NULL;
+
+    for (int ii = 0, mm = getNumPorts(); (mm > ii) && (! result); ++ii)
+    {
+        ChannelEntry * aPort = getPort(ii);
+
+        if (aPort && aPort->isService())
+        {
+            result = aPort;
+        }
+    }
+    ODL_OBJEXIT_P(result); //####
+    return result;
+} // ChannelContainer::getServicePort
+
 float
 ChannelContainer::getTextInset(void)
 const
@@ -705,6 +875,52 @@ const
     return kTextInset;
 } // ChannelContainer::getTextInset
 
+ChannelEntry *
+ChannelContainer::getPortAt(const Position & location)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_D2("x = ", location.getX(), "y = ", location.getY()); //####
+    ChannelEntry * result = NULL;
+
+    if ((! _drawAsGlyph) && (! _ports.empty()) && (0 <= location.getX()) &&
+        (getWidth() > location.getX()))
+    {
+        // All the rows have the same height, so the row can be found directly rather than by
+        // checking each of the ports in turn.
+        ChannelEntry * firstPort = _ports[0];
+        float          offset = location.getY() - firstPort->getY();
+        float          rowPitch = firstPort->getHeight() + kEntryGap;
+
+        if (0 <= offset)
+        {
+            size_t row = static_cast<size_t>(offset / rowPitch);
+
+            if ((_ports.size() > row) && ((offset - (row * rowPitch)) < _ports[row]->getHeight()))
+            {
+                result = _ports[row];
+            }
+        }
+    }
+    ODL_OBJEXIT_P(result); //####
+    return result;
+} // ChannelContainer::getPortAt
+
+String
+ChannelContainer::getTitle(void)
+const
+{
+    ODL_OBJENTER(); //####
+    String result(getName());
+
+    if (kContainerKindHost == _kind)
+    {
+        result += String(" (") + String(static_cast<int>(_groupMembers.size())) + " ports)";
+    }
+    ODL_OBJEXIT_S(result.toStdString().c_str()); //####
+    return result;
+} // ChannelContainer::getTitle
+
 bool
 ChannelContainer::hasPort(const ChannelEntry * aPort)
 {
@@ -785,24 +1001,8 @@ ChannelContainer::locateEntry(const Position & location)
 const
 {
     ODL_OBJENTER(); //####
-    ChannelEntry * result = NULL;
-
-    for (int ii = 0, mm = getNumPorts(); mm > ii; ++ii)
-    {
-        ChannelEntry * aPort = getPort(ii);
-
-        if (aPort)
-        {
-            Position where = aPort->getPositionInPanel();
-
-            if (aPort->reallyContains((location - where).toInt(), true))
-            {
-                result = aPort;
-                break;
-            }
+    ChannelEntry * result = getPortAt(location - getPositionInPanel());
 
-        }
-    }
     ODL_OBJEXIT_P(result); //####
     return result;
 } // ChannelContainer::locateEntry
@@ -813,9 +1013,23 @@ ChannelContainer::mouseDown(const MouseEvent & ee)
     ODL_OBJENTER(); //####
     ODL_P1("ee = ", &ee); //####
     bool doDrag = true;
+    bool passOn = true;
 
+#if defined(USE_FLYWEIGHT_PORTS_)
+    // The ports are not components, so the event is given to the port under the mouse first.
+    _activePort = getPortAt(ee.position);
+    if (_activePort)
+    {
+        passOn = _activePort->handleMouseDown(ee.withNewPosition(ee.position -
+                                                           _activePort->getPosition().toFloat()));
+    }
+#endif // defined(USE_FLYWEIGHT_PORTS_)
     // Prepares our dragger to drag this Component
-    if (ee.mods.isAltDown() || ee.mods.isCommandDown())
+    if (! passOn)
+    {
+        doDrag = false;
+    }
+    else if (ee.mods.isAltDown() || ee.mods.isCommandDown())
     {
         doDrag = false;
     }
@@ -842,43 +1056,173 @@ ChannelContainer::mouseDrag(const MouseEvent & ee)
     ODL_OBJENTER(); //####
     ODL_P1("ee = ", &ee); //####
     bool doDrag = true;
+    bool passOn = true;
 
+#if defined(USE_FLYWEIGHT_PORTS_)
+    if (_activePort)
+    {
+        passOn = _activePort->handleMouseDrag(ee.withNewPosition(ee.position -
+                                                           _activePort->getPosition().toFloat()));
+    }
+#endif // defined(USE_FLYWEIGHT_PORTS_)
     // Moves this Component according to the mouse drag event and applies our constraints to it
-    if (ee.mods.isAltDown() || ee.mods.isCommandDown() || ee.mods.isPopupMenu())
+    if ((! passOn) || ee.mods.isAltDown() || ee.mods.isCommandDown() || ee.mods.isPopupMenu())
     {
         doDrag = false;
     }
     if (doDrag)
     {
+        // Only the areas that the entity and its connections covered before and after the move
+        // need to be redrawn.
+        juce::Rectangle<int> damagedArea(getIncidentBounds());
+
 #if (! SETTINGS_FOR_MANUAL_)
-        _dragger.dragComponent(this, ee, &_constrainer);
+        // The constrainer works with the untransformed bounds of the panel, so it can only be
+        // applied when the panel is not zoomed.
+        _dragger.dragComponent(this, ee, (_owner.isZoomed() ? NULL : &_constrainer));
 #endif // ! SETTINGS_FOR_MANUAL_
-        _owner.repaint();
+        if (kContainerKindHost == _kind)
+        {
+            // The connections of a host group belong to its hidden ports, so their extent isn't
+            // known here.
+            _owner.repaint();
+        }
+        else
+        {
+            _owner.repaintUnscaledArea(damagedArea.getUnion(getIncidentBounds()));
+        }
     }
     ODL_OBJEXIT(); //####
 } // ChannelContainer::mouseDrag
 
+void
+ChannelContainer::mouseUp(const MouseEvent & ee)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("ee = ", &ee); //####
+    bool passOn = true;
+
+#if defined(USE_FLYWEIGHT_PORTS_)
+    if (_activePort)
+    {
+        passOn = _activePort->handleMouseUp(ee.withNewPosition(ee.position -
+                                                         _activePort->getPosition().toFloat()));
+        _activePort = NULL;
+    }
+#endif // defined(USE_FLYWEIGHT_PORTS_)
+    // The new position is saved once the entities stop moving, rather than only at exit.
+    if (passOn && (! ee.mouseWasClicked()))
+    {
+        ContentPanel * thePanel = _owner.getContent();
+
+        if (thePanel)
+        {
+            thePanel->requestPositionSave();
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // ChannelContainer::mouseUp
+
+void
+ChannelContainer::moved(void)
+{
+    ODL_OBJENTER(); //####
+    _owner.updateEntityIndex(this);
+    ODL_OBJEXIT(); //####
+} // ChannelContainer::moved
+
 void
 ChannelContainer::paint(Graphics & gg)
 {
     ODL_OBJENTER(); //####
     ODL_P1("gg = ", &gg); //####
-    AttributedString as;
-
-    as.setJustification(Justification::left);
-    as.append(getName(), _owner.getNormalFont(), kHeadingTextColour);
-    juce::Rectangle<int> localBounds(getLocalBounds());
-    juce::Rectangle<int> area1(localBounds.getX(), localBounds.getY(), localBounds.getWidth(),
-                               _titleHeight);
-    juce::Rectangle<int> area2(localBounds.getX(), localBounds.getY() + _titleHeight,
-                               localBounds.getWidth(), localBounds.getHeight() - _titleHeight);
-
-    gg.setColour(kHeadingBackgroundColour);
-    gg.fillRect(area1);
-    area1.setLeft(static_cast<int>(area1.getX() + getTextInset()));
-    as.draw(gg, area1.toFloat());
-    gg.setColour(kGapFillColour);
-    gg.fillRect(area2);
+    if (_drawAsGlyph)
+    {
+        // At low zoom levels the text would not be legible, so just show the outline of the
+        // entity.
+        if (_stale)
+        {
+            gg.setColour(kStaleHeadingBackgroundColour);
+        }
+        else if (_alerting)
+        {
+            gg.setColour(kAlertHeadingBackgroundColour);
+        }
+        else
+        {
+            gg.setColour(kHeadingBackgroundColour);
+        }
+        gg.fillAll();
+    }
+    else
+    {
+        AttributedString as;
+
+        as.setJustification(Justification::left);
+        as.append(getTitle(), _owner.getNormalFont(),
+                  _stale ? kStaleHeadingTextColour : kHeadingTextColour);
+        juce::Rectangle<int> localBounds(getLocalBounds());
+        juce::Rectangle<int> area1(localBounds.getX(), localBounds.getY(), localBounds.getWidth(),
+                                   _titleHeight);
+        juce::Rectangle<int> area2(localBounds.getX(), localBounds.getY() + _titleHeight,
+                                   localBounds.getWidth(),
+                                   localBounds.getHeight() - _titleHeight);
+
+        if (_stale)
+        {
+            gg.setColour(kStaleHeadingBackgroundColour);
+        }
+        else if (_alerting)
+        {
+            gg.setColour(kAlertHeadingBackgroundColour);
+        }
+        else if (kContainerKindHost == _kind)
+        {
+            gg.setColour(kHostHeadingBackgroundColour);
+        }
+        else
+        {
+            gg.setColour(kHeadingBackgroundColour);
+        }
+        gg.fillRect(area1);
+        if (! _stale)
+        {
+            drawMetricsSparkline(gg, area1);
+        }
+        area1.setLeft(static_cast<int>(area1.getX() + getTextInset()));
+        as.draw(gg, area1.toFloat());
+        gg.setColour(kGapFillColour);
+        gg.fillRect(area2);
+#if defined(USE_FLYWEIGHT_PORTS_)
+        if (! _ports.empty())
+        {
+            // Only the rows that intersect the area being redrawn need to be drawn, and as the
+            // rows all have the same height they can be found directly.
+            juce::Rectangle<int> clipArea(gg.getClipBounds());
+            ChannelEntry *       firstPort = _ports[0];
+            int                  rowPitch = static_cast<int>(firstPort->getHeight() + kEntryGap);
+            int                  firstRow = jmax(0, (clipArea.getY() - firstPort->getY()) /
+                                                 rowPitch);
+            int                  lastRow = jmin(getNumPorts() - 1,
+                                                (clipArea.getBottom() - firstPort->getY()) /
+                                                rowPitch);
+
+            for (int ii = firstRow; lastRow >= ii; ++ii)
+            {
+                ChannelEntry * aPort = getPort(ii);
+
+                if (aPort)
+                {
+                    gg.saveState();
+                    gg.setOrigin(aPort->getPosition());
+                    gg.reduceClipRegion(aPort->getLocalBounds());
+                    aPort->paintEntireComponent(gg, true);
+                    gg.restoreState();
+                }
+            }
+        }
+#endif // defined(USE_FLYWEIGHT_PORTS_)
+    }
     ODL_OBJEXIT(); //####
 } // ChannelContainer::paint
 
@@ -906,6 +1250,7 @@ ChannelContainer::resized(void)
     _constrainer.setMinimumOnscreenAmounts(getHeight(), getWidth(),
                                            static_cast<int>(getHeight() * 0.8),
                                            static_cast<int>(getWidth() * 0.8));
+    _owner.updateEntityIndex(this);
     ODL_OBJEXIT(); //####
 } // ChannelContainer::resized
 
@@ -955,44 +1300,95 @@ ChannelContainer::select(void)
 } // ChannelContainer::select
 
 void
-ChannelContainer::setHidden(void)
+ChannelContainer::setAlerting(const bool isAlerting)
 {
     ODL_OBJENTER(); //####
-    _hidden = true;
+    ODL_B1("isAlerting = ", isAlerting); //####
+    if (isAlerting != _alerting)
+    {
+        _alerting = isAlerting;
+        repaint();
+    }
     ODL_OBJEXIT(); //####
-} // ChannelContainer::setHidden
+} // ChannelContainer::setAlerting
 
 void
-ChannelContainer::setMetricsState(const bool newState)
+ChannelContainer::setDimmed(const bool isDimmed)
 {
     ODL_OBJENTER(); //####
-    ODL_B1("newState = ", newState); //####
-    for (int ii = 0, mm = getNumPorts(); mm > ii; ++ii)
+    ODL_B1("isDimmed = ", isDimmed); //####
+    if (isDimmed != _dimmed)
     {
-        ChannelEntry * aPort = getPort(ii);
+        _dimmed = isDimmed;
+        // A translucent container must not hide the parts of the panel behind it.
+        setOpaque(! _dimmed);
+        setAlpha(_dimmed ? kDimmedOpacity : 1);
+    }
+    ODL_OBJEXIT(); //####
+} // ChannelContainer::setDimmed
 
-        if (aPort && aPort->isService())
+void
+ChannelContainer::setGlyphMode(const bool drawAsGlyph)
+{
+    ODL_OBJENTER(); //####
+    ODL_B1("drawAsGlyph = ", drawAsGlyph); //####
+    if (drawAsGlyph != _drawAsGlyph)
+    {
+        _drawAsGlyph = drawAsGlyph;
+        for (int ii = 0, mm = getNumPorts(); mm > ii; ++ii)
         {
-            if (Utilities::SetMetricsStateForService(aPort->getPortName(), newState,
-                                                     STANDARD_WAIT_TIME_))
+            ChannelEntry * aPort = getPort(ii);
+
+            if (aPort)
             {
-                break;
+                aPort->setVisible(! drawAsGlyph);
             }
-
         }
+        repaint();
     }
     ODL_OBJEXIT(); //####
-} // ChannelContainer::setMetricsState
+} // ChannelContainer::setGlyphMode
+
+void
+ChannelContainer::setGroupMembers(const ContainerList & members)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("members = ", &members); //####
+    if (members != _groupMembers)
+    {
+        Font & headerFont = _owner.getNormalFont();
+
+        _groupMembers = members;
+        // The heading shows the number of ports, so the width might need to change.
+        setSize(static_cast<int>(headerFont.getStringWidthFloat(getTitle() + " ") +
+                                 getTextInset()), getHeight());
+        repaint();
+    }
+    ODL_OBJEXIT(); //####
+} // ChannelContainer::setGroupMembers
+
+void
+ChannelContainer::setHidden(void)
+{
+    ODL_OBJENTER(); //####
+    _hidden = true;
+    ODL_OBJEXIT(); //####
+} // ChannelContainer::setHidden
 
-#if defined(USE_OGDF_POSITIONING_)
 void
-ChannelContainer::setNode(ogdf::node newNode)
+ChannelContainer::setMetricsState(const bool newState)
 {
     ODL_OBJENTER(); //####
-    _node = newNode;
+    ODL_B1("newState = ", newState); //####
+    ContentPanel * content = _owner.getContent();
+    ChannelEntry * servicePort = getServicePort();
+
+    if (content && servicePort)
+    {
+        content->getMetricsThread().requestMetricsState(servicePort->getPortName(), newState);
+    }
     ODL_OBJEXIT(); //####
-} // ChannelContainer::setNode
-#endif // defined(USE_OGDF_POSITIONING_)
+} // ChannelContainer::setMetricsState
 
 void
 ChannelContainer::setOld(void)
@@ -1002,6 +1398,20 @@ ChannelContainer::setOld(void)
     ODL_OBJEXIT(); //####
 } // ChannelContainer::setOld
 
+void
+ChannelContainer::setStale(const bool isStale)
+{
+    ODL_OBJENTER(); //####
+    ODL_B1("isStale = ", isStale); //####
+    if (isStale != _stale)
+    {
+        _stale = isStale;
+        // The ports are drawn differently as well, so repaint them along with the heading.
+        repaint();
+    }
+    ODL_OBJEXIT(); //####
+} // ChannelContainer::setStale
+
 void
 ChannelContainer::setVisited(void)
 {
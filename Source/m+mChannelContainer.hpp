@@ -41,23 +41,6 @@
 
 # include "m+mManagerDataTypes.hpp"
 
-# if defined(USE_OGDF_POSITIONING_)
-#  if MAC_OR_LINUX_
-#   pragma clang diagnostic push
-#   pragma clang diagnostic ignored "-Wunused-parameter"
-#  else // ! MAC_OR_LINUX_
-#   pragma warning(push)
-#   pragma warning(disable: 4100)
-#   pragma warning(disable: 4512)
-#  endif // ! MAC_OR_LINUX_
-#  include <ogdf/basic/Graph.h>
-#  if MAC_OR_LINUX_
-#   pragma clang diagnostic pop
-#  else // ! MAC_OR_LINUX_
-#   pragma warning(pop)
-#  endif // ! MAC_OR_LINUX_
-# endif // defined(USE_OGDF_POSITIONING_)
-
 # if defined(__APPLE__)
 #  pragma clang diagnostic push
 #  pragma clang diagnostic ignored "-Wunknown-pragmas"
@@ -169,15 +152,18 @@ namespace MPlusM_Manager
         displayMetrics(void);
 
         /*! @brief Display the connections between containers.
-         @param[in,out] gg The graphics context in which to draw. */
-        void
-        drawOutgoingConnections(Graphics & gg);
-
-        /*! @brief Convert a tab-delimited line of metric data into a more readable form.
-         @param[in] aRow A line of metric data.
-         @returns The metric data reformatted. */
+         @param[in,out] gg The graphics context in which to draw.
+         @param[in] drawArea The area of the panel that is being drawn.
+         @returns The number of connections that were drawn. */
+        size_t
+        drawOutgoingConnections(Graphics &                   gg,
+                                const juce::Rectangle<int> & drawArea);
+
+        /*! @brief Convert the metrics for a channel into a readable form.
+         @param[in] aRecord The metrics for a channel.
+         @returns The metrics in a readable form. */
         String
-        formatMetricRow(const String & aRow);
+        formatMetricsRecord(const MetricsRecord & aRecord);
 
         /*! @brief Return a particular argument descriptor.
          @param[in] idx The index of the argument of interest.
@@ -213,6 +199,27 @@ namespace MPlusM_Manager
             return _extraInfo;
         } // getExtraInformation
 
+        /*! @brief Return the standalone ports that are represented by the container, if it stands
+         in for a host.
+         @returns The standalone ports that are represented by the container. */
+        inline const ContainerList &
+        getGroupMembers(void)
+        const
+        {
+            return _groupMembers;
+        } // getGroupMembers
+
+        /*! @brief Return the container that stands in for the host of the container, if it is a
+         standalone port that has been grouped with the other ports on its host.
+         @returns The container that stands in for the host or @c NULL if the container is not
+         grouped. */
+        inline ChannelContainer *
+        getHostGroup(void)
+        const
+        {
+            return _hostGroup;
+        } // getHostGroup
+
         /*! @brief Return the IP address of the container.
          @returns The IP address of the container. */
         inline const YarpString &
@@ -232,23 +239,33 @@ namespace MPlusM_Manager
         } // getKind
 
         /*! @brief Return the metrics for the container, if it is a service.
-         @returns The metrics for the container, if it is a service or an empty string. */
-        StringArray
+         @returns The metrics for the channels of the container, if it is a service or an empty
+         list. */
+        MetricsRecordList
         getMetrics(void);
 
         /*! @brief Return the state of measurment collection for the container, if it is a service.
+         The most recently seen state is returned, so that the service is not asked.
          @returns @c true if the service is collecting measurements and @c false if it is not a
-         service or if it is a service that is not collecting measurements. */
+         service, if it is a service that is not collecting measurements or if its state is not
+         yet known. */
         bool
         getMetricsState(void);
 
-# if defined(USE_OGDF_POSITIONING_)
-        /*! @brief Return the node corresponding to the entity.
-         @returns The node corresponding to the entity. */
-        ogdf::node
-        getNode(void)
+        /*! @brief Return the area of the panel that could be touched by the entity, its selection
+         marker or any of its connections.
+         @returns The area of the panel that could be touched by the entity, its selection marker
+         or any of its connections. */
+        juce::Rectangle<int>
+        getIncidentBounds(void)
+        const;
+
+        /*! @brief Return the area of the panel that could be touched by the outgoing connections.
+         @returns The area of the panel that could be touched by the outgoing connections, or an
+         empty rectangle if there are no outgoing connections. */
+        juce::Rectangle<int>
+        getOutgoingConnectionBounds(void)
         const;
-# endif // defined(USE_OGDF_POSITIONING_)
 
         /*! @brief Returns the number of argument descriptions in this container.
          @returns The number of argument descriptions in this container. */
@@ -265,7 +282,7 @@ namespace MPlusM_Manager
         getNumPorts(void)
         const
         {
-            return getNumChildComponents();
+            return static_cast<int>(_ports.size());
         } // getNumPorts
 
         inline EntitiesPanel &
@@ -288,6 +305,15 @@ namespace MPlusM_Manager
         getPositionInPanel(void)
         const;
 
+        /*! @brief Return the container that is displayed in place of this container.
+         @returns The container that stands in for the host if the container is grouped with the
+         other ports on its host and the group is collapsed, or this container otherwise. */
+        inline ChannelContainer *
+        getRepresentative(void)
+        {
+            return ((_hostGroup && _hostGroup->_collapsed) ? _hostGroup : this);
+        } // getRepresentative
+
         /*! @brief Return the requests supported by the entity.
          @returns The requests supported by the entity. */
         inline const YarpString &
@@ -297,6 +323,12 @@ namespace MPlusM_Manager
             return _requests;
         } // getRequests
 
+        /*! @brief Return the primary port of the entity, if it is a service or an adapter.
+         @returns The primary port of the entity or @c NULL if it is not a service or an adapter. */
+        ChannelEntry *
+        getServicePort(void)
+        const;
+
         /*! @brief Return the amount of space to the left of the text being displayed.
          @returns The amount of space to the left of the text being displayed. */
         float
@@ -317,6 +349,48 @@ namespace MPlusM_Manager
         void
         invalidateConnections(void);
 
+        /*! @brief Return @c true if the container stands in for a host whose standalone ports are
+         displayed as a single entity.
+         @returns @c true if the container is a collapsed host group and @c false otherwise. */
+        inline bool
+        isCollapsed(void)
+        const
+        {
+            return _collapsed;
+        } // isCollapsed
+
+        /*! @brief Return @c true if the entity is highlighted because it has raised a metrics
+         alert.
+         @returns @c true if the entity has raised an alert and @c false otherwise. */
+        inline bool
+        isAlerting(void)
+        const
+        {
+            return _alerting;
+        } // isAlerting
+
+        /*! @brief Return @c true if the entity is drawn faintly because it doesn't match the
+         active search.
+         @returns @c true if the entity is dimmed and @c false otherwise. */
+        inline bool
+        isDimmed(void)
+        const
+        {
+            return _dimmed;
+        } // isDimmed
+
+        /*! @brief Return @c true if the container is not displayed because of the state of its
+         host group.
+         @returns @c true if the container is a port in a collapsed host group or is the stand-in
+         for an expanded host group, and @c false otherwise. */
+        inline bool
+        isHiddenByGroup(void)
+        const
+        {
+            return ((_hostGroup && _hostGroup->_collapsed) ||
+                    ((kContainerKindHost == _kind) && (! _collapsed)));
+        } // isHiddenByGroup
+
         /*! @brief Returns @c true if one of the port entries is marked and @c false otherwise.
          @returns @c true if one of the port entries is marked and @c false otherwise. */
         bool
@@ -341,6 +415,16 @@ namespace MPlusM_Manager
             return _selected;
         } // isSelected
 
+        /*! @brief Return @c true if the entity was recalled from the previous session and has not
+         yet been confirmed by a scan.
+         @returns @c true if the entity is stale and @c false otherwise. */
+        inline bool
+        isStale(void)
+        const
+        {
+            return _stale;
+        } // isStale
+
         /*! @brief Returns an entry at the given location, if it exists.
          @param[in] location The coordinates to check.
          @returns A pointer to the entry at the given location, or @c NULL if there is none. */
@@ -358,6 +442,15 @@ namespace MPlusM_Manager
         virtual void
         mouseDrag(const MouseEvent & ee);
 
+        /*! @brief Called when a mouse button is released.
+         @param[in] ee Details about the position and status of the mouse event. */
+        virtual void
+        mouseUp(const MouseEvent & ee);
+
+        /*! @brief Called when the component position has been changed. */
+        virtual void
+        moved(void);
+
         /*! @brief Remove connections that are invalid. */
         void
         removeInvalidConnections(void);
@@ -374,26 +467,69 @@ namespace MPlusM_Manager
         void
         select(void);
 
+        /*! @brief Record whether the standalone ports of the host are displayed as a single entity.
+         @param[in] collapse @c true if the ports are displayed as a single entity and @c false if
+         they are displayed separately. */
+        inline void
+        setCollapsed(const bool collapse)
+        {
+            _collapsed = collapse;
+        } // setCollapsed
+
+        /*! @brief Change whether the entity is highlighted because it has raised a metrics alert.
+         @param[in] isAlerting @c true if the entity has raised an alert and @c false
+         otherwise. */
+        void
+        setAlerting(const bool isAlerting);
+
+        /*! @brief Change whether the entity is drawn faintly because it doesn't match the active
+         search.
+         @param[in] isDimmed @c true if the entity is to be drawn faintly and @c false if it is to
+         be drawn normally. */
+        void
+        setDimmed(const bool isDimmed);
+
+        /*! @brief Change whether the entity is drawn as a simplified glyph, without its ports
+         or title text.
+         @param[in] drawAsGlyph @c true if the entity is to be drawn as a glyph and @c false if it
+         is to be drawn in full. */
+        void
+        setGlyphMode(const bool drawAsGlyph);
+
+        /*! @brief Record the standalone ports that are represented by the container.
+         @param[in] members The standalone ports on the host. */
+        void
+        setGroupMembers(const ContainerList & members);
+
         /*! @brief Sets the hidden flag for the entity. */
         void
         setHidden(void);
 
+        /*! @brief Record the container that stands in for the host of the container.
+         @param[in] aGroup The container that stands in for the host, or @c NULL if the container
+         is not grouped. */
+        inline void
+        setHostGroup(ChannelContainer * aGroup)
+        {
+            _hostGroup = aGroup;
+        } // setHostGroup
+
         /*! @brief Change the state of service metrics collection.
+         The service is told in the background.
          @param[in] newState The requested state of service metrics collection. */
         void
         setMetricsState(const bool newState);
 
-# if defined(USE_OGDF_POSITIONING_)
-        /*! @brief Sets the node corresponding to the entity.
-         @param[in] newNode The new value for the node corresponding to the entity. */
-        void
-        setNode(ogdf::node newNode);
-# endif // defined(USE_OGDF_POSITIONING_)
-
         /*! @brief Marks the entity as not newly created. */
         void
         setOld(void);
 
+        /*! @brief Record whether the entity was recalled from the previous session and has not yet
+         been confirmed by a scan.
+         @param[in] isStale @c true if the entity has not been confirmed and @c false if it has. */
+        void
+        setStale(const bool isStale);
+
         /*! @brief Sets the visited flag for the entity. */
         void
         setVisited(void);
@@ -428,6 +564,26 @@ namespace MPlusM_Manager
         void
         displayAndProcessPopupMenu(void);
 
+        /*! @brief Draw the recent traffic of the service as a line behind the heading.
+         @param[in,out] gg The graphics context in which to draw.
+         @param[in] area The area of the heading. */
+        void
+        drawMetricsSparkline(Graphics &                   gg,
+                             const juce::Rectangle<int> & area);
+
+        /*! @brief Return the port whose row contains a location.
+         @param[in] location The coordinates to check, relative to the container.
+         @returns The port whose row contains the location or @c NULL if there is none. */
+        ChannelEntry *
+        getPortAt(const Position & location)
+        const;
+
+        /*! @brief Return the text to be shown in the heading of the container.
+         @returns The text to be shown in the heading of the container. */
+        String
+        getTitle(void)
+        const;
+
         /*! @brief Draw the content of the component.
          @param[in,out] gg The graphics context in which to draw. */
         virtual void
@@ -442,6 +598,13 @@ namespace MPlusM_Manager
         /*! @brief The argument descriptions if it is a service or an adapter. */
         MplusM::Utilities::DescriptorVector _argumentList;
 
+        /*! @brief The standalone ports that are represented by the container, if it stands in for
+         a host. */
+        ContainerList _groupMembers;
+
+        /*! @brief The ports of the container, in the order that they are displayed. */
+        ChannelEntryList _ports;
+
         /*! @brief Restrictions on the components size or position. */
         ComponentBoundsConstrainer _constrainer;
 
@@ -463,20 +626,38 @@ namespace MPlusM_Manager
         /*! @brief The requests for the entity, if it is a service or an adapter. */
         YarpString _requests;
 
-# if defined(USE_OGDF_POSITIONING_)
-        /*! @brief The node corresponding to the container. */
-        ogdf::node _node;
-# endif // defined(USE_OGDF_POSITIONING_)
-
         /*! @brief The owner of the container. */
         EntitiesPanel & _owner;
 
+        /*! @brief The port that the mouse was pressed over, if the ports are drawn by the
+         container. */
+        ChannelEntry * _activePort;
+
+        /*! @brief The container that stands in for the host, if the container is grouped. */
+        ChannelContainer * _hostGroup;
+
         /*! @brief The height of the title of the container. */
         int _titleHeight;
 
         /*! @brief The kind of container. */
         ContainerKind _kind;
 
+        /*! @brief @c true if the container is highlighted because it has raised a metrics alert
+         and @c false otherwise. */
+        bool _alerting;
+
+        /*! @brief @c true if the standalone ports of the host are displayed as a single entity and
+         @c false otherwise. */
+        bool _collapsed;
+
+        /*! @brief @c true if the container is drawn faintly because it doesn't match the active
+         search and @c false otherwise. */
+        bool _dimmed;
+
+        /*! @brief @c true if the container is drawn as a simplified glyph and @c false
+         otherwise. */
+        bool _drawAsGlyph;
+
         /*! @brief @c true if the container was hidden and @c false otherwise. */
         bool _hidden;
 
@@ -486,19 +667,13 @@ namespace MPlusM_Manager
         /*! @brief @c true if the container is selected and @c false otherwise. */
         bool _selected;
 
+        /*! @brief @c true if the container was recalled from the previous session and has not yet
+         been confirmed by a scan and @c false otherwise. */
+        bool _stale;
+
         /*! @brief @c true if the container was visited and @c false otherwise. */
         bool _visited;
 
-# if defined(__APPLE__)
-#  pragma clang diagnostic push
-#  pragma clang diagnostic ignored "-Wunused-private-field"
-# endif // defined(__APPLE__)
-        /*! @brief Filler to pad to alignment boundary */
-        char _filler[4];
-# if defined(__APPLE__)
-#  pragma clang diagnostic pop
-# endif // defined(__APPLE__)
-
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChannelContainer)
 
     }; // ChannelContainer
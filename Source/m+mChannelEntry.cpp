@@ -37,6 +37,7 @@
 //--------------------------------------------------------------------------------------------------
 
 #include "m+mChannelEntry.hpp"
+#include "m+mActivityThread.hpp"
 #include "m+mChannelContainer.hpp"
 #include "m+mContentPanel.hpp"
 #include "m+mEntitiesPanel.hpp"
@@ -86,12 +87,25 @@ static const Colour & kOtherConnectionColour(Colours::orange);
 /*! @brief The second colour to be used for the activity marker. */
 static const Colour & kSecondActivityMarkerColour(Colours::orange);
 
+/*! @brief The colour to be used for text in an entry that matches the active search. */
+static const Colour & kSearchMatchTextColour(Colours::gold);
+
+/*! @brief The colour to be used for text in an entry that has not yet been confirmed by a
+ scan. */
+static const Colour & kStaleEntryTextColour(Colours::grey);
+
 /*! @brief The colour to be used for TCP connections. */
 static const Colour & kTcpConnectionColour(Colours::teal);
 
 /*! @brief The colour to be used for UDP connections. */
 static const Colour & kUdpConnectionColour(Colours::purple);
 
+/*! @brief The opacity of connections between entities that don't match the active search. */
+static const float kDimmedConnectionOpacity = 0.2;
+
+/*! @brief The opacity of connections that have not yet been confirmed by a scan. */
+static const float kStaleConnectionOpacity = 0.4;
+
 /*! @brief The inset for the activity indicator. */
 static const float kActivityInset = 2;
 
@@ -104,6 +118,14 @@ static const float kControlLengthScale = 0.25;
 /*! @brief The width and height of the marker displayed during movement. */
 static const float kMarkerSide = 10;
 
+/*! @brief The line width for the busiest connection, when connections are weighted by their
+ traffic. */
+static const float kMaximumTrafficConnectionWidth = 12;
+
+/*! @brief The line width for an idle connection, when connections are weighted by their
+ traffic. */
+static const float kMinimumTrafficConnectionWidth = 1;
+
 /*! @brief The line width for an input / output connection. */
 static const float kInputOutputConnectionWidth = 4;
 
@@ -175,6 +197,55 @@ calculateMinDistance(float &          distanceSoFar,
     return calculateMinDistance(distanceSoFar, refPoint, Position(testX, testY), bestSoFar);
 } // calculateMinDistance
 
+/*! @brief Determine the area of the panel that could be touched by a curve between two areas.
+ @param[in] sourceBox The area containing the start of the curve.
+ @param[in] destinationBox The area containing the end of the curve.
+ @returns The area of the panel that could be touched by the curve. */
+static juce::Rectangle<int>
+calculateCurveBounds(const juce::Rectangle<float> & sourceBox,
+                     const juce::Rectangle<float> & destinationBox)
+{
+    ODL_ENTER(); //####
+    ODL_P2("sourceBox = ", &sourceBox, "destinationBox = ", &destinationBox); //####
+    juce::Rectangle<float> outer(sourceBox.getUnion(destinationBox));
+    // The control points of the bezier curve are never further from the anchors than a fraction of
+    // the distance between the anchors, and the anchors are never further from the entries than
+    // the size of an arrow.
+    float                  diagonal = Position(0, 0).getDistanceFrom(Position(outer.getWidth(),
+                                                                              outer.getHeight()));
+    float                  margin = ((diagonal * kControlLengthScale) + kArrowSize +
+                                     jmax(kServiceConnectionWidth,
+                                          kMaximumTrafficConnectionWidth));
+    juce::Rectangle<int>   result(outer.expanded(margin).getSmallestIntegerContainer());
+
+    ODL_EXIT(); //####
+    return result;
+} // calculateCurveBounds
+
+/*! @brief Determine the area of the panel that could be touched by a connection between entries.
+ @param[in] source The originating entry.
+ @param[in] destination The terminating entry.
+ @returns The area of the panel that could be touched by the connection. */
+static juce::Rectangle<int>
+calculateConnectionBounds(const ChannelEntry * source,
+                          const ChannelEntry * destination)
+{
+    ODL_ENTER(); //####
+    ODL_P2("source = ", source, "destination = ", destination); //####
+    Position               sourcePosition(source->getPositionInPanel());
+    Position               destinationPosition(destination->getPositionInPanel());
+    juce::Rectangle<float> sourceBox(sourcePosition.getX(), sourcePosition.getY(),
+                                     static_cast<float>(source->getWidth()),
+                                     static_cast<float>(source->getHeight()));
+    juce::Rectangle<float> destinationBox(destinationPosition.getX(), destinationPosition.getY(),
+                                          static_cast<float>(destination->getWidth()),
+                                          static_cast<float>(destination->getHeight()));
+    juce::Rectangle<int>   result(calculateCurveBounds(sourceBox, destinationBox));
+
+    ODL_EXIT(); //####
+    return result;
+} // calculateConnectionBounds
+
 /*! @brief Determine the anchor point that is the minimum distance from a given point.
  @param[in,out] newCentre The synthesized centre for the target point.
  @param[in] disallowBottom @c true if the anchor cannot be bottom-centre.
@@ -391,18 +462,22 @@ drawBezier(Graphics &       gg,
  @param[in] source The originating entry.
  @param[in] destination The terminating entry.
  @param[in] mode The kind of connection.
- @param[in] forced @c true if the protocols were overridden and @c false otherwise. */
+ @param[in] forced @c true if the protocols were overridden and @c false otherwise.
+ @param[in] trafficWeight The recent traffic on the connection, relative to the busiest
+ connection, or a negative value if the width is to be set by the kind of connection. */
 static void
 drawConnection(Graphics &                gg,
                ChannelEntry *            source,
                ChannelEntry *            destination,
                const Common::ChannelMode mode,
-               const bool                forced)
+               const bool                forced,
+               const float               trafficWeight)
 {
     ODL_ENTER(); //####
     ODL_P3("gg = ", &gg, "source = ", source, "destination = ", destination); //####
     ODL_LL1("mode = ", static_cast<int>(mode)); //####
     ODL_B1("forced = ", forced); //####
+    ODL_D1("trafficWeight = ", trafficWeight); //####
     if (source && destination)
     {
         AnchorSide sourceAnchor;
@@ -436,6 +511,13 @@ drawConnection(Graphics &                gg,
         {
             thickness = kNormalConnectionWidth;
         }
+        // The colour still shows the protocol, so the traffic is shown by the width alone.
+        if (0 <= trafficWeight)
+        {
+            thickness = (kMinimumTrafficConnectionWidth +
+                         ((kMaximumTrafficConnectionWidth - kMinimumTrafficConnectionWidth) *
+                          jmin(trafficWeight, 1.0f)));
+        }
         ODL_B1("isBidirectional <- ", isBidirectional); //####
         ODL_D1("thickness <- ", thickness); //####
         // Check if the destination is above the source, in which case we determine the anchors in
@@ -474,6 +556,14 @@ drawConnection(Graphics &                gg,
                 break;
 
         }
+        if (source->getParent()->isStale() || destination->getParent()->isStale())
+        {
+            gg.setOpacity(kStaleConnectionOpacity);
+        }
+        else if (source->getParent()->isDimmed() && destination->getParent()->isDimmed())
+        {
+            gg.setOpacity(kDimmedConnectionOpacity);
+        }
         drawBezier(gg, startPoint, endPoint, sourceCentre, destinationCentre, thickness, forced);
         if (isBidirectional)
         {
@@ -782,9 +872,11 @@ ChannelEntry::displayAndProcessPopupMenu(void)
     switch (result)
     {
         case kPopupAddScrollingMonitor :
+            _parent->getOwner().getContent()->addScrollingMonitor(*this);
             break;
 
         case kPopupAddSimpleMonitor :
+            _parent->getOwner().getContent()->toggleActivityIndicator(*this);
             break;
 
         case kPopupDetailedDisplayPortInfo :
@@ -810,31 +902,22 @@ void
 ChannelEntry::displayChannelMetrics(void)
 {
     ODL_ENTER(); //####
-    StringArray metricsArray;
-
     if (_parent)
     {
-        metricsArray = _parent->getMetrics();
-        // Find our line and prepare it.
-        int numRows = metricsArray.size();
+        MetricsRecordList records = _parent->getMetrics();
 
-        for (int ii = 0; ii < numRows; ++ii)
+        // Find our record and prepare it.
+        for (MetricsRecordList::const_iterator walker(records.begin()); records.end() != walker;
+             ++walker)
         {
-            const String & aRow = metricsArray[ii];
-            int            firstTab = aRow.indexOfChar('\t');
-
-            if (0 < firstTab)
+            if (walker->_channelName == getPortName())
             {
-                String channelName(aRow.substring(0, firstTab));
-
-                if (channelName == getPortName().c_str())
-                {
-                    DisplayInformationPanel(this, _parent->formatMetricRow(aRow) + "\n",
-                                            String("Metrics for ") + getPortName().c_str());
-                    break;
-                }
-
+                DisplayInformationPanel(getOnScreenComponent(),
+                                        _parent->formatMetricsRecord(*walker) + "\n",
+                                        String("Metrics for ") + getPortName().c_str());
+                break;
             }
+
         }
     }
     ODL_EXIT(); //####
@@ -906,11 +989,25 @@ ChannelEntry::displayInformation(const bool isChannel,
             }
         }
     }
+    if (_beingMonitored)
+    {
+        ContentPanel * content = _parent->getOwner().getContent();
+        ActivitySample aSample;
+
+        if (content && content->getActivityThread().getActivity(getPortName(), aSample))
+        {
+            String activityText(String("\n\nActivity = ") +
+                                String(aSample._messagesPerSecond, 1) + " messages and " +
+                                String(aSample._bytesPerSecond, 0) + " bytes per second");
+
+            suffix += activityText.toStdString();
+        }
+    }
     YarpString bodyText("Port: ");
 
     bodyText += getPortNumber() + "\n";
     bodyText += prefix + dirText + (isChannel ? " channel" : " port") + suffix;
-    DisplayInformationPanel(this, bodyText.c_str(), getPortName().c_str());
+    DisplayInformationPanel(getOnScreenComponent(), bodyText.c_str(), getPortName().c_str());
     ODL_EXIT(); //####
 } // ChannelEntry::displayInformation
 
@@ -962,12 +1059,15 @@ ChannelEntry::drawDragLine(Graphics &       gg,
     ODL_EXIT(); //####
 } // ChannelEntry::drawDragLine
 
-void
-ChannelEntry::drawOutgoingConnections(Graphics & gg)
+size_t
+ChannelEntry::drawOutgoingConnections(Graphics &                   gg,
+                                      const juce::Rectangle<int> & drawArea)
 {
     ODL_OBJENTER(); //####
-    ODL_P1("gg = ", &gg); //####
-    bool selfIsVisible = _parent->isVisible();
+    ODL_P2("gg = ", &gg, "drawArea = ", &drawArea); //####
+    bool           selfIsVisible = _parent->isVisible();
+    ContentPanel * content = _parent->getOwner().getContent();
+    size_t         count = 0;
 
     for (ChannelConnections::const_iterator walker(_outputConnections.begin());
          _outputConnections.end() != walker; ++walker)
@@ -979,14 +1079,27 @@ ChannelEntry::drawOutgoingConnections(Graphics & gg)
             ChannelEntry * otherChannelEntry = candidate->_otherChannel;
             bool           otherIsVisible = otherChannelEntry->_parent->isVisible();
 
-            if (selfIsVisible && otherIsVisible)
+            if (selfIsVisible && otherIsVisible &&
+                drawArea.intersects(calculateConnectionBounds(this, otherChannelEntry)))
             {
+                float trafficWeight = -1;
+
+                // Either end of the connection might be reporting its metrics.
+                if (content)
+                {
+                    const YarpString & otherName = otherChannelEntry->getPortName();
+
+                    trafficWeight = jmax(content->getTrafficWeight(getPortName()),
+                                         content->getTrafficWeight(otherName));
+                }
                 drawConnection(gg, this, candidate->_otherChannel, candidate->_connectionMode,
-                               candidate->_forced);
+                               candidate->_forced, trafficWeight);
+                ++count;
             }
         }
     }
-    ODL_OBJEXIT(); //####
+    ODL_OBJEXIT_LL(count); //####
+    return count;
 } // ChannelEntry::drawOutgoingConnections
 
 Position
@@ -1000,102 +1113,109 @@ const
     return outer.getCentre();
 } // ChannelEntry::getCentre
 
-EntitiesPanel &
-ChannelEntry::getOwningPanel(void)
-const
-{
-    ODL_OBJENTER(); //####
-    EntitiesPanel & result(_parent->getOwner());
-
-    ODL_OBJEXIT_P(&result); //####
-    return result;
-} // ChannelEntry::getOwningPanel
-
-Position
-ChannelEntry::getPositionInPanel(void)
+juce::Rectangle<int>
+ChannelEntry::getDragLineBounds(const Position & position)
 const
 {
     ODL_OBJENTER(); //####
-    Position result(getPosition().toFloat() + _parent->getPositionInPanel());
+    ODL_P1("position = ", &position); //####
+    Position               sourcePosition(getPositionInPanel());
+    juce::Rectangle<float> sourceBox(sourcePosition.getX(), sourcePosition.getY(),
+                                     static_cast<float>(getWidth()),
+                                     static_cast<float>(getHeight()));
+    // The end of the drag line is anchored to a box around the drag position, whose size depends
+    // on the distance from the entry.
+    float                  reach = (sourceBox.getCentre().getDistanceFrom(position) *
+                                    kTargetBoxScale);
+    juce::Rectangle<float> destinationBox(position.getX() - reach, position.getY() - reach,
+                                          2 * reach, 2 * reach);
+    juce::Rectangle<int>   result(calculateCurveBounds(sourceBox, destinationBox));
 
     ODL_OBJEXIT(); //####
     return result;
-} // ChannelEntry::getPositionInPanel
+} // ChannelEntry::getDragLineBounds
 
-bool
-ChannelEntry::hasOutgoingConnectionTo(const YarpString & otherPort)
+juce::Rectangle<int>
+ChannelEntry::getIncomingConnectionBounds(void)
 const
 {
     ODL_OBJENTER(); //####
-    ODL_S1s("otherPort = ", otherPort); //####
-    bool result = false;
+    juce::Rectangle<int> result;
 
-    for (ChannelConnections::const_iterator walker(_outputConnections.begin());
-         _outputConnections.end() != walker; ++walker)
+    for (ChannelConnections::const_iterator walker(_inputConnections.begin());
+         _inputConnections.end() != walker; ++walker)
     {
         const ChannelInfo * candidate(&*walker);
 
-        if (candidate && candidate->_otherChannel &&
-            (candidate->_otherChannel->getPortName() == otherPort))
+        if (candidate && candidate->_otherChannel)
         {
-            result = true;
-            break;
+            result = result.getUnion(calculateConnectionBounds(candidate->_otherChannel, this));
         }
-
     }
-    ODL_OBJEXIT_B(result); //####
+    ODL_OBJEXIT(); //####
     return result;
-} // ChannelEntry::hasOutgoingConnectionTo
+} // ChannelEntry::getIncomingConnectionBounds
 
-void
-ChannelEntry::invalidateConnections(void)
+Component *
+ChannelEntry::getOnScreenComponent(void)
 {
     ODL_OBJENTER(); //####
-    for (ChannelConnections::iterator walker(_inputConnections.begin());
-         _inputConnections.end() != walker; ++walker)
-    {
-        ChannelInfo * candidate(&*walker);
+#if defined(USE_FLYWEIGHT_PORTS_)
+    // The entry is drawn by its container, and is not itself on the screen.
+    Component * result = _parent;
+#else // ! defined(USE_FLYWEIGHT_PORTS_)
+    Component * result = this;
+#endif // ! defined(USE_FLYWEIGHT_PORTS_)
+
+    ODL_OBJEXIT_P(result); //####
+    return result;
+} // ChannelEntry::getOnScreenComponent
 
-        if (candidate)
-        {
-            candidate->_valid = false;
-        }
-    }
-    for (ChannelConnections::iterator walker(_outputConnections.begin());
+juce::Rectangle<int>
+ChannelEntry::getOutgoingConnectionBounds(void)
+const
+{
+    ODL_OBJENTER(); //####
+    juce::Rectangle<int> result;
+
+    for (ChannelConnections::const_iterator walker(_outputConnections.begin());
          _outputConnections.end() != walker; ++walker)
     {
-        ChannelInfo * candidate(&*walker);
+        const ChannelInfo * candidate(&*walker);
 
-        if (candidate)
+        if (candidate && candidate->_otherChannel)
         {
-            candidate->_valid = false;
+            result = result.getUnion(calculateConnectionBounds(this, candidate->_otherChannel));
         }
     }
     ODL_OBJEXIT(); //####
-} // ChannelEntry::invalidateConnections
+    return result;
+} // ChannelEntry::getOutgoingConnectionBounds
 
-bool
-ChannelEntry::isChannel(void)
+EntitiesPanel &
+ChannelEntry::getOwningPanel(void)
 const
 {
-    ODL_ENTER(); //####
-    bool result = false;
+    ODL_OBJENTER(); //####
+    EntitiesPanel & result(_parent->getOwner());
 
-    if (_parent)
-    {
-        ContainerKind parentKind = _parent->getKind();
+    ODL_OBJEXIT_P(&result); //####
+    return result;
+} // ChannelEntry::getOwningPanel
 
-        if ((kContainerKindAdapter == parentKind) || (kContainerKindService == parentKind))
-        {
-            result = true;
-        }
-    }
-    ODL_EXIT_B(result); //####
+Position
+ChannelEntry::getPositionInPanel(void)
+const
+{
+    ODL_OBJENTER(); //####
+    Position result(getPosition().toFloat() + _parent->getPositionInPanel());
+
+    ODL_OBJEXIT(); //####
     return result;
-} // ChannelEntry::isChannel
+} // ChannelEntry::getPositionInPanel
 
-void
-ChannelEntry::mouseDown(const MouseEvent & ee)
+bool
+ChannelEntry::handleMouseDown(const MouseEvent & ee)
 {
     ODL_OBJENTER(); //####
     bool            passOn = true;
@@ -1107,7 +1227,7 @@ ChannelEntry::mouseDown(const MouseEvent & ee)
     {
         // We started a 'remove' operation.
         clearDisconnectMarker();
-        repaint();
+        repaintEntry();
         owningPanel.rememberConnectionStartPoint();
         passOn = false;
         if (firstRemovePort != this)
@@ -1117,7 +1237,7 @@ ChannelEntry::mouseDown(const MouseEvent & ee)
 
             // Check if we can end here.
             firstRemovePort->clearDisconnectMarker();
-            firstRemovePort->repaint();
+            firstRemovePort->repaintEntry();
             if ((kPortDirectionOutput != _direction) && (kPortUsageService != _usage) &&
                 firstRemovePort->hasOutgoingConnectionTo(getPortName()))
             {
@@ -1125,6 +1245,7 @@ ChannelEntry::mouseDown(const MouseEvent & ee)
                 {
                     firstRemovePort->removeOutputConnection(this);
                     removeInputConnection(firstRemovePort);
+                    owningPanel.updateEntityIndex(firstRemovePort->getParent());
                     owningPanel.skipScan();
                     owningPanel.repaint();
                 }
@@ -1135,7 +1256,7 @@ ChannelEntry::mouseDown(const MouseEvent & ee)
     {
         // We started an 'add' operation.
         clearConnectMarker();
-        repaint();
+        repaintEntry();
         owningPanel.rememberConnectionStartPoint();
         passOn = false;
         if (firstAddPort != this)
@@ -1147,7 +1268,7 @@ ChannelEntry::mouseDown(const MouseEvent & ee)
 
             // Check if we can end here.
             firstAddPort->clearConnectMarker();
-            firstAddPort->repaint();
+            firstAddPort->repaintEntry();
             if ((kPortDirectionOutput != _direction) && (kPortUsageService != _usage) &&
                 protocolsMatch(firstProtocol, _portProtocol, protocolsOverridden) &&
                 (! firstAddPort->hasOutgoingConnectionTo(getPortName())))
@@ -1160,6 +1281,7 @@ ChannelEntry::mouseDown(const MouseEvent & ee)
 
                     firstAddPort->addOutputConnection(this, mode, protocolsOverridden);
                     addInputConnection(firstAddPort, mode, protocolsOverridden);
+                    owningPanel.updateEntityIndex(firstAddPort->getParent());
                     owningPanel.skipScan();
                     owningPanel.repaint();
                 }
@@ -1180,7 +1302,7 @@ ChannelEntry::mouseDown(const MouseEvent & ee)
                 _wasUdp = ee.mods.isShiftDown();
                 owningPanel.rememberConnectionStartPoint(this, true);
                 setConnectMarker();
-                repaint();
+                repaintEntry();
             }
             passOn = false;
         }
@@ -1192,7 +1314,7 @@ ChannelEntry::mouseDown(const MouseEvent & ee)
             {
                 owningPanel.rememberConnectionStartPoint(this, false);
                 setDisconnectMarker();
-                repaint();
+                repaintEntry();
             }
             passOn = false;
         }
@@ -1207,15 +1329,12 @@ ChannelEntry::mouseDown(const MouseEvent & ee)
             _parent->getOwner().getContent()->setChannelOfInterest(this);
         }
     }
-    if (passOn)
-    {
-        _parent->mouseDown(ee);
-    }
-    ODL_OBJEXIT(); //####
-} // ChannelEntry::mouseDown
+    ODL_OBJEXIT_B(passOn); //####
+    return passOn;
+} // ChannelEntry::handleMouseDown
 
-void
-ChannelEntry::mouseDrag(const MouseEvent & ee)
+bool
+ChannelEntry::handleMouseDrag(const MouseEvent & ee)
 {
     ODL_OBJENTER(); //####
     bool passOn = true;
@@ -1227,23 +1346,20 @@ ChannelEntry::mouseDrag(const MouseEvent & ee)
         ODL_D2("x = ", ee.position.getX(), "y = ", ee.position.getY()); //####
         EntitiesPanel & owningPanel(getOwningPanel());
 
+        // The panel repaints the areas covered by the old and new drag lines.
         owningPanel.setDragInfo(getPositionInPanel() + ee.position, ee.mods.isCtrlDown());
-        owningPanel.repaint();
         passOn = false;
     }
     else if (ee.mods.isCommandDown() || ee.mods.isPopupMenu())
     {
         passOn = false;
     }
-    if (passOn)
-    {
-        _parent->mouseDrag(ee);
-    }
-    ODL_OBJEXIT(); //####
-} // ChannelEntry::mouseDrag
+    ODL_OBJEXIT_B(passOn); //####
+    return passOn;
+} // ChannelEntry::handleMouseDrag
 
-void
-ChannelEntry::mouseUp(const MouseEvent & ee)
+bool
+ChannelEntry::handleMouseUp(const MouseEvent & ee)
 {
     ODL_OBJENTER(); //####
     bool            passOn = true;
@@ -1261,7 +1377,7 @@ ChannelEntry::mouseUp(const MouseEvent & ee)
             ChannelEntry * endEntry = owningPanel.locateEntry(newLocation);
 
             clearConnectMarker();
-            repaint();
+            repaintEntry();
             if (endEntry && (endEntry != this))
             {
                 // Check if we can end here.
@@ -1282,6 +1398,7 @@ ChannelEntry::mouseUp(const MouseEvent & ee)
 
                         addOutputConnection(endEntry, mode, protocolsOverridden);
                         endEntry->addInputConnection(this, mode, protocolsOverridden);
+                        owningPanel.updateEntityIndex(_parent);
                         owningPanel.skipScan();
                     }
                 }
@@ -1296,7 +1413,109 @@ ChannelEntry::mouseUp(const MouseEvent & ee)
     {
         passOn = false;
     }
-    if (passOn)
+    ODL_OBJEXIT_B(passOn); //####
+    return passOn;
+} // ChannelEntry::handleMouseUp
+
+bool
+ChannelEntry::hasOutgoingConnectionTo(const YarpString & otherPort)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("otherPort = ", otherPort); //####
+    bool result = false;
+
+    for (ChannelConnections::const_iterator walker(_outputConnections.begin());
+         _outputConnections.end() != walker; ++walker)
+    {
+        const ChannelInfo * candidate(&*walker);
+
+        if (candidate && candidate->_otherChannel &&
+            (candidate->_otherChannel->getPortName() == otherPort))
+        {
+            result = true;
+            break;
+        }
+
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ChannelEntry::hasOutgoingConnectionTo
+
+void
+ChannelEntry::invalidateConnections(void)
+{
+    ODL_OBJENTER(); //####
+    for (ChannelConnections::iterator walker(_inputConnections.begin());
+         _inputConnections.end() != walker; ++walker)
+    {
+        ChannelInfo * candidate(&*walker);
+
+        if (candidate)
+        {
+            candidate->_valid = false;
+        }
+    }
+    for (ChannelConnections::iterator walker(_outputConnections.begin());
+         _outputConnections.end() != walker; ++walker)
+    {
+        ChannelInfo * candidate(&*walker);
+
+        if (candidate)
+        {
+            candidate->_valid = false;
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // ChannelEntry::invalidateConnections
+
+bool
+ChannelEntry::isChannel(void)
+const
+{
+    ODL_ENTER(); //####
+    bool result = false;
+
+    if (_parent)
+    {
+        ContainerKind parentKind = _parent->getKind();
+
+        if ((kContainerKindAdapter == parentKind) || (kContainerKindService == parentKind))
+        {
+            result = true;
+        }
+    }
+    ODL_EXIT_B(result); //####
+    return result;
+} // ChannelEntry::isChannel
+
+void
+ChannelEntry::mouseDown(const MouseEvent & ee)
+{
+    ODL_OBJENTER(); //####
+    if (handleMouseDown(ee))
+    {
+        _parent->mouseDown(ee);
+    }
+    ODL_OBJEXIT(); //####
+} // ChannelEntry::mouseDown
+
+void
+ChannelEntry::mouseDrag(const MouseEvent & ee)
+{
+    ODL_OBJENTER(); //####
+    if (handleMouseDrag(ee))
+    {
+        _parent->mouseDrag(ee);
+    }
+    ODL_OBJEXIT(); //####
+} // ChannelEntry::mouseDrag
+
+void
+ChannelEntry::mouseUp(const MouseEvent & ee)
+{
+    ODL_OBJENTER(); //####
+    if (handleMouseUp(ee))
     {
         _parent->mouseUp(ee);
     }
@@ -1309,9 +1528,18 @@ ChannelEntry::paint(Graphics & gg)
     ODL_OBJENTER(); //####
     ODL_P1("gg = ", &gg); //####
     AttributedString as;
+    EntitiesPanel &  owningPanel = getOwningPanel();
 
     as.setJustification(Justification::left);
-    as.append(_title.c_str(), getOwningPanel().getNormalFont(), kEntryTextColour);
+    if (owningPanel.isSearchMatch(this))
+    {
+        as.append(_title.c_str(), owningPanel.getNormalFont(), kSearchMatchTextColour);
+    }
+    else
+    {
+        as.append(_title.c_str(), owningPanel.getNormalFont(),
+                  _parent->isStale() ? kStaleEntryTextColour : kEntryTextColour);
+    }
     juce::Rectangle<float> area(getLocalBounds().toFloat());
 
     ODL_D4("x <- ", area.getX(), "y <- ", area.getY(), "w <- ",area.getWidth(), "h <- ", //####
@@ -1381,6 +1609,19 @@ ChannelEntry::removeAllConnections(void)
     ODL_EXIT(); //####
 } // ChannelEntry::removeAllConnections
 
+void
+ChannelEntry::repaintEntry(void)
+{
+    ODL_OBJENTER(); //####
+#if defined(USE_FLYWEIGHT_PORTS_)
+    // The entry is drawn by its container, so the matching part of the container is redrawn.
+    _parent->repaint(getBounds());
+#else // ! defined(USE_FLYWEIGHT_PORTS_)
+    repaint();
+#endif // ! defined(USE_FLYWEIGHT_PORTS_)
+    ODL_OBJEXIT(); //####
+} // ChannelEntry::repaintEntry
+
 void
 ChannelEntry::removeInputConnection(ChannelEntry * other)
 {
@@ -1504,6 +1745,19 @@ ChannelEntry::removeOutputConnection(ChannelEntry * other)
     ODL_OBJEXIT(); //####
 } // ChannelEntry::removeOutputConnection
 
+void
+ChannelEntry::setActivityMarker(const bool showMarker)
+{
+    ODL_OBJENTER(); //####
+    ODL_B1("showMarker = ", showMarker); //####
+    if (showMarker != _drawActivityMarker)
+    {
+        _drawActivityMarker = showMarker;
+        repaintEntry();
+    }
+    ODL_OBJEXIT(); //####
+} // ChannelEntry::setActivityMarker
+
 void
 ChannelEntry::setAsLastPort(void)
 {
@@ -1512,6 +1766,19 @@ ChannelEntry::setAsLastPort(void)
     ODL_OBJEXIT(); //####
 } // ChannelEntry::setAsLastPort
 
+void
+ChannelEntry::setBeingMonitored(const bool monitored)
+{
+    ODL_OBJENTER(); //####
+    ODL_B1("monitored = ", monitored); //####
+    _beingMonitored = monitored;
+    if (! monitored)
+    {
+        setActivityMarker(false);
+    }
+    ODL_OBJEXIT(); //####
+} // ChannelEntry::setBeingMonitored
+
 void
 ChannelEntry::setConnectMarker(void)
 {
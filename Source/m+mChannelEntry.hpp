@@ -174,9 +174,12 @@ namespace MPlusM_Manager
                      const bool       isForced);
 
         /*! @brief Display the connections between containers.
-         @param[in,out] gg The graphics context in which to draw. */
-        void
-        drawOutgoingConnections(Graphics & gg);
+         @param[in,out] gg The graphics context in which to draw.
+         @param[in] drawArea The area of the panel that is being drawn.
+         @returns The number of connections that were drawn. */
+        size_t
+        drawOutgoingConnections(Graphics &                   gg,
+                                const juce::Rectangle<int> & drawArea);
 
         /*! @brief Return the location of the centre of the port entry.
          @returns The location of the centre of the port entry. */
@@ -193,6 +196,20 @@ namespace MPlusM_Manager
             return _direction;
         } // getDirection
 
+        /*! @brief Return the area of the panel that could be touched by a drag line from the entry.
+         @param[in] position The coordinates of the drag line endpoint.
+         @returns The area of the panel that could be touched by the drag line. */
+        juce::Rectangle<int>
+        getDragLineBounds(const Position & position)
+        const;
+
+        /*! @brief Return the area of the panel that could be touched by the incoming connections.
+         @returns The area of the panel that could be touched by the incoming connections, or an
+         empty rectangle if there are no incoming connections. */
+        juce::Rectangle<int>
+        getIncomingConnectionBounds(void)
+        const;
+
         /*! @brief Return the set of input connections to the port.
          @returns The set of input connections to the port. */
         inline const ChannelConnections &
@@ -211,6 +228,13 @@ namespace MPlusM_Manager
             return _outputConnections;
         } // getOutputConnections
 
+        /*! @brief Return the area of the panel that could be touched by the outgoing connections.
+         @returns The area of the panel that could be touched by the outgoing connections, or an
+         empty rectangle if there are no outgoing connections. */
+        juce::Rectangle<int>
+        getOutgoingConnectionBounds(void)
+        const;
+
         /*! @brief Return the panel which contains the entry.
          @returns The panel which contains the entry. */
         EntitiesPanel &
@@ -277,6 +301,31 @@ namespace MPlusM_Manager
             return _usage;
         } // getUsage
 
+        /*! @brief Respond to a mouse button being pressed over the entry.
+         @param[in] ee Details about the position and status of the mouse event, relative to the
+         entry.
+         @returns @c true if the event is to be handled by the container as well and @c false
+         otherwise. */
+        bool
+        handleMouseDown(const MouseEvent & ee);
+
+        /*! @brief Respond to the mouse being moved while a button is held down after being pressed
+         over the entry.
+         @param[in] ee Details about the position and status of the mouse event, relative to the
+         entry.
+         @returns @c true if the event is to be handled by the container as well and @c false
+         otherwise. */
+        bool
+        handleMouseDrag(const MouseEvent & ee);
+
+        /*! @brief Respond to a mouse button being released after being pressed over the entry.
+         @param[in] ee Details about the position and status of the mouse event, relative to the
+         entry.
+         @returns @c true if the event is to be handled by the container as well and @c false
+         otherwise. */
+        bool
+        handleMouseUp(const MouseEvent & ee);
+
         /*! @brief Returns @c true if there is an outgoing connection to the named port.
          @param[in] otherPort The name of the destination port.
          @returns @c true if there is an outgoing connection to the named port. */
@@ -357,10 +406,25 @@ namespace MPlusM_Manager
         void
         removeOutputConnection(ChannelEntry * other);
 
+        /*! @brief Redraw the area of the panel that is covered by the entry. */
+        void
+        repaintEntry(void);
+
+        /*! @brief Show or hide the activity marker.
+         @param[in] showMarker @c true if the marker is to be displayed and @c false otherwise. */
+        void
+        setActivityMarker(const bool showMarker);
+
         /*! @brief Mark the port entry as the bottom-most (last) port entry in a panel. */
         void
         setAsLastPort(void);
 
+        /*! @brief Record whether activity on the channel is being monitored.
+         @param[in] monitored @c true if activity on the channel is being monitored and @c false
+         otherwise. */
+        void
+        setBeingMonitored(const bool monitored);
+
         /*! @brief Start displaying the connect marker. */
         void
         setConnectMarker(void);
@@ -399,6 +463,11 @@ namespace MPlusM_Manager
         void
         displayAndProcessPopupMenu(void);
 
+        /*! @brief Return the component that shows the entry on the screen.
+         @returns The component that shows the entry on the screen. */
+        Component *
+        getOnScreenComponent(void);
+
         /*! @brief Called when a mouse button is pressed.
          @param[in] ee Details about the position and status of the mouse event. */
         virtual void
@@ -38,34 +38,23 @@
 //--------------------------------------------------------------------------------------------------
 
 #include "m+mContentPanel.hpp"
+#include "m+mActivityThread.hpp"
 #include "m+mChannelContainer.hpp"
 #include "m+mChannelEntry.hpp"
+#include "m+mEntitiesData.hpp"
 #include "m+mEntitiesPanel.hpp"
 #include "m+mEntityData.hpp"
+#include "m+mLayoutThread.hpp"
 #include "m+mManagerApplication.hpp"
+#include "m+mMetricsThread.hpp"
 #include "m+mPortData.hpp"
 #include "m+mScannerThread.hpp"
+#include "m+mScrollingMonitorWindow.hpp"
+#include "m+mStatisticsOverlay.hpp"
 
 //#include <odlEnable.h>
 #include <odlInclude.h>
 
-#if defined(USE_OGDF_POSITIONING_)
-# if MAC_OR_LINUX_
-#  pragma clang diagnostic push
-#  pragma clang diagnostic ignored "-Wunused-parameter"
-# else // ! MAC_OR_LINUX_
-#  pragma warning(push)
-#  pragma warning(disable: 4100)
-# endif // ! MAC_OR_LINUX_
-# include <ogdf/basic/GraphAttributes.h>
-# include <ogdf/energybased/FMMMLayout.h>
-# if MAC_OR_LINUX_
-#  pragma clang diagnostic pop
-# else // ! MAC_OR_LINUX_
-#  pragma warning(pop)
-# endif // ! MAC_OR_LINUX_
-#endif // defined(USE_OGDF_POSITIONING_)
-
 #if defined(__APPLE__)
 # pragma clang diagnostic push
 # pragma clang diagnostic ignored "-Wunknown-pragmas"
@@ -104,12 +93,18 @@ static const Colour & kFirstBackgroundColour(Colours::darkgrey);
 /*! @brief The second colour to be used for the panel background. */
 static const Colour & kSecondBackgroundColour(Colours::lightgrey);
 
+/*! @brief The colour to be used for the prompt in the empty search box. */
+static const Colour & kSearchPromptColour(Colours::grey);
+
 /*! @brief The first colour to be used for the selection rectangle. */
 static const Colour & kFirstSelectionColour(Colours::greenyellow);
 
 /*! @brief The second colour to be used for the selection rectangle. */
 static const Colour & kSecondSelectionColour(Colours::darkmagenta);
 
+/*! @brief The colour to be used for the layout progress text. */
+static const Colour & kLayoutProgressColour(Colours::darkblue);
+
 /*! @brief The offset of the selection rectangle from the selected entity. */
 static const float kSelectionOffset = 4;
 
@@ -125,6 +120,50 @@ static const int kDefaultSingleStepSize = 10;
 /*! @brief After width to be added to display panels. */
 static const int kExtraDisplayWidth = 32;
 
+/*! @brief The distance around a newly-discovered entity within which other entities are kept
+ clear of it. */
+static const int kLocalNeighbourhood = 200;
+
+/*! @brief The largest distance from its connected entities at which a newly-discovered entity is
+ first placed. */
+static const float kLocalPlacementSpread = 100;
+
+/*! @brief The number of milliseconds in a day. */
+static const int64 kMillisecondsPerDay = (24 * 60 * 60 * 1000);
+
+/*! @brief The time after which an entity that has not been seen is forgotten, in milliseconds. */
+static const int64 kDefaultPositionAgeLimit = (30 * kMillisecondsPerDay);
+
+/*! @brief The environment variable that overrides the age limit for remembered positions, in
+ days. */
+static const char * kPositionAgeLimitVariable = "MPM_MANAGER_POSITION_AGE_LIMIT";
+
+/*! @brief The width of the search box. */
+static const int kSearchBoxWidth = 200;
+
+/*! @brief The time to wait after the last change before saving the positions, in milliseconds. */
+static const int kPositionSaveDelay = 2000;
+
+/*! @brief The tag for a line in the topology file that describes an argument of the preceding
+ entity. */
+static const char * kTopologyArgumentTag = "A";
+
+/*! @brief The tag for a line in the topology file that describes a connection between ports. */
+static const char * kTopologyConnectionTag = "C";
+
+/*! @brief The tag for a line in the topology file that describes an entity. */
+static const char * kTopologyEntityTag = "E";
+
+/*! @brief The first line of a topology file; files that start with anything else are ignored. */
+static const char * kTopologyFileHeader = "m+m manager topology 1";
+
+/*! @brief The tag for a line in the topology file that describes a port of the preceding
+ entity. */
+static const char * kTopologyPortTag = "P";
+
+/*! @brief The factor by which the zoom level changes for each zoom step. */
+static const float kZoomStep = 1.25;
+
 #if defined(__APPLE__)
 # pragma mark Global constants and variables
 #endif // defined(__APPLE__)
@@ -133,18 +172,239 @@ static const int kExtraDisplayWidth = 32;
 # pragma mark Local functions
 #endif // defined(__APPLE__)
 
-/*! @brief Returns the absolute path to the settings file.
- @returns The absolute path to the settings file. */
+/*! @brief Add the ports and argument descriptions of a scanned entity that are missing from a
+ displayed entity.
+ @param[in,out] entitiesPanel The panel containing the displayed entity.
+ @param[in,out] aContainer The displayed entity.
+ @param[in] anEntity The scanned entity. */
+static void
+addMissingDetails(EntitiesPanel &    entitiesPanel,
+                  ChannelContainer & aContainer,
+                  const EntityData & anEntity)
+{
+    ODL_ENTER(); //####
+    ODL_P3("entitiesPanel = ", &entitiesPanel, "aContainer = ", &aContainer, //####
+           "anEntity = ", &anEntity); //####
+    for (int ii = 0, mm = anEntity.getNumPorts(); mm > ii; ++ii)
+    {
+        PortData * aPort = anEntity.getPort(ii);
+
+        if (aPort && (! entitiesPanel.findKnownPort(aPort->getPortName())))
+        {
+            ChannelEntry * newPort = aContainer.addPort(aPort->getPortName(),
+                                                        aPort->getPortNumber(),
+                                                        aPort->getProtocol(),
+                                                        aPort->getProtocolDescription(),
+                                                        aPort->getUsage(), aPort->getDirection());
+
+            entitiesPanel.rememberPort(newPort);
+        }
+    }
+    if (0 == aContainer.getNumArgumentDescriptors())
+    {
+        for (size_t ii = 0, mm = anEntity.getNumArgumentDescriptors(); mm > ii; ++ii)
+        {
+            Utilities::BaseArgumentDescriptor * argDesc = anEntity.getArgumentDescriptor(ii);
+
+            if (argDesc)
+            {
+                aContainer.addArgumentDescription(argDesc);
+            }
+        }
+    }
+    ODL_EXIT(); //####
+} // addMissingDetails
+
+/*! @brief Return a field from the topology file with its escaped characters restored.
+ @param[in] aField The field as it appears in the file.
+ @returns The field with its escaped characters restored. */
+static YarpString
+decodeTopologyField(const String & aField)
+{
+    ODL_ENTER(); //####
+    ODL_S1s("aField = ", aField.toStdString()); //####
+    YarpString encoded(aField.toStdString());
+    YarpString result;
+
+    for (size_t ii = 0, mm = encoded.length(); mm > ii; ++ii)
+    {
+        char aChar = encoded[ii];
+
+        if (('\\' == aChar) && (mm > (ii + 1)))
+        {
+            aChar = encoded[++ii];
+            switch (aChar)
+            {
+                case 'n' :
+                    result += '\n';
+                    break;
+
+                case 'r' :
+                    result += '\r';
+                    break;
+
+                case 't' :
+                    result += '\t';
+                    break;
+
+                default :
+                    result += aChar;
+                    break;
+
+            }
+        }
+        else
+        {
+            result += aChar;
+        }
+    }
+    ODL_EXIT_s(result); //####
+    return result;
+} // decodeTopologyField
+
+/*! @brief Return a field for the topology file, with the characters that separate fields and
+ lines escaped.
+ @param[in] aField The field to be written.
+ @returns The field with its special characters escaped. */
+static YarpString
+encodeTopologyField(const YarpString & aField)
+{
+    ODL_ENTER(); //####
+    ODL_S1s("aField = ", aField); //####
+    YarpString result;
+
+    for (size_t ii = 0, mm = aField.length(); mm > ii; ++ii)
+    {
+        char aChar = aField[ii];
+
+        switch (aChar)
+        {
+            case '\\' :
+                result += "\\\\";
+                break;
+
+            case '\n' :
+                result += "\\n";
+                break;
+
+            case '\r' :
+                result += "\\r";
+                break;
+
+            case '\t' :
+                result += "\\t";
+                break;
+
+            default :
+                result += aChar;
+                break;
+
+        }
+    }
+    ODL_EXIT_s(result); //####
+    return result;
+} // encodeTopologyField
+
+/*! @brief Return the position of an entity in a layout, adding the entity if it is not already
+ present.
+ @param[in,out] indices The positions of the entities in the layout.
+ @param[in,out] nodes The entities in the layout.
+ @param[in] anEntity The entity of interest.
+ @param[in] isMovable @c true if the layout can move the entity and @c false otherwise.
+ @returns The position of the entity in the layout. */
+static size_t
+findOrAddLayoutNode(ContainerIndexMap & indices,
+                    LayoutNodeList &    nodes,
+                    ChannelContainer *  anEntity,
+                    const bool          isMovable)
+{
+    ODL_ENTER(); //####
+    ODL_P3("indices = ", &indices, "nodes = ", &nodes, "anEntity = ", anEntity); //####
+    ODL_B1("isMovable = ", isMovable); //####
+    size_t                            result;
+    ContainerIndexMap::const_iterator match(indices.find(anEntity));
+
+    if (indices.end() == match)
+    {
+        LayoutNode aNode;
+
+        aNode._name = anEntity->getName().toStdString();
+        aNode._position = aNode._provisional = anEntity->getPosition().toFloat();
+        aNode._height = static_cast<float>(anEntity->getHeight());
+        aNode._width = static_cast<float>(anEntity->getWidth());
+        aNode._movable = isMovable;
+        result = indices[anEntity] = nodes.size();
+        nodes.push_back(aNode);
+    }
+    else
+    {
+        result = match->second;
+    }
+    ODL_EXIT_LL(result); //####
+    return result;
+} // findOrAddLayoutNode
+
+/*! @brief Returns the absolute path to the directory holding the settings files.
+ @returns The absolute path to the directory holding the settings files. */
 static String
-getPathToSettingsFile(void)
+getPathToSettingsDirectory(void)
 {
     File   baseDir = File::getSpecialLocation(File::userApplicationDataDirectory);
     String baseDirAsString = File::addTrailingSeparator(baseDir.getFullPathName());
-    String settingsDir = File::addTrailingSeparator(baseDirAsString + "m+m manager");
 
-    return settingsDir + "settings.txt";
+    return File::addTrailingSeparator(baseDirAsString + "m+m manager");
+} // getPathToSettingsDirectory
+
+/*! @brief Returns the absolute path to the settings file.
+ @returns The absolute path to the settings file. */
+static String
+getPathToSettingsFile(void)
+{
+    return getPathToSettingsDirectory() + "settings.txt";
 } // getPathToSettingsFile
 
+/*! @brief Returns the absolute path to the topology file.
+ @returns The absolute path to the topology file. */
+static String
+getPathToTopologyFile(void)
+{
+    return getPathToSettingsDirectory() + "topology.txt";
+} // getPathToTopologyFile
+
+/*! @brief Replace the contents of a settings file.
+ The new contents are written in one go to a file alongside the settings file, which then replaces
+ it, so that a failure part way through can't lose the existing contents.
+ @param[in] filePath The absolute path to the settings file.
+ @param[in] contents The new contents of the settings file. */
+static void
+replaceSettingsFile(const String &     filePath,
+                    const YarpString & contents)
+{
+    ODL_ENTER(); //####
+    ODL_S2s("filePath = ", filePath.toStdString(), "contents = ", contents); //####
+    File settingsFile(filePath);
+
+    if (settingsFile.getParentDirectory().createDirectory().wasOk())
+    {
+        ODL_LOG("(settingsFile.getParentDirectory().createDirectory().wasOk())"); //####
+        TemporaryFile tempFile(settingsFile);
+
+        if (tempFile.getFile().replaceWithText(contents))
+        {
+            if (! tempFile.overwriteTargetFileWithTemporary())
+            {
+                char buffer1[DATE_TIME_BUFFER_SIZE_];
+                char buffer2[DATE_TIME_BUFFER_SIZE_];
+
+                Utilities::GetDateAndTime(buffer1, sizeof(buffer1), buffer2, sizeof(buffer2));
+                std::cerr << buffer1 << " " << buffer2 << " Could not replace " <<
+                            filePath.toStdString() << std::endl;
+            }
+        }
+    }
+    ODL_EXIT(); //####
+} // replaceSettingsFile
+
 #if defined(__APPLE__)
 # pragma mark Class methods
 #endif // defined(__APPLE__)
@@ -154,17 +414,37 @@ getPathToSettingsFile(void)
 #endif // defined(__APPLE__)
 
 ContentPanel::ContentPanel(ManagerWindow * containingWindow) :
-    inherited1(), inherited2(), inherited3(), _entitiesPanel(new EntitiesPanel(this)),
-    _menuBar(new MenuBarComponent(this)), _containingWindow(containingWindow),
+    inherited1(), inherited2(), inherited3(), inherited4(), inherited5(), _alerts(),
+    _monitors(), _trafficWeights(), _activityThread(),
+    _entitiesPanel(new EntitiesPanel(this)), _layoutThread(), _menuBar(new MenuBarComponent(this)),
+    _metricsThread(), _searchBox(new TextEditor("search")), _statistics(new StatisticsOverlay),
+    _containingWindow(containingWindow), _positionAgeLimit(kDefaultPositionAgeLimit),
+    _trafficWeighting(kTrafficWeightingNone),
     _selectedChannel(NULL), _selectedContainer(NULL), _channelClicked(false),
-    _containerClicked(false),
-#if (defined(USE_OGDF_POSITIONING_) && defined(USE_OGDF_FOR_FIRST_POSITIONING_ONLY_))
-    _initialPositioningDone(false),
-#endif // defined(USE_OGDF_POSITIONING_) && defined(USE_OGDF_FOR_FIRST_POSITIONING_ONLY_)
-    _invertBackground(false), _skipNextScan(false), _whiteBackground(false)
+    _containerClicked(false), _initialPositioningDone(false), _invertBackground(false),
+    _skipNextScan(false), _whiteBackground(false)
 {
     ODL_ENTER(); //####
+    String ageLimit(ManagerApplication::getEnvironmentVar(kPositionAgeLimitVariable));
+
+    if (0 < ageLimit.getIntValue())
+    {
+        _positionAgeLimit = ageLimit.getIntValue() * kMillisecondsPerDay;
+    }
+    _activityThread = new ActivityThread(*this);
+    _activityThread->startThread();
+    _metricsThread = new MetricsThread(*this);
+    _metricsThread->startThread();
+#if (defined(USE_OGDF_POSITIONING_) || defined(USE_NATIVE_POSITIONING_))
+    _layoutThread = new LayoutThread(*this);
+    _layoutThread->startThread();
+#endif // defined(USE_OGDF_POSITIONING_) || defined(USE_NATIVE_POSITIONING_)
     addAndMakeVisible(_menuBar);
+    _searchBox->setTextToShowWhenEmpty("Search", kSearchPromptColour);
+    _searchBox->addListener(this);
+    addAndMakeVisible(_searchBox);
+    // The display starts out hidden, and is shown on request.
+    addChildComponent(_statistics);
     _entitiesPanel->setSize(_entitiesPanel->getWidth(),
                             _entitiesPanel->getHeight() - _containingWindow->getTitleBarHeight());
     setSize(_entitiesPanel->getWidth(), _entitiesPanel->getHeight());
@@ -178,6 +458,12 @@ ContentPanel::ContentPanel(ManagerWindow * containingWindow) :
 ContentPanel::~ContentPanel(void)
 {
     ODL_OBJENTER(); //####
+    stopTimer();
+    _monitors.clear();
+    // Stop the background threads before the panel that they refer to goes away.
+    _activityThread = NULL;
+    _layoutThread = NULL;
+    _metricsThread = NULL;
     PopupMenu::dismissAllActiveMenus();
     ODL_OBJEXIT(); //####
 } // ContentPanel::~ContentPanel
@@ -186,6 +472,31 @@ ContentPanel::~ContentPanel(void)
 # pragma mark Actions and Accessors
 #endif // defined(__APPLE__)
 
+void
+ContentPanel::addScrollingMonitor(ChannelEntry & aChannel)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("aChannel = ", &aChannel); //####
+    ScrollingMonitorWindow * aMonitor = NULL;
+
+    for (int ii = 0, mm = _monitors.size(); (mm > ii) && (! aMonitor); ++ii)
+    {
+        if (_monitors[ii]->getPortName() == aChannel.getPortName())
+        {
+            aMonitor = _monitors[ii];
+        }
+    }
+    if (aMonitor)
+    {
+        aMonitor->toFront(true);
+    }
+    else
+    {
+        _monitors.add(new ScrollingMonitorWindow(*this, aChannel.getPortName()));
+    }
+    ODL_OBJEXIT(); //####
+} // ContentPanel::addScrollingMonitor
+
 void
 ContentPanel::getAllCommands(Array<CommandID> & commands)
 {
@@ -198,7 +509,23 @@ ContentPanel::getAllCommands(Array<CommandID> & commands)
         ManagerWindow::kCommandClearSelection,
         ManagerWindow::kCommandUnhideEntities,
         ManagerWindow::kCommandLaunchRegistryService,
-        ManagerWindow::kCommandLaunchExecutables
+        ManagerWindow::kCommandLaunchExecutables,
+        ManagerWindow::kCommandCacheEntityImages,
+        ManagerWindow::kCommandZoomIn,
+        ManagerWindow::kCommandZoomOut,
+        ManagerWindow::kCommandZoomReset,
+        ManagerWindow::kCommandUseNativeLayout,
+        ManagerWindow::kCommandBenchmarkLayout,
+        ManagerWindow::kCommandCollapseHostGroups,
+        ManagerWindow::kCommandExpandHostGroups,
+        ManagerWindow::kCommandFindEntities,
+        ManagerWindow::kCommandFindNext,
+        ManagerWindow::kCommandFindPrevious,
+        ManagerWindow::kCommandShowStatistics,
+        ManagerWindow::kCommandBenchmarkDrawing,
+        ManagerWindow::kCommandWeightByByteRate,
+        ManagerWindow::kCommandWeightByMessageRate,
+        ManagerWindow::kCommandShowAlerts
     };
 
     commands.addArray(ids, numElementsInArray(ids));
@@ -256,6 +583,107 @@ ContentPanel::getCommandInfo(CommandID                commandID,
                              (0 < ourApp->getCountOfApplications()));
             break;
 
+        case ManagerWindow::kCommandCacheEntityImages :
+            result.setInfo("Cache entity images", "Reuse the rendered images of entities", "View",
+                           0);
+            result.setTicked(_entitiesPanel->entityImagesAreCached());
+            break;
+
+        case ManagerWindow::kCommandZoomIn :
+            result.setInfo("Zoom in", "Enlarge the entities and connections", "View", 0);
+            result.addDefaultKeypress('=', ModifierKeys::commandModifier);
+            break;
+
+        case ManagerWindow::kCommandZoomOut :
+            result.setInfo("Zoom out", "Shrink the entities and connections", "View", 0);
+            result.addDefaultKeypress('-', ModifierKeys::commandModifier);
+            break;
+
+        case ManagerWindow::kCommandZoomReset :
+            result.setInfo("Actual size", "Show the entities and connections at their normal size",
+                           "View", 0);
+            result.addDefaultKeypress('0', ModifierKeys::commandModifier);
+            result.setActive(_entitiesPanel->isZoomed());
+            break;
+
+        case ManagerWindow::kCommandUseNativeLayout :
+            result.setInfo("Built-in layout", "Use the built-in layout rather than OGDF", "View",
+                           0);
+#if (defined(USE_OGDF_POSITIONING_) && defined(USE_NATIVE_POSITIONING_))
+            result.setActive(NULL != _layoutThread);
+#else // ! (defined(USE_OGDF_POSITIONING_) && defined(USE_NATIVE_POSITIONING_))
+            result.setActive(false);
+#endif // ! (defined(USE_OGDF_POSITIONING_) && defined(USE_NATIVE_POSITIONING_))
+            result.setTicked(_layoutThread && _layoutThread->isUsingNativeLayout());
+            break;
+
+        case ManagerWindow::kCommandBenchmarkLayout :
+            result.setInfo("Benchmark layout", "Time the layout of synthetic sets of entities",
+                           "View", 0);
+            result.setActive(NULL != _layoutThread);
+            break;
+
+        case ManagerWindow::kCommandCollapseHostGroups :
+            result.setInfo("Collapse hosts", "Show the standalone ports of each host as a single "
+                           "entity", "View", 0);
+            result.setActive(0 < _entitiesPanel->getNumberOfHostGroups());
+            break;
+
+        case ManagerWindow::kCommandExpandHostGroups :
+            result.setInfo("Expand hosts", "Show the standalone ports of each host separately",
+                           "View", 0);
+            result.setActive(0 < _entitiesPanel->getNumberOfHostGroups());
+            break;
+
+        case ManagerWindow::kCommandFindEntities :
+            result.setInfo("Find ...", "Search the entities and ports", "View", 0);
+            result.addDefaultKeypress('F', ModifierKeys::commandModifier);
+            break;
+
+        case ManagerWindow::kCommandFindNext :
+            result.setInfo("Find next", "Select the next entity that matches the search", "View",
+                           0);
+            result.addDefaultKeypress('G', ModifierKeys::commandModifier);
+            result.setActive(0 < _entitiesPanel->getNumberOfSearchMatches());
+            break;
+
+        case ManagerWindow::kCommandFindPrevious :
+            result.setInfo("Find previous", "Select the previous entity that matches the search",
+                           "View", 0);
+            result.addDefaultKeypress('G', ModifierKeys::commandModifier |
+                                      ModifierKeys::shiftModifier);
+            result.setActive(0 < _entitiesPanel->getNumberOfSearchMatches());
+            break;
+
+        case ManagerWindow::kCommandShowStatistics :
+            result.setInfo("Show statistics", "Show the time taken to draw, update and lay out the "
+                           "entities", "View", 0);
+            result.setTicked(_statistics->isVisible());
+            break;
+
+        case ManagerWindow::kCommandBenchmarkDrawing :
+            result.setInfo("Benchmark drawing", "Time the drawing of synthetic sets of entities",
+                           "View", 0);
+            break;
+
+        case ManagerWindow::kCommandWeightByByteRate :
+            result.setInfo("Weight connections by bytes", "Draw busier connections more thickly, "
+                           "using the rate of bytes", "View", 0);
+            result.setTicked(kTrafficWeightingBytes == _trafficWeighting);
+            break;
+
+        case ManagerWindow::kCommandWeightByMessageRate :
+            result.setInfo("Weight connections by messages", "Draw busier connections more "
+                           "thickly, using the rate of messages", "View", 0);
+            result.setTicked(kTrafficWeightingMessages == _trafficWeighting);
+            break;
+
+        case ManagerWindow::kCommandShowAlerts :
+            result.setInfo("Show alerts ...", "Show the alerts raised by the metrics alert rules",
+                           "View", 0);
+            result.setActive(! _alerts.empty());
+            break;
+
         default :
             break;
 
@@ -340,6 +768,91 @@ ContentPanel::getNextCommandTarget(void)
     return nextOne;
 } // ContentPanel::getNextCommandTarget
 
+void
+ContentPanel::getScannerHealth(ScannerHealth & health)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("health = ", &health); //####
+    ScannerThread * scanner = _containingWindow->getScannerThread();
+
+    if (scanner)
+    {
+        scanner->getHealth(health);
+    }
+    else
+    {
+        health._lastScanDuration = 0;
+        health._lastScanTime = health._scansCompleted = health._scansFailed = 0;
+    }
+    ODL_OBJEXIT(); //####
+} // ContentPanel::getScannerHealth
+
+void
+ContentPanel::getServicePorts(PortSet &           servicePorts,
+                              ServiceKindMap &    serviceKinds,
+                              ServiceChannelMap & serviceChannels)
+{
+    ODL_OBJENTER(); //####
+    ODL_P3("servicePorts = ", &servicePorts, "serviceKinds = ", &serviceKinds, //####
+           "serviceChannels = ", &serviceChannels); //####
+    for (size_t ii = 0, mm = _entitiesPanel->getNumberOfEntities(); mm > ii; ++ii)
+    {
+        ChannelContainer * anEntity = _entitiesPanel->getEntity(ii);
+
+        if (anEntity)
+        {
+            ChannelEntry * servicePort = anEntity->getServicePort();
+
+            if (servicePort)
+            {
+                PortSet & channels = serviceChannels[servicePort->getPortName()];
+
+                servicePorts.insert(servicePort->getPortName());
+                serviceKinds[servicePort->getPortName()] = anEntity->getBehaviour();
+                for (int jj = 0, nn = anEntity->getNumPorts(); nn > jj; ++jj)
+                {
+                    ChannelEntry * aPort = anEntity->getPort(jj);
+
+                    if (aPort)
+                    {
+                        channels.insert(aPort->getPortName());
+                    }
+                }
+            }
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // ContentPanel::getServicePorts
+
+float
+ContentPanel::getTrafficWeight(const YarpString & channelName)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("channelName = ", channelName); //####
+    float result = -1;
+
+    if (kTrafficWeightingNone != _trafficWeighting)
+    {
+        TrafficWeightMap::const_iterator match(_trafficWeights.find(channelName));
+
+        if (_trafficWeights.end() == match)
+        {
+            result = 0;
+        }
+        else if (kTrafficWeightingBytes == _trafficWeighting)
+        {
+            result = match->second._bytes;
+        }
+        else
+        {
+            result = match->second._messages;
+        }
+    }
+    ODL_OBJEXIT_D(result); //####
+    return result;
+} // ContentPanel::getTrafficWeight
+
 #if (! MAC_OR_LINUX_)
 # pragma warning(push)
 # pragma warning(disable: 4100)
@@ -365,6 +878,10 @@ ContentPanel::menuItemSelected(int menuItemID,
     switch (menuItemID)
     {
             // Container menu items
+        case kPopupCollapseHostGroup :
+            _entitiesPanel->setHostGroupCollapsed(_selectedContainer->getHostGroup(), true);
+            break;
+
         case kPopupConfigureService :
             //TBD!!!
             break;
@@ -385,6 +902,10 @@ ContentPanel::menuItemSelected(int menuItemID,
             _selectedContainer->displayMetrics();
             break;
 
+        case kPopupExpandHostGroup :
+            _entitiesPanel->setHostGroupCollapsed(_selectedContainer, false);
+            break;
+
         case kPopupHideEntity :
             _selectedContainer->hide();
             break;
@@ -403,9 +924,11 @@ ContentPanel::menuItemSelected(int menuItemID,
 
             // Channel menu items
         case kPopupAddScrollingMonitor :
+            addScrollingMonitor(*_selectedChannel);
             break;
 
         case kPopupAddSimpleMonitor :
+            toggleActivityIndicator(*_selectedChannel);
             break;
 
         case kPopupDetailedDisplayPortInfo :
@@ -430,51 +953,170 @@ ContentPanel::menuItemSelected(int menuItemID,
 # pragma warning(pop)
 #endif // ! MAC_OR_LINUX_
 
-void
-ContentPanel::paint(Graphics & gg)
+bool
+ContentPanel::mergeScannedEntities(const EntitiesData & scannedData,
+                                   const bool           fromSnapshot)
 {
     ODL_OBJENTER(); //####
-    ODL_P1("gg = ", &gg); //####
-    ChannelContainer * ofInterest;
+    ODL_P1("scannedData = ", &scannedData); //####
+    ODL_B1("fromSnapshot = ", fromSnapshot); //####
+    bool changeSeen = false;
 
-    if (_whiteBackground)
-    {
-        gg.setFillType(_invertBackground ? kFirstBackgroundColour : kSecondBackgroundColour);
-    }
-    else
+    // Retrieve each entity from our new list; if it is known already, ignore it but mark the
+    // old entity as known.
+    _entitiesPanel->clearAllVisitedFlags();
+    _entitiesPanel->clearAllNewlyCreatedFlags();
+    _entitiesPanel->invalidateAllConnections();
+    for (size_t ii = 0, mm = scannedData.getNumberOfEntities(); mm > ii; ++ii)
     {
-        // Set up a gradient background, using a radial gradient from the centre to the furthest
-        // edge.
-        int   hh = getHeight();
-        int   ww = getWidth();
-        float halfH = static_cast<float>(hh / 2.0);
-        float halfW = static_cast<float>(ww / 2.0);
-
-        if (_invertBackground)
-        {
-            ColourGradient theGradient2(kFirstBackgroundColour, halfW, halfH,
-                                        kSecondBackgroundColour,
-                                        static_cast<float>((hh > ww) ? 0 : ww),
-                                        static_cast<float>((hh > ww) ? hh : 0), true);
-            FillType       theBackgroundFill2(theGradient2);
+        EntityData * anEntity = scannedData.getEntity(ii);
 
-            gg.setFillType(theBackgroundFill2);
-        }
-        else
+        ODL_P1("anEntity <- ", anEntity); //####
+        if (anEntity)
         {
-            ColourGradient theGradient1(kSecondBackgroundColour, halfW, halfH,
-                                        kFirstBackgroundColour,
-                                        static_cast<float>((hh > ww) ? 0 : ww),
-                                        static_cast<float>((hh > ww) ? hh : 0), true);
-            FillType       theBackgroundFill1(theGradient1);
+            ODL_S1s("anEntity->getName() = ", anEntity->getName()); //####
+            ChannelContainer * oldContainer = _entitiesPanel->findKnownEntity(anEntity->getName());
 
-            gg.setFillType(theBackgroundFill1);
-        }
-    }
-    gg.fillAll();
-    _channelClicked = _containerClicked = false;
-    ODL_B2("_channelClicked <- ", _channelClicked, "_containerClicked <- ", //####
-           _containerClicked); //####
+            if (oldContainer && oldContainer->isStale() && (! fromSnapshot))
+            {
+                // The entity was recalled from the previous session, and has now been seen; its
+                // ports and arguments may have changed since then, so it is rebuilt from the scan
+                // in the position that it had.
+                _entitiesPanel->removeEntity(oldContainer);
+                oldContainer = NULL;
+            }
+            if (oldContainer)
+            {
+                ODL_LOG("(oldContainer)"); //####
+                oldContainer->setVisited();
+            }
+            else
+            {
+                // Make a copy of the newly discovered entity, and add it to the active panel.
+                ChannelContainer * newContainer = new ChannelContainer(anEntity->getKind(),
+                                                                       anEntity->getName(),
+                                                                       anEntity->getIPAddress(),
+                                                                       anEntity->getBehaviour(),
+                                                                       anEntity->getDescription(),
+                                                                   anEntity->getExtraInformation(),
+                                                                       anEntity->getRequests(),
+                                                                       *_entitiesPanel);
+
+                newContainer->setVisited();
+                newContainer->setStale(fromSnapshot);
+                // Make copies of the ports and arguments of the entity, and add them to the new
+                // entity.
+                addMissingDetails(*_entitiesPanel, *newContainer, *anEntity);
+                _entitiesPanel->addEntity(newContainer);
+                changeSeen = true;
+            }
+        }
+    }
+    // Convert the detected connections into visible connections.
+    const ConnectionList & connections(scannedData.getConnections());
+
+    for (ConnectionList::const_iterator walker(connections.begin()); connections.end() != walker;
+         ++walker)
+    {
+        ChannelEntry * thisPort = _entitiesPanel->findKnownPort(walker->_outPortName);
+        ChannelEntry * otherPort = _entitiesPanel->findKnownPort(walker->_inPortName);
+
+        ODL_P2("thisPort <- ", thisPort, "otherPort <- ", otherPort); //####
+        if (thisPort && otherPort)
+        {
+            ODL_S2s("thisPort.name = ", thisPort->getPortName(), //####
+                    "otherPort.name = ", otherPort->getPortName()); //####
+            thisPort->addOutputConnection(otherPort, walker->_mode, false);
+            otherPort->addInputConnection(thisPort, walker->_mode, false);
+        }
+    }
+    // The standalone ports are grouped before the unvisited entities are removed, so that the
+    // groups never refer to removed ports.
+    _entitiesPanel->updateHostGroups();
+    if (_entitiesPanel->removeUnvisitedEntities())
+    {
+        changeSeen = true;
+    }
+    _entitiesPanel->removeInvalidConnections();
+    _entitiesPanel->updateEntityIndexForAll();
+    ODL_LOG("about to call adjustSize()"); //####
+    _entitiesPanel->adjustSize(false);
+    ODL_OBJEXIT_B(changeSeen); //####
+    return changeSeen;
+} // ContentPanel::mergeScannedEntities
+
+void
+ContentPanel::mouseWheelMove(const MouseEvent &        ee,
+                             const MouseWheelDetails & wheel)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("ee = ", &ee, "wheel = ", &wheel); //####
+    if (ee.mods.isCommandDown())
+    {
+        // Zoom around the mouse position, so that the entity under the mouse stays in place.
+        if (0 < wheel.deltaY)
+        {
+            zoomAround(_entitiesPanel->getZoom() * kZoomStep, ee.getPosition());
+            requestWindowRepaint();
+        }
+        else if (0 > wheel.deltaY)
+        {
+            zoomAround(_entitiesPanel->getZoom() / kZoomStep, ee.getPosition());
+            requestWindowRepaint();
+        }
+    }
+    else
+    {
+        inherited5::mouseWheelMove(ee, wheel);
+    }
+    ODL_OBJEXIT(); //####
+} // ContentPanel::mouseWheelMove
+
+void
+ContentPanel::paint(Graphics & gg)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("gg = ", &gg); //####
+    ChannelContainer * ofInterest;
+
+    if (_whiteBackground)
+    {
+        gg.setFillType(_invertBackground ? kFirstBackgroundColour : kSecondBackgroundColour);
+    }
+    else
+    {
+        // Set up a gradient background, using a radial gradient from the centre to the furthest
+        // edge.
+        int   hh = getHeight();
+        int   ww = getWidth();
+        float halfH = static_cast<float>(hh / 2.0);
+        float halfW = static_cast<float>(ww / 2.0);
+
+        if (_invertBackground)
+        {
+            ColourGradient theGradient2(kFirstBackgroundColour, halfW, halfH,
+                                        kSecondBackgroundColour,
+                                        static_cast<float>((hh > ww) ? 0 : ww),
+                                        static_cast<float>((hh > ww) ? hh : 0), true);
+            FillType       theBackgroundFill2(theGradient2);
+
+            gg.setFillType(theBackgroundFill2);
+        }
+        else
+        {
+            ColourGradient theGradient1(kSecondBackgroundColour, halfW, halfH,
+                                        kFirstBackgroundColour,
+                                        static_cast<float>((hh > ww) ? 0 : ww),
+                                        static_cast<float>((hh > ww) ? hh : 0), true);
+            FillType       theBackgroundFill1(theGradient1);
+
+            gg.setFillType(theBackgroundFill1);
+        }
+    }
+    gg.fillAll();
+    _channelClicked = _containerClicked = false;
+    ODL_B2("_channelClicked <- ", _channelClicked, "_containerClicked <- ", //####
+           _containerClicked); //####
     if (_selectedChannel)
     {
         ofInterest = _selectedChannel->getParent();
@@ -505,6 +1147,8 @@ ContentPanel::paint(Graphics & gg)
             {
                 selectionRectangle = _selectedContainer->getBounds().toFloat();
             }
+            // Correct for any zooming:
+            selectionRectangle *= _entitiesPanel->getZoom();
             // Correct for any active scrolling:
             selectionRectangle.translate(- viewOffsetX, - viewOffsetY);
             selectionRectangle.expand(kSelectionOffset, kSelectionOffset);
@@ -563,6 +1207,44 @@ ContentPanel::paint(Graphics & gg)
             scanner->scanCanProceed();
         }
     }
+    if (_layoutThread)
+    {
+        LayoutNodeList layoutResults;
+        String         progress;
+        double         layoutTime;
+
+        if (_layoutThread->checkAndClearIfLayoutIsComplete(layoutResults, layoutTime))
+        {
+            ODL_LOG("(_layoutThread->checkAndClearIfLayoutIsComplete(layoutResults, " //####
+                    "layoutTime))"); //####
+            _statistics->recordLayout(layoutTime);
+            for (LayoutNodeList::const_iterator walker(layoutResults.begin());
+                 layoutResults.end() != walker; ++walker)
+            {
+                if (walker->_movable)
+                {
+                    ChannelContainer * aContainer = _entitiesPanel->findKnownEntity(walker->_name);
+
+                    // Leave entities that have been moved since the layout was requested where
+                    // they are.
+                    if (aContainer && (aContainer->getPosition() == walker->_provisional.toInt()))
+                    {
+                        aContainer->setTopLeftPosition(static_cast<int>(walker->_position.x),
+                                                       static_cast<int>(walker->_position.y));
+                    }
+                }
+            }
+            _entitiesPanel->adjustSize(true);
+            requestPositionSave();
+        }
+        if (_layoutThread->getProgress(progress))
+        {
+            gg.setColour(kLayoutProgressColour);
+            gg.drawSingleLineText(progress, static_cast<int>(kSelectionOffset),
+                                  _menuBar->getBottom() +
+                                  static_cast<int>(gg.getCurrentFont().getHeight()));
+        }
+    }
     ODL_OBJEXIT(); //####
 } // ContentPanel::paint
 
@@ -624,6 +1306,117 @@ ContentPanel::perform(const InvocationInfo & info)
             wasProcessed = true;
             break;
 
+        case ManagerWindow::kCommandCacheEntityImages :
+            _entitiesPanel->setEntityImageCaching(! _entitiesPanel->entityImagesAreCached());
+            requestWindowRepaint();
+            wasProcessed = true;
+            break;
+
+        case ManagerWindow::kCommandZoomIn :
+            zoomAround(_entitiesPanel->getZoom() * kZoomStep, getLocalBounds().getCentre());
+            requestWindowRepaint();
+            wasProcessed = true;
+            break;
+
+        case ManagerWindow::kCommandZoomOut :
+            zoomAround(_entitiesPanel->getZoom() / kZoomStep, getLocalBounds().getCentre());
+            requestWindowRepaint();
+            wasProcessed = true;
+            break;
+
+        case ManagerWindow::kCommandZoomReset :
+            zoomAround(1, getLocalBounds().getCentre());
+            requestWindowRepaint();
+            wasProcessed = true;
+            break;
+
+        case ManagerWindow::kCommandUseNativeLayout :
+            if (_layoutThread)
+            {
+                _layoutThread->setNativeLayout(! _layoutThread->isUsingNativeLayout());
+            }
+            wasProcessed = true;
+            break;
+
+        case ManagerWindow::kCommandBenchmarkLayout :
+            if (_layoutThread)
+            {
+                _layoutThread->requestBenchmark();
+            }
+            wasProcessed = true;
+            break;
+
+        case ManagerWindow::kCommandCollapseHostGroups :
+            _entitiesPanel->setAllHostGroupsCollapsed(true);
+            requestWindowRepaint();
+            wasProcessed = true;
+            break;
+
+        case ManagerWindow::kCommandExpandHostGroups :
+            _entitiesPanel->setAllHostGroupsCollapsed(false);
+            requestWindowRepaint();
+            wasProcessed = true;
+            break;
+
+        case ManagerWindow::kCommandFindEntities :
+            _searchBox->grabKeyboardFocus();
+            _searchBox->selectAll();
+            wasProcessed = true;
+            break;
+
+        case ManagerWindow::kCommandFindNext :
+            showSearchMatch(true);
+            wasProcessed = true;
+            break;
+
+        case ManagerWindow::kCommandFindPrevious :
+            showSearchMatch(false);
+            wasProcessed = true;
+            break;
+
+        case ManagerWindow::kCommandShowStatistics :
+            _statistics->setShown(! _statistics->isVisible());
+            wasProcessed = true;
+            break;
+
+        case ManagerWindow::kCommandBenchmarkDrawing :
+            MouseCursor::showWaitCursor();
+            EntitiesPanel::performDrawingBenchmark();
+            MouseCursor::hideWaitCursor();
+            wasProcessed = true;
+            break;
+
+        case ManagerWindow::kCommandWeightByByteRate :
+            if (kTrafficWeightingBytes == _trafficWeighting)
+            {
+                _trafficWeighting = kTrafficWeightingNone;
+            }
+            else
+            {
+                _trafficWeighting = kTrafficWeightingBytes;
+            }
+            requestWindowRepaint();
+            wasProcessed = true;
+            break;
+
+        case ManagerWindow::kCommandWeightByMessageRate :
+            if (kTrafficWeightingMessages == _trafficWeighting)
+            {
+                _trafficWeighting = kTrafficWeightingNone;
+            }
+            else
+            {
+                _trafficWeighting = kTrafficWeightingMessages;
+            }
+            requestWindowRepaint();
+            wasProcessed = true;
+            break;
+
+        case ManagerWindow::kCommandShowAlerts :
+            showAlerts();
+            wasProcessed = true;
+            break;
+
         default :
             break;
 
@@ -632,12 +1425,195 @@ ContentPanel::perform(const InvocationInfo & info)
     return wasProcessed;
 } // ContentPanel::perform
 
+void
+ContentPanel::placeNewEntitiesLocally(Random & randomizer)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("randomizer = ", &randomizer); //####
+    float             offsetX = static_cast<float>(getX());
+    float             offsetY = static_cast<float>(getY());
+    float             maxX = static_cast<float>(getWidth());
+    float             maxY = static_cast<float>(getHeight());
+    ContainerIndexMap indices;
+    ContainerList     newEntities;
+    ContainerSet      nearby;
+    LayoutEdgeList    edges;
+    LayoutNodeList    nodes;
+
+    // Entities with known positions go back where they were; the others are laid out.
+    for (size_t ii = 0, mm = _entitiesPanel->getNumberOfEntities(); mm > ii; ++ii)
+    {
+        ChannelContainer * aContainer = _entitiesPanel->getEntity(ii);
+
+        if (aContainer && (aContainer->isNew() || aContainer->wasHidden()) &&
+            (! aContainer->isHiddenByGroup()))
+        {
+            ODL_LOG("(aContainer && (aContainer->isNew() || aContainer->wasHidden()) && " //####
+                    "(! aContainer->isHiddenByGroup()))"); //####
+            YarpString                  entityName(aContainer->getName().toStdString());
+            PositionMap::const_iterator match(_rememberedPositions.find(entityName));
+
+            if (_rememberedPositions.end() == match)
+            {
+                findOrAddLayoutNode(indices, nodes, aContainer, true);
+                newEntities.push_back(aContainer);
+            }
+            else
+            {
+                aContainer->setTopLeftPosition(static_cast<int>(match->second._position.x),
+                                               static_cast<int>(match->second._position.y));
+            }
+            if (! aContainer->isVisible())
+            {
+                aContainer->setVisible(true);
+                aContainer->clearHidden();
+            }
+        }
+    }
+    if (0 < newEntities.size())
+    {
+        std::vector<Position> neighbourTotals(newEntities.size());
+        std::vector<int>      neighbourCounts(newEntities.size(), 0);
+
+        // Add the connections of the new entities, along with the entities at their other ends,
+        // which are not moved. The new entities occupy the first positions in the layout.
+        for (ContainerList::const_iterator walker(newEntities.begin());
+             newEntities.end() != walker; ++walker)
+        {
+            ChannelContainer * aContainer = *walker;
+            size_t             thisIndex = indices[aContainer];
+            ContainerList      portOwners(aContainer->getGroupMembers());
+
+            // A host group is a single node, with the connections of all of its ports.
+            if (portOwners.empty())
+            {
+                portOwners.push_back(aContainer);
+            }
+            for (ContainerList::const_iterator it(portOwners.begin()); portOwners.end() != it;
+                 ++it)
+            {
+                ChannelContainer * anOwner = *it;
+
+                for (int jj = 0, nn = anOwner->getNumPorts(); nn > jj; ++jj)
+                {
+                    ChannelEntry * aChannel = anOwner->getPort(jj);
+
+                    if (aChannel)
+                    {
+                        const ChannelConnections & inputs = aChannel->getInputConnections();
+                        const ChannelConnections & outputs = aChannel->getOutputConnections();
+
+                        for (size_t kk = 0, ll = outputs.size(); ll > kk; ++kk)
+                        {
+                            ChannelEntry *     otherChannel = outputs[kk]._otherChannel;
+                            ChannelContainer * otherEntity = (otherChannel ?
+                                                              otherChannel->getParent() : NULL);
+                            ChannelContainer * otherEnd = (otherEntity ?
+                                                           otherEntity->getRepresentative() : NULL);
+
+                            if (otherEnd && (aContainer != otherEnd))
+                            {
+                                size_t otherIndex = findOrAddLayoutNode(indices, nodes, otherEnd,
+                                                                        false);
+
+                                edges.push_back(LayoutEdge(thisIndex, otherIndex));
+                            }
+                        }
+                        for (size_t kk = 0, ll = inputs.size(); ll > kk; ++kk)
+                        {
+                            ChannelEntry *     otherChannel = inputs[kk]._otherChannel;
+                            ChannelContainer * otherEntity = (otherChannel ?
+                                                              otherChannel->getParent() : NULL);
+                            ChannelContainer * otherEnd = (otherEntity ?
+                                                           otherEntity->getRepresentative() : NULL);
+
+                            if (otherEnd && (aContainer != otherEnd))
+                            {
+                                size_t otherIndex = findOrAddLayoutNode(indices, nodes, otherEnd,
+                                                                        false);
+
+                                // Connections between new entities are already recorded as
+                                // outputs.
+                                if (! nodes[otherIndex]._movable)
+                                {
+                                    edges.push_back(LayoutEdge(thisIndex, otherIndex));
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        for (LayoutEdgeList::const_iterator walker(edges.begin()); edges.end() != walker;
+             ++walker)
+        {
+            const LayoutNode & otherNode = nodes[walker->second];
+
+            if (! otherNode._movable)
+            {
+                neighbourTotals[walker->first] += otherNode._position +
+                                                  Position(otherNode._width / 2,
+                                                           otherNode._height / 2);
+                ++neighbourCounts[walker->first];
+            }
+        }
+        // Start each new entity near the entities that it is connected to, if there are any.
+        for (size_t ii = 0, mm = newEntities.size(); mm > ii; ++ii)
+        {
+            LayoutNode &         aNode = nodes[ii];
+            float                newX;
+            float                newY;
+            juce::Rectangle<int> area;
+
+            if (0 < neighbourCounts[ii])
+            {
+                Position centre(neighbourTotals[ii] / static_cast<float>(neighbourCounts[ii]));
+
+                newX = centre.getX() - (aNode._width / 2) +
+                       (kLocalPlacementSpread * ((2 * randomizer.nextFloat()) - 1));
+                newY = centre.getY() - (aNode._height / 2) +
+                       (kLocalPlacementSpread * ((2 * randomizer.nextFloat()) - 1));
+            }
+            else
+            {
+                newX = offsetX + (randomizer.nextFloat() * (maxX - aNode._width));
+                newY = offsetY + (randomizer.nextFloat() * (maxY - aNode._height));
+            }
+            aNode._position = Position(newX, newY);
+            area = juce::Rectangle<float>(newX, newY, aNode._width,
+                                          aNode._height).getSmallestIntegerContainer();
+            _entitiesPanel->findEntitiesInArea(area.expanded(kLocalNeighbourhood), nearby);
+        }
+        // Keep the new entities clear of the nearby entities, which are not moved.
+        for (ContainerSet::const_iterator walker(nearby.begin()); nearby.end() != walker;
+             ++walker)
+        {
+            ChannelContainer * aContainer = *walker;
+
+            if (aContainer && aContainer->isVisible())
+            {
+                findOrAddLayoutNode(indices, nodes, aContainer, false);
+            }
+        }
+        LayoutThread::relaxLocally(nodes, edges);
+        for (size_t ii = 0, mm = newEntities.size(); mm > ii; ++ii)
+        {
+            const LayoutNode & aNode = nodes[ii];
+
+            newEntities[ii]->setTopLeftPosition(static_cast<int>(aNode._position.getX()),
+                                                static_cast<int>(aNode._position.getY()));
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // ContentPanel::placeNewEntitiesLocally
+
 void
 ContentPanel::recallEntityPositions(void)
 {
     ODL_OBJENTER(); //####
     String filePath = getPathToSettingsFile();
     File   settingsFile(filePath);
+    int64  now = Time::currentTimeMillis();
 
     if (settingsFile.existsAsFile())
     {
@@ -654,14 +1630,26 @@ ContentPanel::recallEntityPositions(void)
                 StringArray asPieces;
 
                 asPieces.addTokens(aLine, "\t", "");
-                if (3 == asPieces.size())
+                // Files written before the time last seen was recorded have only three fields, so
+                // their entries are treated as having just been seen.
+                if ((3 == asPieces.size()) || (4 == asPieces.size()))
                 {
-                    String tag = asPieces[0];
-                    String xPosString = asPieces[1];
-                    String yPosString = asPieces[2];
-
-                    _rememberedPositions[tag.toStdString()] = Position(xPosString.getFloatValue(),
-                                                                       yPosString.getFloatValue());
+                    RememberedPosition where;
+                    String             tag = asPieces[0];
+                    String             xPosString = asPieces[1];
+                    String             yPosString = asPieces[2];
+
+                    where._position = Position(xPosString.getFloatValue(),
+                                               yPosString.getFloatValue());
+                    if (4 == asPieces.size())
+                    {
+                        where._lastSeen = asPieces[3].getLargeIntValue();
+                    }
+                    else
+                    {
+                        where._lastSeen = now;
+                    }
+                    _rememberedPositions[tag.toStdString()] = where;
                 }
             }
         }
@@ -669,17 +1657,120 @@ ContentPanel::recallEntityPositions(void)
     ODL_OBJEXIT(); //####
 } // ContentPanel::recallEntityPositions
 
+void
+ContentPanel::recallTopology(void)
+{
+    ODL_OBJENTER(); //####
+    File topologyFile(getPathToTopologyFile());
+
+    if (topologyFile.existsAsFile())
+    {
+        ODL_LOG("(topologyFile.existsAsFile())"); //####
+        StringArray stuffFromFile;
+
+        topologyFile.readLines(stuffFromFile);
+        if ((0 < stuffFromFile.size()) && (stuffFromFile[0] == kTopologyFileHeader))
+        {
+            EntitiesData snapshot;
+            EntityData * lastEntity = NULL;
+
+            for (int ii = 1, maxs = stuffFromFile.size(); maxs > ii; ++ii)
+            {
+                StringArray asPieces;
+
+                asPieces.addTokens(stuffFromFile[ii], "\t", "");
+                String tag = asPieces[0];
+
+                if ((tag == kTopologyEntityTag) && (8 == asPieces.size()))
+                {
+                    ContainerKind kind = static_cast<ContainerKind>(asPieces[1].getIntValue());
+
+                    lastEntity = new EntityData(kind, decodeTopologyField(asPieces[2]),
+                                                decodeTopologyField(asPieces[4]),
+                                                decodeTopologyField(asPieces[5]),
+                                                decodeTopologyField(asPieces[6]),
+                                                decodeTopologyField(asPieces[7]));
+                    lastEntity->setIPAddress(decodeTopologyField(asPieces[3]));
+                    snapshot.addEntity(lastEntity);
+                }
+                else if ((tag == kTopologyPortTag) && (7 == asPieces.size()) && lastEntity)
+                {
+                    PortUsage     usage = static_cast<PortUsage>(asPieces[5].getIntValue());
+                    PortDirection direction =
+                                        static_cast<PortDirection>(asPieces[6].getIntValue());
+                    PortData *    aPort = lastEntity->addPort(decodeTopologyField(asPieces[1]),
+                                                             decodeTopologyField(asPieces[3]),
+                                                             decodeTopologyField(asPieces[4]),
+                                                             usage, direction);
+
+                    if (aPort)
+                    {
+                        aPort->setPortNumber(decodeTopologyField(asPieces[2]));
+                    }
+                }
+                else if ((tag == kTopologyArgumentTag) && (2 == asPieces.size()) && lastEntity)
+                {
+                    YarpString                          argString =
+                                                            decodeTopologyField(asPieces[1]);
+                    Utilities::BaseArgumentDescriptor * argDesc =
+                                                    Utilities::ConvertStringToArgument(argString);
+
+                    if (argDesc)
+                    {
+                        // The entity keeps its own copy of the descriptor.
+                        lastEntity->addArgumentDescription(argDesc);
+                        delete argDesc;
+                    }
+                }
+                else if ((tag == kTopologyConnectionTag) && (4 == asPieces.size()))
+                {
+                    Common::ChannelMode mode =
+                                    static_cast<Common::ChannelMode>(asPieces[3].getIntValue());
+
+                    snapshot.addConnection(decodeTopologyField(asPieces[2]),
+                                           decodeTopologyField(asPieces[1]), mode);
+                }
+            }
+            if (0 < snapshot.getNumberOfEntities())
+            {
+                mergeScannedEntities(snapshot, true);
+                setEntityPositions();
+            }
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // ContentPanel::recallTopology
+
 void
 ContentPanel::rememberPositionOfEntity(ChannelContainer * anEntity)
 {
     ODL_OBJENTER(); //####
     ODL_P1("anEntity = ", anEntity); //####
-    YarpString entityName(anEntity->getName().toStdString());
+    YarpString           entityName(anEntity->getName().toStdString());
+    RememberedPosition & where = _rememberedPositions[entityName];
 
-    _rememberedPositions[entityName] = anEntity->getPositionInPanel();
+    where._position = anEntity->getPositionInPanel();
+    where._lastSeen = Time::currentTimeMillis();
     ODL_OBJEXIT(); //####
 } // ContentPanel::rememberPositionOfEntity
 
+void
+ContentPanel::removeScrollingMonitor(ScrollingMonitorWindow * aMonitor)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("aMonitor = ", aMonitor); //####
+    _monitors.removeObject(aMonitor);
+    ODL_OBJEXIT(); //####
+} // ContentPanel::removeScrollingMonitor
+
+void
+ContentPanel::requestPositionSave(void)
+{
+    ODL_OBJENTER(); //####
+    startTimer(kPositionSaveDelay);
+    ODL_OBJEXIT(); //####
+} // ContentPanel::requestPositionSave
+
 void
 ContentPanel::requestWindowRepaint(void)
 {
@@ -695,8 +1786,13 @@ ContentPanel::resized(void)
     juce::Rectangle<int> area(getLocalBounds());
     int                  offset = LookAndFeel::getDefaultLookAndFeel().getDefaultMenuBarHeight();
 
-    _menuBar->setBounds(area.removeFromTop(offset));
+    juce::Rectangle<int> topRow(area.removeFromTop(offset));
+
+    _searchBox->setBounds(topRow.removeFromRight(kSearchBoxWidth));
+    _menuBar->setBounds(topRow);
     _entitiesPanel->setBounds(area);
+    _statistics->setTopLeftPosition(area.getRight() - (_statistics->getWidth() +
+                                                       getScrollBarThickness()), area.getY());
     ODL_OBJEXIT(); //####
 } // ContentPanel::resized
 
@@ -704,29 +1800,130 @@ void
 ContentPanel::saveEntityPositions(void)
 {
     ODL_OBJENTER(); //####
-    String filePath = getPathToSettingsFile();
-    File   settingsFile(filePath);
+    int64             oldestAllowed = Time::currentTimeMillis() - _positionAgeLimit;
+    std::stringstream buff;
 
-    if (settingsFile.create().wasOk())
+    for (PositionMap::iterator walker(_rememberedPositions.begin());
+         _rememberedPositions.end() != walker; )
     {
-        ODL_LOG("(settingsFile.create().wasOk())"); //####
-        // Make sure that the file is empty before adding lines to it!
-        settingsFile.replaceWithText("");
-        for (PositionMap::const_iterator walker(_rememberedPositions.begin());
-             _rememberedPositions.end() != walker; ++walker)
-        {
-            std::stringstream buff;
-            YarpString        tag = walker->first;
-            Position          where = walker->second;
+        const RememberedPosition & where = walker->second;
 
-            buff << "\t" << where.x << "\t" << where.y << std::endl;
-            settingsFile.appendText(tag.c_str());
-            settingsFile.appendText(buff.str());
+        if (oldestAllowed > where._lastSeen)
+        {
+            _rememberedPositions.erase(walker++);
+        }
+        else
+        {
+            buff << walker->first << "\t" << where._position.x << "\t" << where._position.y <<
+                    "\t" << where._lastSeen << std::endl;
+            ++walker;
         }
     }
+    replaceSettingsFile(getPathToSettingsFile(), buff.str());
     ODL_OBJEXIT(); //####
 } // ContentPanel::saveEntityPositions
 
+void
+ContentPanel::saveTopology(void)
+{
+    ODL_OBJENTER(); //####
+    std::stringstream buff;
+    std::stringstream connectionBuff;
+    bool              sawEntity = false;
+
+    buff << kTopologyFileHeader << std::endl;
+    for (size_t ii = 0, mm = _entitiesPanel->getNumberOfEntities(); mm > ii; ++ii)
+    {
+        ChannelContainer * anEntity = _entitiesPanel->getEntity(ii);
+
+        // The stand-ins for hosts are recreated from the standalone ports that they group.
+        if (anEntity && (kContainerKindHost != anEntity->getKind()))
+        {
+            sawEntity = true;
+            buff << kTopologyEntityTag << "\t" << static_cast<int>(anEntity->getKind()) << "\t" <<
+                    encodeTopologyField(anEntity->getName().toStdString()) << "\t" <<
+                    encodeTopologyField(anEntity->getIPAddress()) << "\t" <<
+                    encodeTopologyField(anEntity->getBehaviour()) << "\t" <<
+                    encodeTopologyField(anEntity->getDescription()) << "\t" <<
+                    encodeTopologyField(anEntity->getExtraInformation()) << "\t" <<
+                    encodeTopologyField(anEntity->getRequests()) << std::endl;
+            for (int jj = 0, nn = anEntity->getNumPorts(); nn > jj; ++jj)
+            {
+                ChannelEntry * aPort = anEntity->getPort(jj);
+
+                if (aPort)
+                {
+                    const ChannelConnections & outputs = aPort->getOutputConnections();
+
+                    buff << kTopologyPortTag << "\t" <<
+                            encodeTopologyField(aPort->getPortName()) << "\t" <<
+                            encodeTopologyField(aPort->getPortNumber()) << "\t" <<
+                            encodeTopologyField(aPort->getProtocol()) << "\t" <<
+                            encodeTopologyField(aPort->getProtocolDescription()) << "\t" <<
+                            static_cast<int>(aPort->getUsage()) << "\t" <<
+                            static_cast<int>(aPort->getDirection()) << std::endl;
+                    for (ChannelConnections::const_iterator walker(outputs.begin());
+                         outputs.end() != walker; ++walker)
+                    {
+                        if (walker->_valid && walker->_otherChannel)
+                        {
+                            ChannelEntry * otherPort = walker->_otherChannel;
+
+                            connectionBuff << kTopologyConnectionTag << "\t" <<
+                                        encodeTopologyField(aPort->getPortName()) << "\t" <<
+                                        encodeTopologyField(otherPort->getPortName()) << "\t" <<
+                                        static_cast<int>(walker->_connectionMode) << std::endl;
+                        }
+                    }
+                }
+            }
+            for (size_t jj = 0, nn = anEntity->getNumArgumentDescriptors(); nn > jj; ++jj)
+            {
+                Utilities::BaseArgumentDescriptor * argDesc = anEntity->getArgumentDescriptor(jj);
+
+                if (argDesc)
+                {
+                    buff << kTopologyArgumentTag << "\t" <<
+                            encodeTopologyField(argDesc->toString()) << std::endl;
+                }
+            }
+        }
+    }
+    // An empty panel says nothing about the network, so keep what was last seen.
+    if (sawEntity)
+    {
+        buff << connectionBuff.str();
+        replaceSettingsFile(getPathToTopologyFile(), buff.str());
+    }
+    ODL_OBJEXIT(); //####
+} // ContentPanel::saveTopology
+
+void
+ContentPanel::setActivityMarkers(const ActivityStateMap & changes)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("changes = ", &changes); //####
+    for (ActivityStateMap::const_iterator walker(changes.begin()); changes.end() != walker;
+         ++walker)
+    {
+        ChannelEntry * aPort = _entitiesPanel->findKnownPort(walker->first);
+
+        if (aPort)
+        {
+            if (aPort->isBeingMonitored())
+            {
+                aPort->setActivityMarker(walker->second);
+            }
+        }
+        else
+        {
+            // The port has gone away, so there's no point in continuing to monitor it.
+            _activityThread->requestMonitoring(walker->first, false);
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // ContentPanel::setActivityMarkers
+
 void
 ContentPanel::setChannelOfInterest(ChannelEntry * aChannel)
 {
@@ -770,194 +1967,134 @@ ContentPanel::setEntityPositions(void)
     float         maxX = static_cast<float>(getWidth());
     float         maxY = static_cast<float>(getHeight());
     Random        randomizer(Time::currentTimeMillis());
-#if defined(USE_OGDF_POSITIONING_)
-    ogdf::Graph * gg;
-#endif // defined(USE_OGDF_POSITIONING_)
-
-#if defined(USE_OGDF_POSITIONING_)
-# if defined(USE_OGDF_FOR_FIRST_POSITIONING_ONLY_)
-    if (_initialPositioningDone)
+    bool          doFullLayout;
+    bool          doLocalLayout;
+
+#if (defined(USE_OGDF_POSITIONING_) || defined(USE_NATIVE_POSITIONING_))
+# if (defined(USE_OGDF_FOR_FIRST_POSITIONING_ONLY_) || defined(USE_LOCAL_POSITIONING_))
+    doFullLayout = (! _initialPositioningDone);
+# else // ! (defined(USE_OGDF_FOR_FIRST_POSITIONING_ONLY_) || defined(USE_LOCAL_POSITIONING_))
+    doFullLayout = true;
+# endif // ! (defined(USE_OGDF_FOR_FIRST_POSITIONING_ONLY_) || defined(USE_LOCAL_POSITIONING_))
+#else // ! (defined(USE_OGDF_POSITIONING_) || defined(USE_NATIVE_POSITIONING_))
+    doFullLayout = false;
+#endif // ! (defined(USE_OGDF_POSITIONING_) || defined(USE_NATIVE_POSITIONING_))
+#if defined(USE_LOCAL_POSITIONING_)
+    doLocalLayout = _initialPositioningDone;
+#else // ! defined(USE_LOCAL_POSITIONING_)
+    doLocalLayout = false;
+#endif // ! defined(USE_LOCAL_POSITIONING_)
+    _initialPositioningDone = true;
+    if (doFullLayout && _layoutThread)
     {
-        gg = NULL;
-    }
-    else
-    {
-        _initialPositioningDone = true;
-        gg = new ogdf::Graph;
-    }
-# else // ! defined(USE_OGDF_FOR_FIRST_POSITIONING_ONLY_)
-    gg = new ogdf::Graph;
-# endif // ! defined(USE_OGDF_FOR_FIRST_POSITIONING_ONLY_)
-    if (gg)
-    {
-        ScopedPointer<ogdf::GraphAttributes> ga(new ogdf::GraphAttributes(*gg));
+        bool              positionsNeedUpdate = false;
+        ContainerIndexMap indices;
+        LayoutEdgeList    edges;
+        LayoutNodeList    nodes;
 
-        if (ga)
+        // Give each entity a provisional position immediately, so that the display is usable
+        // while the layout is being calculated in the background.
+        for (size_t ii = 0, mm = _entitiesPanel->getNumberOfEntities(); mm > ii; ++ii)
         {
-            bool       positionsNeedUpdate = false;
-            ogdf::node phantomNode = gg->newNode();
-
-            ga->setDirected(true);
-            // If nodes are not connected, OGDF will pile them all at the origin; by adding a
-            // 'phantom' node that is connected to every other node, we force OGDF to spread the
-            // nodes out.
-            ga->width(phantomNode) = 1;
-            ga->height(phantomNode) = 1;
-            ga->x(phantomNode) = offsetX + (randomizer.nextFloat() * maxX);
-            ga->y(phantomNode) = offsetY + (randomizer.nextFloat() * maxY);
-            _entitiesPanel->clearNodeValues();
-            for (size_t ii = 0, mm = _entitiesPanel->getNumberOfEntities(); mm > ii; ++ii)
-            {
-                ChannelContainer * aContainer = _entitiesPanel->getEntity(ii);
+            ChannelContainer * aContainer = _entitiesPanel->getEntity(ii);
 
-                if (aContainer)
+            // The ports of a collapsed host group are laid out as part of the group.
+            if (aContainer && (! aContainer->isHiddenByGroup()))
+            {
+                LayoutNode             aNode;
+                juce::Rectangle<float> entityShape(aContainer->getLocalBounds().toFloat());
+                float                  hh = entityShape.getHeight();
+                float                  ww = entityShape.getWidth();
+
+                aNode._name = aContainer->getName().toStdString();
+                aNode._height = hh;
+                aNode._width = ww;
+                aNode._movable = false;
+                if (aContainer->isNew() || aContainer->wasHidden())
                 {
-                    float                  newX;
-                    float                  newY;
-                    juce::Rectangle<float> entityShape(aContainer->getLocalBounds().toFloat());
-                    ogdf::node             aNode = gg->newNode();
-                    float                  hh = entityShape.getHeight();
-                    float                  ww = entityShape.getWidth();
-
-                    ga->width(aNode) = ww;
-                    ga->height(aNode) = hh;
-                    aContainer->setNode(aNode);
-                    if (aContainer->isNew() || aContainer->wasHidden())
-                    {
-                        ODL_LOG("(aContainer->isNew() || aContainer->wasHidden())"); //####
-                        // Check if the position was already known.
-                        YarpString                  entityName(aContainer->getName().toStdString());
-                        PositionMap::const_iterator match(_rememberedPositions.find(entityName));
+                    ODL_LOG("(aContainer->isNew() || aContainer->wasHidden())"); //####
+                    // Check if the position was already known.
+                    float                       newX;
+                    float                       newY;
+                    PositionMap::const_iterator match(_rememberedPositions.find(aNode._name));
 
-                        if (_rememberedPositions.end() == match)
-                        {
-                            newX = offsetX + (randomizer.nextFloat() * (maxX - ww));
-                            newY = offsetY + (randomizer.nextFloat() * (maxY - hh));
-                            positionsNeedUpdate = true;
-                        }
-                        else
-                        {
-                            newX = match->second.x;
-                            newY = match->second.y;
-                        }
-                        aContainer->setTopLeftPosition(static_cast<int>(newX),
-                                                       static_cast<int>(newY));
+                    if (_rememberedPositions.end() == match)
+                    {
+                        newX = offsetX + (randomizer.nextFloat() * (maxX - ww));
+                        newY = offsetY + (randomizer.nextFloat() * (maxY - hh));
+                        aNode._movable = positionsNeedUpdate = true;
                     }
                     else
                     {
-                        newX = entityShape.getX();
-                        newY = entityShape.getY();
+                        newX = match->second._position.x;
+                        newY = match->second._position.y;
                     }
-                    ga->x(aNode) = newX;
-                    ga->y(aNode) = newY;
+                    aContainer->setTopLeftPosition(static_cast<int>(newX), static_cast<int>(newY));
                 }
+                // Record the position that was actually used, so that an entity that is moved
+                // before the layout completes can be recognized.
+                aNode._position = aNode._provisional = aContainer->getPosition().toFloat();
+                indices[aContainer] = nodes.size();
+                nodes.push_back(aNode);
             }
-            if (positionsNeedUpdate)
+        }
+        if (positionsNeedUpdate)
+        {
+            ODL_LOG("(positionsNeedUpdate)"); //####
+            // Set up the edges (connections), using the host group in place of each of the ports
+            // in a collapsed group.
+            for (size_t ii = 0, mm = _entitiesPanel->getNumberOfEntities(); mm > ii; ++ii)
             {
-                ODL_LOG("(positionsNeedUpdate)"); //####
-                // Set up the edges (connections).
-                for (size_t ii = 0, mm = _entitiesPanel->getNumberOfEntities(); mm > ii; ++ii)
+                ChannelContainer * aContainer = _entitiesPanel->getEntity(ii);
+
+                if (aContainer)
                 {
-                    ChannelContainer * aContainer = _entitiesPanel->getEntity(ii);
+                    ChannelContainer *                thisEnd = aContainer->getRepresentative();
+                    ContainerIndexMap::const_iterator thisMatch(indices.find(thisEnd));
 
-                    if (aContainer)
+                    for (int jj = 0, nn = aContainer->getNumPorts();
+                         (indices.end() != thisMatch) && (nn > jj); ++jj)
                     {
-                        ogdf::node thisNode = aContainer->getNode();
+                        ChannelEntry * aChannel = aContainer->getPort(jj);
 
-                        if (thisNode)
+                        if (aChannel)
                         {
-                            bool wasConnected = false;
+                            const ChannelConnections & outputs = aChannel->getOutputConnections();
 
-                            // Add edges between entities that are connected via their entries.
-                            for (int jj = 0, nn = aContainer->getNumPorts(); nn > jj; ++jj)
+                            for (size_t kk = 0, ll = outputs.size(); ll > kk; ++kk)
                             {
-                                ChannelEntry * aChannel = aContainer->getPort(jj);
+                                ChannelEntry *     otherChannel = outputs[kk]._otherChannel;
+                                ChannelContainer * otherEntity = (otherChannel ?
+                                                                  otherChannel->getParent() : NULL);
 
-                                if (aChannel)
+                                if (otherEntity)
                                 {
-                                    const ChannelConnections & outputs =
-                                    aChannel->getOutputConnections();
-
-                                    for (size_t kk = 0, ll = outputs.size(); ll > kk; ++kk)
-                                    {
-                                        ChannelEntry * otherChannel = outputs[kk]._otherChannel;
-
-                                        if (otherChannel)
-                                        {
-                                            ChannelContainer * otherEntity =
-                                                                        otherChannel->getParent();
-
-                                            if (otherEntity)
-                                            {
-                                                ogdf::node otherNode = otherEntity->getNode();
-
-                                                if (otherNode && (thisNode != otherNode))
-                                                {
-                                                    /*ogdf::edge ee =*/ gg->newEdge(thisNode,
-                                                                                    otherNode);
-
-                                                    wasConnected = true;
-                                                }
-                                            }
-                                        }
-                                    }
-                                    const ChannelConnections & inputs =
-                                    aChannel->getInputConnections();
+                                    ChannelContainer *                otherEnd =
+                                                                otherEntity->getRepresentative();
+                                    ContainerIndexMap::const_iterator match(indices.find(otherEnd));
 
-                                    if (0 < inputs.size())
+                                    if ((indices.end() != match) && (thisMatch != match))
                                     {
-                                        wasConnected = true;
+                                        edges.push_back(LayoutEdge(thisMatch->second,
+                                                                   match->second));
                                     }
                                 }
                             }
-                            if (! wasConnected)
-                            {
-                                /*ogdf::edge phantomNodeToThis =*/ gg->newEdge(phantomNode,
-                                                                               thisNode);
-
-                            }
-                        }
-                    }
-                }
-                // Apply an energy-based layout.
-                ScopedPointer<ogdf::FMMMLayout> fmmm(new ogdf::FMMMLayout);
-
-                if (fmmm)
-                {
-                    fmmm->useHighLevelOptions(true);
-                    fmmm->newInitialPlacement(false); //true);
-                    fmmm->qualityVersusSpeed(ogdf::FMMMLayout::qvsGorgeousAndEfficient);
-                    fmmm->allowedPositions(ogdf::FMMMLayout::apAll);
-                    fmmm->initialPlacementMult(ogdf::FMMMLayout::ipmAdvanced);
-                    fmmm->initialPlacementForces(ogdf::FMMMLayout::ipfKeepPositions);
-                    fmmm->repForcesStrength(2);
-                    fmmm->call(*ga);
-                    for (size_t ii = 0, mm = _entitiesPanel->getNumberOfEntities(); mm > ii; ++ii)
-                    {
-                        ChannelContainer * aContainer = _entitiesPanel->getEntity(ii);
-
-                        if (aContainer && (aContainer->isNew() || aContainer->wasHidden()))
-                        {
-                            ogdf::node aNode = aContainer->getNode();
-
-                            if (aNode)
-                            {
-                                // Check if the position was already known.
-                                YarpString entityName(aContainer->getName().toStdString());
-
-                                if (_rememberedPositions.end() ==
-                                    _rememberedPositions.find(entityName))
-                                {
-                                    aContainer->setTopLeftPosition(static_cast<int>(ga->x(aNode)),
-                                                                   static_cast<int>(ga->y(aNode)));
-                                }
-                            }
                         }
                     }
                 }
             }
+            _layoutThread->requestLayout(nodes, edges,
+                                         Position(offsetX + (randomizer.nextFloat() * maxX),
+                                                  offsetY + (randomizer.nextFloat() * maxY)));
         }
-        delete gg;
+    }
+    else if (doLocalLayout)
+    {
+        double startTime = Time::getMillisecondCounterHiRes();
+
+        placeNewEntitiesLocally(randomizer);
+        _statistics->recordLayout(Time::getMillisecondCounterHiRes() - startTime);
     }
     else
     {
@@ -965,9 +2102,11 @@ ContentPanel::setEntityPositions(void)
         {
             ChannelContainer * aContainer = _entitiesPanel->getEntity(ii);
 
-            if (aContainer && (aContainer->isNew() || aContainer->wasHidden()))
+            if (aContainer && (aContainer->isNew() || aContainer->wasHidden()) &&
+                (! aContainer->isHiddenByGroup()))
             {
-                ODL_LOG("(aContainer && (aContainer->isNew() || aContainer->wasHidden()))"); //####
+                ODL_LOG("(aContainer && (aContainer->isNew() || aContainer->wasHidden()) && " //####
+                        "(! aContainer->isHiddenByGroup()))"); //####
                 float                       newX;
                 float                       newY;
                 juce::Rectangle<float>      entityShape(aContainer->getLocalBounds().toFloat());
@@ -983,8 +2122,8 @@ ContentPanel::setEntityPositions(void)
                 }
                 else
                 {
-                    newX = match->second.x;
-                    newY = match->second.y;
+                    newX = match->second._position.x;
+                    newY = match->second._position.y;
                 }
                 aContainer->setTopLeftPosition(static_cast<int>(newX), static_cast<int>(newY));
                 if (! aContainer->isVisible())
@@ -995,41 +2134,6 @@ ContentPanel::setEntityPositions(void)
             }
         }
     }
-#else // ! defined(USE_OGDF_POSITIONING_)
-    for (size_t ii = 0, mm = _entitiesPanel->getNumberOfEntities(); mm > ii; ++ii)
-    {
-        ChannelContainer * aContainer = _entitiesPanel->getEntity(ii);
-
-        if (aContainer && (aContainer->isNew() || aContainer->wasHidden()))
-        {
-            ODL_LOG("(aContainer && (aContainer->isNew() || aContainer->wasHidden()))"); //####
-            float                       newX;
-            float                       newY;
-            juce::Rectangle<float>      entityShape(aContainer->getLocalBounds().toFloat());
-            float                       hh = entityShape.getHeight();
-            float                       ww = entityShape.getWidth();
-            YarpString                  entityName(aContainer->getName().toStdString());
-            PositionMap::const_iterator match(_rememberedPositions.find(entityName));
-
-            if (_rememberedPositions.end() == match)
-            {
-                newX = offsetX + (randomizer.nextFloat() * (maxX - ww));
-                newY = offsetY + (randomizer.nextFloat() * (maxY - hh));
-            }
-            else
-            {
-                newX = match->second.x;
-                newY = match->second.y;
-            }
-            aContainer->setTopLeftPosition(static_cast<int>(newX), static_cast<int>(newY));
-            if (! aContainer->isVisible())
-            {
-                aContainer->setVisible(true);
-                aContainer->clearHidden();
-            }
-        }
-    }
-#endif // ! defined(USE_OGDF_POSITIONING_)
     ODL_OBJEXIT(); //####
 } // ContentPanel::setEntityPositions
 
@@ -1060,8 +2164,9 @@ ContentPanel::setUpChannelMenu(PopupMenu &    aMenu,
         (kPortUsageClient != aChannel.getUsage()))
     {
         aMenu.addSeparator();
-        aMenu.addItem(kPopupAddSimpleMonitor, "Enable activity indicator", false);
-        aMenu.addItem(kPopupAddScrollingMonitor, "Add scrolling monitor", false);
+        aMenu.addItem(kPopupAddSimpleMonitor, "Enable activity indicator", true,
+                      aChannel.isBeingMonitored());
+        aMenu.addItem(kPopupAddScrollingMonitor, "Add scrolling monitor");
     }
     ODL_OBJEXIT(); //####
 } // ContentPanel::setUpChannelMenu
@@ -1089,6 +2194,11 @@ ContentPanel::setUpContainerMenu(PopupMenu &        aMenu,
             serviceLike = true;
             break;
 
+        case kContainerKindHost :
+            kindOfContainer = "host";
+            serviceLike = false;
+            break;
+
         default :
             kindOfContainer = "entity";
             serviceLike = false;
@@ -1110,6 +2220,14 @@ ContentPanel::setUpContainerMenu(PopupMenu &        aMenu,
                       " metrics", metricsEnabled);
     }
     aMenu.addItem(kPopupHideEntity, String("Hide the ") + kindOfContainer);
+    if (kContainerKindHost == aContainer.getKind())
+    {
+        aMenu.addItem(kPopupExpandHostGroup, "Show the ports of the host separately");
+    }
+    else if (aContainer.getHostGroup())
+    {
+        aMenu.addItem(kPopupCollapseHostGroup, "Show the ports of the host as a single entity");
+    }
     if (serviceLike)
     {
         switch (Utilities::MapStringToServiceKind(aContainer.getBehaviour()))
@@ -1161,9 +2279,90 @@ ContentPanel::setUpViewMenu(PopupMenu & aMenu)
     aMenu.addSeparator();
     aMenu.addCommandItem(commandManager, ManagerWindow::kCommandClearSelection);
     aMenu.addCommandItem(commandManager, ManagerWindow::kCommandUnhideEntities);
+    aMenu.addSeparator();
+    aMenu.addCommandItem(commandManager, ManagerWindow::kCommandCollapseHostGroups);
+    aMenu.addCommandItem(commandManager, ManagerWindow::kCommandExpandHostGroups);
+    aMenu.addSeparator();
+    aMenu.addCommandItem(commandManager, ManagerWindow::kCommandFindEntities);
+    aMenu.addCommandItem(commandManager, ManagerWindow::kCommandFindNext);
+    aMenu.addCommandItem(commandManager, ManagerWindow::kCommandFindPrevious);
+    aMenu.addSeparator();
+    aMenu.addCommandItem(commandManager, ManagerWindow::kCommandZoomIn);
+    aMenu.addCommandItem(commandManager, ManagerWindow::kCommandZoomOut);
+    aMenu.addCommandItem(commandManager, ManagerWindow::kCommandZoomReset);
+    aMenu.addSeparator();
+    aMenu.addCommandItem(commandManager, ManagerWindow::kCommandCacheEntityImages);
+    aMenu.addCommandItem(commandManager, ManagerWindow::kCommandShowStatistics);
+    aMenu.addSeparator();
+    aMenu.addCommandItem(commandManager, ManagerWindow::kCommandWeightByByteRate);
+    aMenu.addCommandItem(commandManager, ManagerWindow::kCommandWeightByMessageRate);
+    aMenu.addCommandItem(commandManager, ManagerWindow::kCommandShowAlerts);
+    aMenu.addSeparator();
+    aMenu.addCommandItem(commandManager, ManagerWindow::kCommandUseNativeLayout);
+    aMenu.addCommandItem(commandManager, ManagerWindow::kCommandBenchmarkLayout);
+    aMenu.addCommandItem(commandManager, ManagerWindow::kCommandBenchmarkDrawing);
     ODL_OBJEXIT(); //####
 } // ContentPanel::setUpViewMenu
 
+void
+ContentPanel::showAlerts(void)
+{
+    ODL_OBJENTER(); //####
+    String bodyText;
+
+    for (MetricsAlertList::const_iterator walker(_alerts.begin()); _alerts.end() != walker;
+         ++walker)
+    {
+        if (bodyText.isNotEmpty())
+        {
+            bodyText += "\n";
+        }
+        // A service that isn't collecting metrics has no channel or rate to show.
+        if (! walker->_channelName.empty())
+        {
+            bodyText += String("Channel:      ") + walker->_channelName.c_str() + "\n";
+        }
+        bodyText += String("Service:      ") + walker->_servicePortName.c_str() + "\n";
+        bodyText += String("Rule:         ") + walker->_ruleText.c_str() + "\n";
+        if (! walker->_channelName.empty())
+        {
+            bodyText += "Current rate: " + String(walker->_value, 1) + "\n";
+        }
+        bodyText += "Since:        " + Time(walker->_since).formatted("%Y-%m-%d %H:%M:%S") + "\n";
+    }
+    if (bodyText.isEmpty())
+    {
+        bodyText = "No alerts have been raised.\n";
+    }
+    DisplayInformationPanel(this, bodyText, "Metrics alerts");
+    ODL_OBJEXIT(); //####
+} // ContentPanel::showAlerts
+
+void
+ContentPanel::showSearchMatch(const bool forward)
+{
+    ODL_OBJENTER(); //####
+    ODL_B1("forward = ", forward); //####
+    ChannelContainer * aMatch = _entitiesPanel->findNextSearchMatch(_selectedContainer, forward);
+
+    if (aMatch)
+    {
+        // The entities are scaled in place, so their bounds are unscaled.
+        Position   scaledCentre(aMatch->getBounds().getCentre().toFloat() *
+                                _entitiesPanel->getZoom());
+        Point<int> centre(scaledCentre.roundToInt());
+
+        _selectedChannel = NULL;
+        _selectedContainer = aMatch;
+        ODL_P2("_selectedChannel <- ", _selectedChannel, "_selectedContainer <- ", //####
+               _selectedContainer); //####
+        setViewPosition(centre.getX() - (getViewWidth() / 2),
+                        centre.getY() - (getViewHeight() / 2));
+        requestWindowRepaint();
+    }
+    ODL_OBJEXIT(); //####
+} // ContentPanel::showSearchMatch
+
 void
 ContentPanel::skipScan(void)
 {
@@ -1172,132 +2371,206 @@ ContentPanel::skipScan(void)
     ODL_OBJEXIT(); //####
 } // ContentPanel::skipScan
 
+#if (! MAC_OR_LINUX_)
+# pragma warning(push)
+# pragma warning(disable: 4100)
+#endif // ! MAC_OR_LINUX_
 void
-ContentPanel::updatePanels(ScannerThread & scanner)
+ContentPanel::textEditorEscapeKeyPressed(TextEditor & editor)
 {
+#if (! defined(ODL_ENABLE_LOGGING_))
+# if MAC_OR_LINUX_
+#  pragma unused(editor)
+# endif // MAC_OR_LINUX_
+#endif // ! defined(ODL_ENABLE_LOGGING_)
     ODL_OBJENTER(); //####
-    ODL_P1("scanner = ", &scanner); //####
-    bool                 changeSeen = false;
-    const EntitiesData & workingData(scanner.getEntitiesData());
-
-    // Retrieve each entity from our new list; if it is known already, ignore it but mark the
-    // old entity as known.
-    _entitiesPanel->clearAllVisitedFlags();
-    _entitiesPanel->clearAllNewlyCreatedFlags();
-    _entitiesPanel->invalidateAllConnections();
-    for (size_t ii = 0, mm = workingData.getNumberOfEntities(); mm > ii; ++ii)
-    {
-        EntityData * anEntity = workingData.getEntity(ii);
+    ODL_P1("editor = ", &editor); //####
+    // Clearing the text ends the search.
+    _searchBox->setText(String());
+    ODL_OBJEXIT(); //####
+} // ContentPanel::textEditorEscapeKeyPressed
+#if (! MAC_OR_LINUX_)
+# pragma warning(pop)
+#endif // ! MAC_OR_LINUX_
 
-        ODL_P1("anEntity <- ", anEntity); //####
-        if (anEntity)
-        {
-            ODL_S1s("anEntity->getName() = ", anEntity->getName()); //####
-            ChannelContainer * oldContainer = _entitiesPanel->findKnownEntity(anEntity->getName());
+#if (! MAC_OR_LINUX_)
+# pragma warning(push)
+# pragma warning(disable: 4100)
+#endif // ! MAC_OR_LINUX_
+void
+ContentPanel::textEditorReturnKeyPressed(TextEditor & editor)
+{
+#if (! defined(ODL_ENABLE_LOGGING_))
+# if MAC_OR_LINUX_
+#  pragma unused(editor)
+# endif // MAC_OR_LINUX_
+#endif // ! defined(ODL_ENABLE_LOGGING_)
+    ODL_OBJENTER(); //####
+    ODL_P1("editor = ", &editor); //####
+    showSearchMatch(! ModifierKeys::getCurrentModifiers().isShiftDown());
+    ODL_OBJEXIT(); //####
+} // ContentPanel::textEditorReturnKeyPressed
+#if (! MAC_OR_LINUX_)
+# pragma warning(pop)
+#endif // ! MAC_OR_LINUX_
 
-            if (oldContainer)
-            {
-                ODL_LOG("(oldContainer)"); //####
-                oldContainer->setVisited();
-            }
-            else
-            {
-                // Make a copy of the newly discovered entity, and add it to the active panel.
-                ChannelContainer * newContainer = new ChannelContainer(anEntity->getKind(),
-                                                                       anEntity->getName(),
-                                                                       anEntity->getIPAddress(),
-                                                                       anEntity->getBehaviour(),
-                                                                       anEntity->getDescription(),
-                                                                   anEntity->getExtraInformation(),
-                                                                       anEntity->getRequests(),
-                                                                       *_entitiesPanel);
+#if (! MAC_OR_LINUX_)
+# pragma warning(push)
+# pragma warning(disable: 4100)
+#endif // ! MAC_OR_LINUX_
+void
+ContentPanel::textEditorTextChanged(TextEditor & editor)
+{
+#if (! defined(ODL_ENABLE_LOGGING_))
+# if MAC_OR_LINUX_
+#  pragma unused(editor)
+# endif // MAC_OR_LINUX_
+#endif // ! defined(ODL_ENABLE_LOGGING_)
+    ODL_OBJENTER(); //####
+    ODL_P1("editor = ", &editor); //####
+    _entitiesPanel->setSearchText(_searchBox->getText());
+    ODL_OBJEXIT(); //####
+} // ContentPanel::textEditorTextChanged
+#if (! MAC_OR_LINUX_)
+# pragma warning(pop)
+#endif // ! MAC_OR_LINUX_
 
-                newContainer->setVisited();
-                // Make copies of the ports of the entity, and add them to the new entity.
-                for (int jj = 0, nn = anEntity->getNumPorts(); nn > jj; ++jj)
-                {
-                    PortData * aPort = anEntity->getPort(jj);
+void
+ContentPanel::timerCallback(void)
+{
+    ODL_OBJENTER(); //####
+    stopTimer();
+    _entitiesPanel->rememberPositions();
+    saveTopology();
+    ODL_OBJEXIT(); //####
+} // ContentPanel::timerCallback
 
-                    if (aPort)
-                    {
-                        ChannelEntry * newPort = newContainer->addPort(aPort->getPortName(),
-                                                                       aPort->getPortNumber(),
-                                                                       aPort->getProtocol(),
-                                                                   aPort->getProtocolDescription(),
-                                                                       aPort->getUsage(),
-                                                                       aPort->getDirection());
-
-                        _entitiesPanel->rememberPort(newPort);
-                    }
-                }
-                for (size_t jj = 0, nn = anEntity->getNumArgumentDescriptors(); nn > jj; ++jj)
-                {
-                    Utilities::BaseArgumentDescriptor * argDesc =
-                                                                anEntity->getArgumentDescriptor(jj);
+void
+ContentPanel::toggleActivityIndicator(ChannelEntry & aChannel)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("aChannel = ", &aChannel); //####
+    bool monitor = (! aChannel.isBeingMonitored());
 
-                    if (argDesc)
-                    {
-                        newContainer->addArgumentDescription(argDesc);
-                    }
-                }
-                _entitiesPanel->addEntity(newContainer);
-                changeSeen = true;
-            }
-        }
+    aChannel.setBeingMonitored(monitor);
+    // The thread is stopped before the entities are removed when the panel goes away.
+    if (_activityThread)
+    {
+        _activityThread->requestMonitoring(aChannel.getPortName(), monitor);
     }
-    // Convert the detected connections into visible connections.
-    const ConnectionList & connections(workingData.getConnections());
+    ODL_OBJEXIT(); //####
+} // ContentPanel::toggleActivityIndicator
 
-    for (ConnectionList::const_iterator walker(connections.begin()); connections.end() != walker;
+void
+ContentPanel::updateAlerts(const MetricsAlertList & alerts)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("alerts = ", &alerts); //####
+    PortSet alertingServices;
+
+    _alerts = alerts;
+    for (MetricsAlertList::const_iterator walker(_alerts.begin()); _alerts.end() != walker;
          ++walker)
     {
-        ChannelEntry * thisPort = _entitiesPanel->findKnownPort(walker->_outPortName);
-        ChannelEntry * otherPort = _entitiesPanel->findKnownPort(walker->_inPortName);
+        alertingServices.insert(walker->_servicePortName);
+    }
+    for (size_t ii = 0, mm = _entitiesPanel->getNumberOfEntities(); mm > ii; ++ii)
+    {
+        ChannelContainer * anEntity = _entitiesPanel->getEntity(ii);
 
-        ODL_P2("thisPort <- ", thisPort, "otherPort <- ", otherPort); //####
-        if (thisPort && otherPort)
+        if (anEntity)
         {
-            ODL_S2s("thisPort.name = ", thisPort->getPortName(), //####
-                    "otherPort.name = ", otherPort->getPortName()); //####
-            thisPort->addOutputConnection(otherPort, walker->_mode, false);
-            otherPort->addInputConnection(thisPort, walker->_mode, false);
+            ChannelEntry * servicePort = anEntity->getServicePort();
+
+            anEntity->setAlerting(servicePort &&
+                                  (alertingServices.end() !=
+                                   alertingServices.find(servicePort->getPortName())));
         }
     }
-    if (_entitiesPanel->removeUnvisitedEntities())
+    ODL_OBJEXIT(); //####
+} // ContentPanel::updateAlerts
+
+void
+ContentPanel::updateMetricsDisplay(const PortSet &          changedServices,
+                                   const TrafficWeightMap & weights)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("changedServices = ", &changedServices, "weights = ", &weights); //####
+    _trafficWeights = weights;
+    if (kTrafficWeightingNone == _trafficWeighting)
     {
-        changeSeen = true;
+        for (PortSet::const_iterator walker(changedServices.begin());
+             changedServices.end() != walker; ++walker)
+        {
+            ChannelEntry * aPort = _entitiesPanel->findKnownPort(*walker);
+
+            if (aPort && aPort->getParent())
+            {
+                aPort->getParent()->repaint();
+            }
+        }
     }
-    _entitiesPanel->removeInvalidConnections();
-    ODL_LOG("about to call adjustSize()"); //####
-    _entitiesPanel->adjustSize(false);
-    if (changeSeen)
+    else
+    {
+        // The connections run between the entities, so the whole panel has to be redrawn.
+        _entitiesPanel->repaint();
+    }
+    ODL_OBJEXIT(); //####
+} // ContentPanel::updateMetricsDisplay
+
+void
+ContentPanel::updatePanels(ScannerThread & scanner)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("scanner = ", &scanner); //####
+    double startTime = Time::getMillisecondCounterHiRes();
+    bool   changed = mergeScannedEntities(scanner.getEntitiesData(), false);
+
+    _statistics->recordUpdate(Time::getMillisecondCounterHiRes() - startTime);
+    if (changed)
     {
         scanner.doScanSoon();
+        // Keep the saved topology in step with what is displayed.
+        requestPositionSave();
     }
     ODL_OBJEXIT(); //####
 } // ContentPanel::updatePanels
 
-#if (! MAC_OR_LINUX_)
-# pragma warning(push)
-# pragma warning(disable: 4100)
-#endif // ! MAC_OR_LINUX_
 void
 ContentPanel::visibleAreaChanged(const juce::Rectangle<int> & newVisibleArea)
 {
-#if (! defined(ODL_ENABLE_LOGGING_))
-# if MAC_OR_LINUX_
-#  pragma unused(newVisibleArea)
-# endif // MAC_OR_LINUX_
-#endif // ! defined(ODL_ENABLE_LOGGING_)
     ODL_OBJENTER(); //####
     ODL_LL4("nVA.x = ", newVisibleArea.getX(), "nVA.y = ", newVisibleArea.getY(), //####
             "nVA.w = ", newVisibleArea.getWidth(), "nVA.h = ", //####
             newVisibleArea.getHeight()); //####
+    // The visible area is relative to the entities panel, so it can be used directly for culling.
+    _entitiesPanel->setVisibleArea(newVisibleArea);
     ODL_OBJEXIT(); //####
 } // ContentPanel::visibleAreaChanged
-#if (! MAC_OR_LINUX_)
-# pragma warning(pop)
-#endif // ! MAC_OR_LINUX_
+
+void
+ContentPanel::zoomAround(const float        newZoom,
+                         const Point<int> & anchor)
+{
+    ODL_OBJENTER(); //####
+    ODL_D1("newZoom = ", newZoom); //####
+    ODL_LL2("anchor.x = ", anchor.getX(), "anchor.y = ", anchor.getY()); //####
+    float      oldZoom = _entitiesPanel->getZoom();
+    Point<int> oldPoint(_entitiesPanel->getLocalPoint(this, anchor));
+
+    _entitiesPanel->setZoom(newZoom);
+    float zoomChange = _entitiesPanel->getZoom() / oldZoom;
+
+    if (1 != zoomChange)
+    {
+        // Scroll so that the point under the anchor is the same as before the change.
+        Point<int> newPoint((oldPoint.toFloat() * zoomChange).roundToInt());
+        Point<int> offset(newPoint - _entitiesPanel->getLocalPoint(this, anchor));
+
+        setViewPosition(getViewPosition() + offset);
+    }
+    ODL_OBJEXIT(); //####
+} // ContentPanel::zoomAround
 
 #if defined(__APPLE__)
 # pragma mark Global functions
@@ -61,13 +61,21 @@
 
 namespace MPlusM_Manager
 {
+    class ActivityThread;
+    class EntitiesData;
     class EntitiesPanel;
+    class LayoutThread;
     class ManagerWindow;
+    class MetricsThread;
     class ScannerThread;
+    class ScrollingMonitorWindow;
+    class StatisticsOverlay;
 
     /*! @brief The content area of the main window of the application. */
     class ContentPanel : public ApplicationCommandTarget,
                          public MenuBarModel,
+                         private TextEditor::Listener,
+                         private Timer,
                          public Viewport
     {
     public :
@@ -83,7 +91,13 @@ namespace MPlusM_Manager
         typedef MenuBarModel inherited2;
 
         /*! @brief The third class that this class is derived from. */
-        typedef Viewport inherited3;
+        typedef TextEditor::Listener inherited3;
+
+        /*! @brief The fourth class that this class is derived from. */
+        typedef Timer inherited4;
+
+        /*! @brief The fifth class that this class is derived from. */
+        typedef Viewport inherited5;
 
     public :
 
@@ -128,6 +142,21 @@ namespace MPlusM_Manager
             _invertBackground = ! _invertBackground;
         } // flipBackground
 
+        /*! @brief Open a window that shows the messages sent by a port, or bring it to the front if
+         it is already open.
+         @param[in] aChannel The port of interest. */
+        void
+        addScrollingMonitor(ChannelEntry & aChannel);
+
+        /*! @brief Returns the background sampling of port activity.
+         @returns The background sampling of port activity. */
+        inline ActivityThread &
+        getActivityThread(void)
+        const
+        {
+            return *_activityThread;
+        } // getActivityThread
+
         /*! @brief Returns the entities panel.
          @returns The entities panel. */
         inline EntitiesPanel &
@@ -137,22 +166,104 @@ namespace MPlusM_Manager
             return *_entitiesPanel;
         } // getEntitiesPanel
 
+        /*! @brief Returns the background collection of service metrics.
+         @returns The background collection of service metrics. */
+        inline MetricsThread &
+        getMetricsThread(void)
+        const
+        {
+            return *_metricsThread;
+        } // getMetricsThread
+
+        /*! @brief Return the figures that show how well the scanner is keeping up.
+         @param[out] health The figures for the scanner, which are all zero if there is no
+         scanner. */
+        void
+        getScannerHealth(ScannerHealth & health);
+
+        /*! @brief Collect the primary ports of the displayed services and adapters.
+         @param[out] servicePorts The primary ports of the displayed services and adapters.
+         @param[out] serviceKinds The kinds of the displayed services and adapters.
+         @param[out] serviceChannels The channels of the displayed services and adapters. */
+        void
+        getServicePorts(PortSet &           servicePorts,
+                        ServiceKindMap &    serviceKinds,
+                        ServiceChannelMap & serviceChannels);
+
+        /*! @brief Returns the display of the drawing and update costs.
+         @returns The display of the drawing and update costs. */
+        inline StatisticsOverlay &
+        getStatistics(void)
+        const
+        {
+            return *_statistics;
+        } // getStatistics
+
+        /*! @brief Return the recent traffic on a channel, relative to the busiest channel.
+         @param[in] channelName The name of the channel.
+         @returns A value between zero and one if connections are being weighted by their traffic
+         and -1 otherwise. */
+        float
+        getTrafficWeight(const YarpString & channelName)
+        const;
+
+        /*! @brief Return how connections are weighted by their traffic.
+         @returns How connections are weighted by their traffic. */
+        inline TrafficWeighting
+        getTrafficWeighting(void)
+        const
+        {
+            return _trafficWeighting;
+        } // getTrafficWeighting
+
         /*! @brief Restore the positions of all the entities in the panel. */
         void
         recallEntityPositions(void);
 
-        /*! @brief Record the position of an entity before it is removed from the panel. */
+        /*! @brief Display the entities and connections that were saved at the end of the previous
+         session. The entities are shown as stale until a scan confirms them, and those that a scan
+         doesn't find are removed. */
+        void
+        recallTopology(void);
+
+        /*! @brief Record the position of an entity, along with the time at which it was seen.
+         @param[in] anEntity The entity of interest. */
         void
         rememberPositionOfEntity(ChannelContainer * anEntity);
 
+        /*! @brief Close a window that shows the messages sent by a port.
+         @param[in] aMonitor The window to be closed. */
+        void
+        removeScrollingMonitor(ScrollingMonitorWindow * aMonitor);
+
+        /*! @brief Ask for the positions of the entities, and the entities and connections
+         themselves, to be saved once they have stopped changing. Each request restarts the delay,
+         so a series of changes results in a single save. */
+        void
+        requestPositionSave(void);
+
         /*! @brief Ask the containing window to do a repaint. */
         void
         requestWindowRepaint(void);
 
-        /*! @brief Record the positions of all the entities in the panel. */
+        /*! @brief Write the remembered positions to the settings file.
+         Positions that have not been seen within the age limit are discarded first. The file is
+         replaced atomically, so an interrupted save leaves the previous contents intact. */
         void
         saveEntityPositions(void);
 
+        /*! @brief Write the displayed entities, ports and connections to the topology file, so
+         that they can be shown as soon as the next session starts. The file is replaced
+         atomically. */
+        void
+        saveTopology(void);
+
+        /*! @brief Show or hide the activity markers of monitored ports.
+         @param[in] changes The ports whose activity markers need to change, with their new
+         states. */
+        void
+        setActivityMarkers(const ActivityStateMap & changes);
+
         /*! @brief Record the ChannelEntry that is selected. */
         void
         setChannelOfInterest(ChannelEntry * aChannel);
@@ -184,6 +295,24 @@ namespace MPlusM_Manager
         void
         skipScan(void);
 
+        /*! @brief Start or stop monitoring the activity of a port.
+         @param[in] aChannel The port of interest. */
+        void
+        toggleActivityIndicator(ChannelEntry & aChannel);
+
+        /*! @brief Highlight the entities that have raised alerts.
+         @param[in] alerts The alerts that have been raised. */
+        void
+        updateAlerts(const MetricsAlertList & alerts);
+
+        /*! @brief Redraw the entities whose metrics histories have changed.
+         @param[in] changedServices The primary ports of the services whose metrics histories have
+         changed.
+         @param[in] weights The recent traffic on the channels. */
+        void
+        updateMetricsDisplay(const PortSet &          changedServices,
+                             const TrafficWeightMap & weights);
+
     protected :
 
     private :
@@ -226,6 +355,22 @@ namespace MPlusM_Manager
         menuItemSelected(int menuItemID,
                          int topLevelMenuIndex);
 
+        /*! @brief Merge a set of scanned entities and connections into the displayed ones.
+         @param[in] scannedData The entities and connections to be merged.
+         @param[in] fromSnapshot @c true if the data was recalled from the previous session and
+         @c false if it comes from a scan.
+         @returns @c true if entities were added or removed and @c false otherwise. */
+        bool
+        mergeScannedEntities(const EntitiesData & scannedData,
+                             const bool           fromSnapshot);
+
+        /*! @brief Called when the mouse wheel is moved.
+         @param[in] ee Details about the position and status of the mouse event.
+         @param[in] wheel Details about the mouse wheel movement. */
+        virtual void
+        mouseWheelMove(const MouseEvent &        ee,
+                       const MouseWheelDetails & wheel);
+
         /*! @brief Draw the content of the component.
          @param[in,out] gg The graphics context in which to draw. */
         virtual void
@@ -237,6 +382,12 @@ namespace MPlusM_Manager
         virtual bool
         perform(const InvocationInfo & info);
 
+        /*! @brief Place newly-discovered entities close to the entities that they are connected to,
+         without moving the entities that are already displayed.
+         @param[in,out] randomizer The random number generator to use for unconnected entities. */
+        void
+        placeNewEntitiesLocally(Random & randomizer);
+
         /*! @brief Called when the component size has been changed. */
         virtual void
         resized(void);
@@ -250,16 +401,54 @@ namespace MPlusM_Manager
         void
         setUpMainMenu(PopupMenu & aMenu);
 
+        /*! @brief Display the alerts that have been raised. */
+        void
+        showAlerts(void);
+
+        /*! @brief Select the next or previous entity that matches the search, and scroll so that
+         it is in the middle of the window.
+         @param[in] forward @c true if the next match is wanted and @c false if the previous
+         match is wanted. */
+        void
+        showSearchMatch(const bool forward);
+
+        /*! @brief Called when the escape key is pressed in the search box.
+         @param[in,out] editor The search box. */
+        virtual void
+        textEditorEscapeKeyPressed(TextEditor & editor);
+
+        /*! @brief Called when the return key is pressed in the search box.
+         @param[in,out] editor The search box. */
+        virtual void
+        textEditorReturnKeyPressed(TextEditor & editor);
+
+        /*! @brief Called when the text in the search box has changed.
+         @param[in,out] editor The search box. */
+        virtual void
+        textEditorTextChanged(TextEditor & editor);
+
         /*! @brief Refresh the displayed entities and connections, based on the scanned entities.
          @param[in] scanner The background scanning thread. */
         void
         updatePanels(ScannerThread & scanner);
 
+        /*! @brief Called when the delay after a request to save the positions has elapsed. */
+        virtual void
+        timerCallback(void);
+
         /*! @brief Called when the visible area changes.
          @param[in] newVisibleArea The new visible area. */
         virtual void
         visibleAreaChanged(const juce::Rectangle<int> & newVisibleArea);
 
+        /*! @brief Change the zoom level of the entities panel, keeping a point fixed in the
+         window.
+         @param[in] newZoom The new zoom level.
+         @param[in] anchor The point, relative to this component, that is to remain fixed. */
+        void
+        zoomAround(const float        newZoom,
+                   const Point<int> & anchor);
+
     public :
 
     protected :
@@ -269,15 +458,46 @@ namespace MPlusM_Manager
         /*! @brief The positions that entities were last seen at. */
         PositionMap _rememberedPositions;
 
+        /*! @brief The alerts raised by the metrics alert rules. */
+        MetricsAlertList _alerts;
+
+        /*! @brief The open windows that show the messages sent by ports. */
+        OwnedArray<ScrollingMonitorWindow> _monitors;
+
+        /*! @brief The recent traffic on the channels, relative to the busiest channel. */
+        TrafficWeightMap _trafficWeights;
+
+        /*! @brief The background sampling of port activity. */
+        ScopedPointer<ActivityThread> _activityThread;
+
         /*! @brief The entities panel. */
         ScopedPointer<EntitiesPanel> _entitiesPanel;
 
+        /*! @brief The background entity layout. */
+        ScopedPointer<LayoutThread> _layoutThread;
+
         /*! @brief The menubar for the panel. */
         ScopedPointer<MenuBarComponent> _menuBar;
 
+        /*! @brief The background collection of service metrics. */
+        ScopedPointer<MetricsThread> _metricsThread;
+
+        /*! @brief The text box for searching the entities and ports. */
+        ScopedPointer<TextEditor> _searchBox;
+
+        /*! @brief The display of the drawing and update costs. */
+        ScopedPointer<StatisticsOverlay> _statistics;
+
         /*! @brief The window in which the panel is embedded. */
         ManagerWindow * _containingWindow;
 
+        /*! @brief The time after which an entity that has not been seen is forgotten, in
+         milliseconds. */
+        int64 _positionAgeLimit;
+
+        /*! @brief How connections are weighted by their traffic. */
+        TrafficWeighting _trafficWeighting;
+
         /*! @brief The selected channel. */
         ChannelEntry * _selectedChannel;
 
@@ -290,9 +510,9 @@ namespace MPlusM_Manager
         /*! @brief @c true if a container was clicked and @c false otherwise. */
         bool _containerClicked;
 
-# if (defined(USE_OGDF_POSITIONING_) && defined(USE_OGDF_FOR_FIRST_POSITIONING_ONLY_))
+        /*! @brief @c true if the entities have been placed for the first time and @c false
+         otherwise. */
         bool _initialPositioningDone;
-# endif // defined(USE_OGDF_POSITIONING_) && defined(USE_OGDF_FOR_FIRST_POSITIONING_ONLY_)
 
         /*! @brief @c true if the background is inverted and @c false otherwise. */
         bool _invertBackground;
@@ -42,11 +42,15 @@
 #include "m+mChannelEntry.hpp"
 #include "m+mContentPanel.hpp"
 #include "m+mFormField.hpp"
+#include "m+mManagerApplication.hpp"
 #include "m+mManagerWindow.hpp"
+#include "m+mStatisticsOverlay.hpp"
 
 //#include <odlEnable.h>
 #include <odlInclude.h>
 
+#include <algorithm>
+
 #if defined(__APPLE__)
 # pragma clang diagnostic push
 # pragma clang diagnostic ignored "-Wunknown-pragmas"
@@ -97,18 +101,91 @@ using namespace std;
 # pragma mark Private structures, constants and variables
 #endif // defined(__APPLE__)
 
+/*! @brief The size of a synthetic set of entities used for benchmarking the drawing. */
+struct BenchmarkScene
+{
+    /*! @brief The number of entities. */
+    int _numEntities;
+
+    /*! @brief The number of ports in each entity. */
+    int _portsPerEntity;
+
+    /*! @brief The number of connections from each output port. */
+    int _connectionsPerPort;
+
+}; // BenchmarkScene
+
+/*! @brief The sets of entities that are used for benchmarking the drawing; the last one is
+ dominated by its connections. */
+static const BenchmarkScene kBenchmarkScenes[] =
+{
+    { 100, 4, 1 },
+    { 1000, 4, 1 },
+    { 200, 8, 6 }
+};
+
+/*! @brief The number of frames that are timed for each measurement of the drawing. */
+static const int kBenchmarkFrames = 20;
+
+/*! @brief The height of the offscreen image used for benchmarking the drawing. */
+static const int kBenchmarkFrameHeight = 800;
+
+/*! @brief The width of the offscreen image used for benchmarking the drawing. */
+static const int kBenchmarkFrameWidth = 1280;
+
+/*! @brief The name of the environment variable that replaces the sets of entities used for
+ benchmarking the drawing, as 'entities,ports,connections'. */
+static const char * kBenchmarkSceneVariable = "MPM_MANAGER_BENCHMARK_SCENE";
+
+/*! @brief The height of the area that is redrawn when an entity is dragged. */
+static const int kDragAreaHeight = 200;
+
+/*! @brief The width of the area that is redrawn when an entity is dragged. */
+static const int kDragAreaWidth = 300;
+
+/*! @brief The distance moved by the redrawn area between frames when an entity is dragged. */
+static const int kDragStep = 37;
+
+/*! @brief The colour to be used for merged connections. */
+static const Colour & kMergedConnectionColour(Colours::teal);
+
 /*! @brief The name of the font to be used for text. */
 static const char * kFontName = "Courier New";
 
+/*! @brief The zoom level below which entities are drawn as simplified glyphs. */
+static const float kGlyphZoomThreshold = 0.5;
+
+/*! @brief The length of the character sequences used in the search index. */
+static const size_t kSearchSequenceLength = 3;
+
 /*! @brief The outer 'gutter' for the entities. */
 static const int kGutter = 10;
 
+/*! @brief The width and height of a cell of the spatial index. */
+static const int kGridCellSize = 256;
+
+/*! @brief The vertical space between the ports of a host group when it is expanded. */
+static const int kHostGroupMemberGap = 4;
+
 /*! @brief The initial height of the displayed region. */
 static const int kInitialPanelHeight = 768;
 
 /*! @brief The initial width of the displayed region. */
 static const int kInitialPanelWidth = 1024;
 
+/*! @brief The largest supported zoom level. */
+static const float kMaximumZoom = 4;
+
+/*! @brief The width of a merged connection that represents a single connection, before
+ scaling. */
+static const float kMergedConnectionWidth = 2;
+
+/*! @brief The smallest number of standalone ports on a host for them to be grouped together. */
+static const size_t kMinimumHostGroupSize = 2;
+
+/*! @brief The smallest supported zoom level. */
+static const float kMinimumZoom = 0.05f;
+
 #if defined(__APPLE__)
 # pragma mark Global constants and variables
 #endif // defined(__APPLE__)
@@ -117,10 +194,464 @@ static const int kInitialPanelWidth = 1024;
 # pragma mark Local functions
 #endif // defined(__APPLE__)
 
+/*! @brief Return the index of the spatial index cell that contains a coordinate.
+ @param[in] coordinate The horizontal or vertical coordinate.
+ @returns The index of the spatial index cell that contains the coordinate. */
+inline static int
+cellIndex(const int coordinate)
+{
+    return ((0 <= coordinate) ? (coordinate / kGridCellSize) :
+            (((coordinate + 1) / kGridCellSize) - 1));
+} // cellIndex
+
+/*! @brief Add an entity to all the cells of a spatial index that overlap an area.
+ @param[in,out] grid The spatial index to be updated.
+ @param[in] anEntity The entity to be added.
+ @param[in] area The area covered by the entity. */
+static void
+addToGrid(ContainerGrid &              grid,
+          ChannelContainer *           anEntity,
+          const juce::Rectangle<int> & area)
+{
+    ODL_ENTER(); //####
+    ODL_P2("grid = ", &grid, "anEntity = ", anEntity); //####
+    for (int xx = cellIndex(area.getX()), xLimit = cellIndex(area.getRight()); xLimit >= xx; ++xx)
+    {
+        for (int yy = cellIndex(area.getY()), yLimit = cellIndex(area.getBottom()); yLimit >= yy;
+             ++yy)
+        {
+            grid[GridCell(xx, yy)].insert(anEntity);
+        }
+    }
+    ODL_EXIT(); //####
+} // addToGrid
+
+/*! @brief Return @c true if an entity was at an edge of an area and no longer reaches that edge.
+ @param[in] oldBounds The previous bounds of the entity, or an empty rectangle if it is new.
+ @param[in] newBounds The current bounds of the entity, or an empty rectangle if it is gone.
+ @param[in] area The area that contains all the entities.
+ @returns @c true if the area might need to shrink and @c false otherwise. */
+static bool
+leavesEdgeOfArea(const juce::Rectangle<int> & oldBounds,
+                 const juce::Rectangle<int> & newBounds,
+                 const juce::Rectangle<int> & area)
+{
+    ODL_ENTER(); //####
+    bool result = false;
+
+    if (! oldBounds.isEmpty())
+    {
+        bool isGone = newBounds.isEmpty();
+
+        if ((area.getX() == oldBounds.getX()) && (isGone || (area.getX() < newBounds.getX())))
+        {
+            result = true;
+        }
+        else if ((area.getRight() == oldBounds.getRight()) &&
+                 (isGone || (area.getRight() > newBounds.getRight())))
+        {
+            result = true;
+        }
+        else if ((area.getY() == oldBounds.getY()) && (isGone || (area.getY() < newBounds.getY())))
+        {
+            result = true;
+        }
+        else if ((area.getBottom() == oldBounds.getBottom()) &&
+                 (isGone || (area.getBottom() > newBounds.getBottom())))
+        {
+            result = true;
+        }
+    }
+    ODL_EXIT_B(result); //####
+    return result;
+} // leavesEdgeOfArea
+
+/*! @brief Collect the entities from all the cells of a spatial index that overlap an area.
+ @param[in] grid The spatial index to be searched.
+ @param[in] area The area of interest.
+ @param[in,out] found The entities that were found. */
+static void
+gatherFromGrid(const ContainerGrid &        grid,
+               const juce::Rectangle<int> & area,
+               ContainerSet &               found)
+{
+    ODL_ENTER(); //####
+    ODL_P2("grid = ", &grid, "found = ", &found); //####
+    int   xFirst = cellIndex(area.getX());
+    int   xLast = cellIndex(area.getRight());
+    int   yFirst = cellIndex(area.getY());
+    int   yLast = cellIndex(area.getBottom());
+    int64 cellCount = ((static_cast<int64>(xLast - xFirst) + 1) *
+                       (static_cast<int64>(yLast - yFirst) + 1));
+
+    if (static_cast<int64>(grid.size()) < cellCount)
+    {
+        // The area is large compared to the number of occupied cells, so walk the occupied cells.
+        for (ContainerGrid::const_iterator walker(grid.begin()); grid.end() != walker; ++walker)
+        {
+            const GridCell & aCell = walker->first;
+
+            if ((xFirst <= aCell.first) && (xLast >= aCell.first) && (yFirst <= aCell.second) &&
+                (yLast >= aCell.second))
+            {
+                found.insert(walker->second.begin(), walker->second.end());
+            }
+        }
+    }
+    else
+    {
+        for (int xx = xFirst; xLast >= xx; ++xx)
+        {
+            for (int yy = yFirst; yLast >= yy; ++yy)
+            {
+                ContainerGrid::const_iterator match(grid.find(GridCell(xx, yy)));
+
+                if (grid.end() != match)
+                {
+                    found.insert(match->second.begin(), match->second.end());
+                }
+            }
+        }
+    }
+    ODL_EXIT(); //####
+} // gatherFromGrid
+
+/*! @brief Remove an entity from all the cells of a spatial index that overlap an area.
+ @param[in,out] grid The spatial index to be updated.
+ @param[in] anEntity The entity to be removed.
+ @param[in] area The area that was covered by the entity. */
+static void
+removeFromGrid(ContainerGrid &              grid,
+               ChannelContainer *           anEntity,
+               const juce::Rectangle<int> & area)
+{
+    ODL_ENTER(); //####
+    ODL_P2("grid = ", &grid, "anEntity = ", anEntity); //####
+    for (int xx = cellIndex(area.getX()), xLimit = cellIndex(area.getRight()); xLimit >= xx; ++xx)
+    {
+        for (int yy = cellIndex(area.getY()), yLimit = cellIndex(area.getBottom()); yLimit >= yy;
+             ++yy)
+        {
+            ContainerGrid::iterator match(grid.find(GridCell(xx, yy)));
+
+            if (grid.end() != match)
+            {
+                match->second.erase(anEntity);
+                if (match->second.empty())
+                {
+                    grid.erase(match);
+                }
+            }
+        }
+    }
+    ODL_EXIT(); //####
+} // removeFromGrid
+
+/*! @brief Return the text that is searched for an entity.
+ The text holds the name, IP address and kind of the entity and the names and addresses of its
+ ports, in lower case, with each on its own line so that matches can't span them.
+ @param[in] anEntity The entity of interest.
+ @returns The text that is searched for the entity. */
+static YarpString
+getSearchTextForEntity(ChannelContainer * anEntity)
+{
+    ODL_ENTER(); //####
+    ODL_P1("anEntity = ", anEntity); //####
+    String result(anEntity->getName() + "\n" + anEntity->getIPAddress().c_str() + "\n");
+
+    switch (anEntity->getKind())
+    {
+        case kContainerKindAdapter :
+            result += "adapter";
+            break;
+
+        case kContainerKindService :
+            result += "service";
+            break;
+
+        case kContainerKindHost :
+            result += "host";
+            break;
+
+        default :
+            result += "port";
+            break;
+
+    }
+    result += String("\n") + anEntity->getBehaviour().c_str();
+    for (int ii = 0, mm = anEntity->getNumPorts(); mm > ii; ++ii)
+    {
+        ChannelEntry * aPort = anEntity->getPort(ii);
+
+        if (aPort)
+        {
+            result += String("\n") + aPort->getPortName().c_str() + "\n" +
+                      aPort->getPortNumber().c_str();
+        }
+    }
+    YarpString lowered(result.toLowerCase().toStdString());
+
+    ODL_EXIT_s(lowered); //####
+    return lowered;
+} // getSearchTextForEntity
+
+/*! @brief Collect the character sequences that are used to index a search text.
+ @param[in] searchText The text to be indexed.
+ @param[in,out] sequences The character sequences that appear in the text. */
+static void
+getSearchSequences(const YarpString &     searchText,
+                   std::set<YarpString> & sequences)
+{
+    ODL_ENTER(); //####
+    ODL_S1s("searchText = ", searchText); //####
+    ODL_P1("sequences = ", &sequences); //####
+    for (size_t ii = 0; searchText.length() >= (ii + kSearchSequenceLength); ++ii)
+    {
+        YarpString aSequence(searchText.substr(ii, kSearchSequenceLength));
+
+        // Matches can't span lines, so there's no need to index sequences that do.
+        if (YarpString::npos == aSequence.find('\n'))
+        {
+            sequences.insert(aSequence);
+        }
+    }
+    ODL_EXIT(); //####
+} // getSearchSequences
+
+/*! @brief Return @c true if an entity comes before another one when reading the panel from top to
+ bottom and left to right.
+ @param[in] first The first entity to compare.
+ @param[in] second The second entity to compare.
+ @returns @c true if the first entity comes before the second one and @c false otherwise. */
+static bool
+isBeforeInReadingOrder(ChannelContainer * first,
+                       ChannelContainer * second)
+{
+    bool result;
+
+    if (first->getY() == second->getY())
+    {
+        result = (first->getX() < second->getX());
+    }
+    else
+    {
+        result = (first->getY() < second->getY());
+    }
+    return result;
+} // isBeforeInReadingOrder
+
+/*! @brief Fill a panel with a synthetic set of entities, ports and connections.
+ The entities are placed on a jittered grid, even-numbered ports are outputs and odd-numbered
+ ports are inputs, and the connections alternate between TCP and UDP, with every third one being
+ forced.
+ @param[in,out] aPanel The panel to be filled.
+ @param[in] aScene The size of the set of entities.
+ @returns The number of connections that were made. */
+static int
+populateSyntheticPanel(EntitiesPanel &        aPanel,
+                       const BenchmarkScene & aScene)
+{
+    ODL_ENTER(); //####
+    ODL_P2("aPanel = ", &aPanel, "aScene = ", &aScene); //####
+    // A fixed seed keeps the scenes the same from one run to the next.
+    Random                          randomizer(aScene._numEntities);
+    int                             numColumns = jmax(1, roundToInt(sqrt(aScene._numEntities)));
+    int                             numConnections = 0;
+    int                             right = 0;
+    int                             bottom = 0;
+    std::vector<ChannelContainer *> entities;
+
+    for (int ii = 0; aScene._numEntities > ii; ++ii)
+    {
+        String             entityName(String("/synthetic/entity") + String(ii));
+        ChannelContainer * anEntity = new ChannelContainer(kContainerKindOther,
+                                                           entityName.toStdString(), "127.0.0.1",
+                                                           "", "", "", "", aPanel);
+
+        for (int jj = 0; aScene._portsPerEntity > jj; ++jj)
+        {
+            String portName(entityName + "/port" + String(jj));
+
+            anEntity->addPort(portName.toStdString(), String(10000 + jj).toStdString(), "", "",
+                              kPortUsageOther,
+                              (0 == (jj % 2)) ? kPortDirectionOutput : kPortDirectionInput);
+        }
+        int xPos = kGutter + ((ii % numColumns) * (kBenchmarkFrameWidth / 5)) +
+                   randomizer.nextInt(kGutter * 4);
+        int yPos = kGutter + ((ii / numColumns) * (kBenchmarkFrameHeight / 4)) +
+                   randomizer.nextInt(kGutter * 4);
+
+        anEntity->setTopLeftPosition(xPos, yPos);
+        // The synthetic entities are not reported, as there can be thousands of them.
+        aPanel.addEntity(anEntity, false);
+        anEntity->setVisible(true);
+        right = jmax(right, anEntity->getRight());
+        bottom = jmax(bottom, anEntity->getBottom());
+        entities.push_back(anEntity);
+    }
+    for (size_t ii = 0, mm = entities.size(); mm > ii; ++ii)
+    {
+        ChannelContainer * anEntity = entities[ii];
+
+        for (int jj = 0; anEntity->getNumPorts() > jj; jj += 2)
+        {
+            ChannelEntry * outPort = anEntity->getPort(jj);
+
+            for (int kk = 0; aScene._connectionsPerPort > kk; ++kk)
+            {
+                // Connect to one of the following entities, which are mostly in the same row.
+                size_t             offset = 1 + randomizer.nextInt(numColumns * 2);
+                ChannelContainer * other = entities[(ii + offset) % mm];
+                int                numInputs = jmax(1, other->getNumPorts() / 2);
+                int                inIndex = 1 + (2 * randomizer.nextInt(numInputs));
+                ChannelEntry *     inPort = other->getPort(inIndex);
+
+                if (outPort && inPort && (outPort->getParent() != inPort->getParent()))
+                {
+                    Common::ChannelMode mode = ((0 == (numConnections % 2)) ?
+                                                Common::kChannelModeTCP : Common::kChannelModeUDP);
+                    bool                forced = (0 == (numConnections % 3));
+
+                    outPort->addOutputConnection(inPort, mode, forced);
+                    inPort->addInputConnection(outPort, mode, forced);
+                    ++numConnections;
+                }
+            }
+        }
+    }
+    aPanel.updateEntityIndexForAll();
+    aPanel.setSize(right + kGutter, bottom + kGutter);
+    ODL_EXIT_LL(numConnections); //####
+    return numConnections;
+} // populateSyntheticPanel
+
+/*! @brief Return the average time taken to draw a panel into an offscreen image.
+ @param[in,out] aPanel The panel to be drawn.
+ @param[in,out] anImage The image to draw into.
+ @param[in] viewArea The area of the panel that is shown in the image.
+ @param[in] dragArea @c true if only an area the size of a dragged entity is redrawn in each
+ frame and @c false if the whole image is redrawn.
+ @returns The average time, in milliseconds, taken to draw a frame. */
+static double
+timeSyntheticFrames(EntitiesPanel &              aPanel,
+                    Image &                      anImage,
+                    const juce::Rectangle<int> & viewArea,
+                    const bool                   dragArea)
+{
+    ODL_ENTER(); //####
+    ODL_P2("aPanel = ", &aPanel, "anImage = ", &anImage); //####
+    ODL_B1("dragArea = ", dragArea); //####
+    double totalTime = 0;
+
+    // The first frame is not timed, as it fills any cached images of the entities.
+    for (int ii = 0; kBenchmarkFrames >= ii; ++ii)
+    {
+        Graphics             gg(anImage);
+        juce::Rectangle<int> frameArea(viewArea);
+
+        if (dragArea)
+        {
+            // Move the redrawn area across the view, as happens when an entity is dragged.
+            int xRange = jmax(1, viewArea.getWidth() - kDragAreaWidth);
+            int yRange = jmax(1, viewArea.getHeight() - kDragAreaHeight);
+
+            frameArea = juce::Rectangle<int>(viewArea.getX() + ((ii * kDragStep) % xRange),
+                                             viewArea.getY() + ((ii * kDragStep) % yRange),
+                                             kDragAreaWidth, kDragAreaHeight);
+        }
+        gg.setOrigin(- viewArea.getX(), - viewArea.getY());
+        gg.reduceClipRegion(frameArea);
+        double startTime = Time::getMillisecondCounterHiRes();
+
+        aPanel.paintEntireComponent(gg, true);
+        if (0 < ii)
+        {
+            totalTime += (Time::getMillisecondCounterHiRes() - startTime);
+        }
+    }
+    double result = (totalTime / kBenchmarkFrames);
+
+    ODL_EXIT_D(result); //####
+    return result;
+} // timeSyntheticFrames
+
 #if defined(__APPLE__)
 # pragma mark Class methods
 #endif // defined(__APPLE__)
 
+bool
+EntitiesPanel::performDrawingBenchmark(void)
+{
+    ODL_ENTER(); //####
+    bool                        result = true;
+    char                        buffer1[DATE_TIME_BUFFER_SIZE_];
+    char                        buffer2[DATE_TIME_BUFFER_SIZE_];
+    std::vector<BenchmarkScene> scenes(kBenchmarkScenes,
+                                       kBenchmarkScenes + numElementsInArray(kBenchmarkScenes));
+    StringArray                 sceneSizes;
+
+    sceneSizes.addTokens(ManagerApplication::getEnvironmentVar(kBenchmarkSceneVariable), ",", "");
+    if (3 == sceneSizes.size())
+    {
+        BenchmarkScene aScene;
+
+        aScene._numEntities = jmax(1, sceneSizes[0].getIntValue());
+        aScene._portsPerEntity = jmax(2, sceneSizes[1].getIntValue());
+        aScene._connectionsPerPort = jmax(0, sceneSizes[2].getIntValue());
+        scenes.clear();
+        scenes.push_back(aScene);
+    }
+    Utilities::GetDateAndTime(buffer1, sizeof(buffer1), buffer2, sizeof(buffer2));
+    std::cerr << buffer1 << " " << buffer2 << " Benchmarking entity drawing with " <<
+                kBenchmarkFrames << " frames per measurement" << std::endl;
+    for (std::vector<BenchmarkScene>::const_iterator walker(scenes.begin());
+         scenes.end() != walker; ++walker)
+    {
+        ScopedPointer<EntitiesPanel> aPanel(new EntitiesPanel(NULL));
+        Image                        anImage(Image::RGB, kBenchmarkFrameWidth,
+                                             kBenchmarkFrameHeight, true);
+        int                          numConnections = populateSyntheticPanel(*aPanel, *walker);
+        juce::Rectangle<int>         panelArea(aPanel->getLocalBounds());
+        juce::Rectangle<int>         overviewArea(0, 0, kBenchmarkFrameWidth,
+                                                  kBenchmarkFrameHeight);
+        juce::Rectangle<int>         viewArea(overviewArea.withCentre(panelArea.getCentre()));
+        float                        widthRatio = (static_cast<float>(kBenchmarkFrameWidth) /
+                                                   panelArea.getWidth());
+        float                        heightRatio = (static_cast<float>(kBenchmarkFrameHeight) /
+                                                    panelArea.getHeight());
+        float                        overviewZoom = jmin(1.0f, widthRatio, heightRatio);
+
+        if (static_cast<size_t>(walker->_numEntities) != aPanel->getNumberOfEntities())
+        {
+            result = false;
+        }
+        for (int caching = 0; 2 > caching; ++caching)
+        {
+            bool cacheImages = (0 == caching);
+
+            aPanel->setEntityImageCaching(cacheImages);
+            aPanel->setZoom(1);
+            aPanel->setVisibleArea(viewArea);
+            double fullTime = timeSyntheticFrames(*aPanel, anImage, viewArea, false);
+            double dragTime = timeSyntheticFrames(*aPanel, anImage, viewArea, true);
+
+            aPanel->setZoom(overviewZoom);
+            aPanel->setVisibleArea(overviewArea);
+            double overviewTime = timeSyntheticFrames(*aPanel, anImage, overviewArea, false);
+
+            Utilities::GetDateAndTime(buffer1, sizeof(buffer1), buffer2, sizeof(buffer2));
+            std::cerr << buffer1 << " " << buffer2 << " Drawing " << walker->_numEntities <<
+                        " entities with " << (walker->_numEntities * walker->_portsPerEntity) <<
+                        " ports and " << numConnections << " connections, with entity images " <<
+                        (cacheImages ? "cached" : "not cached") << ", took " << fullTime <<
+                        "ms per full frame, " << dragTime << "ms per dragged area and " <<
+                        overviewTime << "ms per overview frame" << std::endl;
+        }
+    }
+    ODL_EXIT_B(result); //####
+    return result;
+} // EntitiesPanel::performDrawingBenchmark
+
 #if defined(__APPLE__)
 # pragma mark Constructors and Destructors
 #endif // defined(__APPLE__)
@@ -129,8 +660,10 @@ EntitiesPanel::EntitiesPanel(ContentPanel * theContainer,
                              const int      startingWidth,
                              const int      startingHeight) :
     inherited(), _knownPorts(), _knownEntities(), _defaultBoldFont(), _defaultNormalFont(),
-    _firstAddPoint(NULL), _firstRemovePoint(NULL), _container(theContainer),
-    _dragConnectionActive(false), _dragIsForced(false)
+    _firstAddPoint(NULL), _firstRemovePoint(NULL), _container(theContainer), _connectionsDrawn(0),
+    _paintStartTicks(0), _paintTimeTotal(0), _paintCount(0), _zoom(1), _cacheEntityImages(true),
+    _contentBoundsValid(true), _dragConnectionActive(false), _dragIsForced(false),
+    _searchIsApplied(false), _showGlyphs(false)
 {
     ODL_ENTER(); //####
     _defaultBoldFont = new Font(kFontName, FormField::kFontSize - 1, Font::bold);
@@ -155,17 +688,29 @@ EntitiesPanel::~EntitiesPanel(void)
 #endif // defined(__APPLE__)
 
 void
-EntitiesPanel::addEntity(ChannelContainer * anEntity)
+EntitiesPanel::addEntity(ChannelContainer * anEntity,
+                         const bool         reportAddition)
 {
     ODL_OBJENTER(); //####
     ODL_P1("anEntity = ", anEntity); //####
-    char buffer1[DATE_TIME_BUFFER_SIZE_];
-    char buffer2[DATE_TIME_BUFFER_SIZE_];
+    ODL_B1("reportAddition = ", reportAddition); //####
+    if (reportAddition)
+    {
+        char buffer1[DATE_TIME_BUFFER_SIZE_];
+        char buffer2[DATE_TIME_BUFFER_SIZE_];
 
-    Utilities::GetDateAndTime(buffer1, sizeof(buffer1), buffer2, sizeof(buffer2));
-    std::cerr << buffer1 << " " << buffer2 << " Adding entity " << anEntity->getName() << std::endl;
+        Utilities::GetDateAndTime(buffer1, sizeof(buffer1), buffer2, sizeof(buffer2));
+        std::cerr << buffer1 << " " << buffer2 << " Adding entity " << anEntity->getName() <<
+                    std::endl;
+    }
     _knownEntities.push_back(anEntity);
+    // The ports are children of the entity, so they are included in its cached image.
+    anEntity->setBufferedToImage(_cacheEntityImages);
+    anEntity->setTransform(AffineTransform::scale(_zoom));
+    anEntity->setGlyphMode(_showGlyphs);
     addChildComponent(anEntity);
+    updateEntityIndex(anEntity);
+    updateSearchIndex(anEntity);
     ODL_OBJEXIT(); //####
 } // EntitiesPanel::addEntity
 
@@ -180,54 +725,28 @@ EntitiesPanel::adjustSize(const bool andRepaint)
     if (within)
     {
         ODL_LOG("(within)"); //####
-        int  outerW = within->getMaximumVisibleWidth();
-        int  outerH = within->getMaximumVisibleHeight();
-        int  outerL = within->getViewPositionX();
-        int  outerT = within->getViewPositionY();
-        int  minX = -1;
-        int  maxX = -1;
-        int  minY = -1;
-        int  maxY = -1;
-        bool haveValues = false;
+        int outerW = within->getMaximumVisibleWidth();
+        int outerH = within->getMaximumVisibleHeight();
+        int outerL = within->getViewPositionX();
+        int outerT = within->getViewPositionY();
 
         ODL_LL4("outerL = ", outerL, "outerT = ", outerT, "outerW = ", outerW, //####
                 "outerH = ", outerH); //####
-        for (ContainerList::const_iterator it(_knownEntities.begin());
-             _knownEntities.end() != it; ++it)
+        if (! _contentBoundsValid)
         {
-            ChannelContainer * anEntity = *it;
-
-            if (anEntity)
-            {
-                juce::Rectangle<int> entityBounds(anEntity->getBounds());
-                int                  entityLeft = entityBounds.getX();
-                int                  entityTop = entityBounds.getY();
-                int                  entityRight = entityLeft + entityBounds.getWidth();
-                int                  entityBottom = entityTop + entityBounds.getHeight();
-
-                ODL_LL4("eB.x = ", entityBounds.getX(), "eB.y = ", entityBounds.getY(), //####
-                        "eB.w = ", entityBounds.getWidth(), "eB.h = ", //####
-                        entityBounds.getHeight()); //####
-                if (haveValues)
-                {
-                    minX = jmin(minX, entityLeft);
-                    maxX = jmax(maxX, entityRight);
-                    minY = jmin(minY, entityTop);
-                    maxY = jmax(maxY, entityBottom);
-                }
-                else
-                {
-                    minX = entityLeft;
-                    maxX = entityRight;
-                    minY = entityTop;
-                    maxY = entityBottom;
-                    haveValues = true;
-                }
-            }
+            recalculateContentBounds();
         }
-        if (haveValues)
+        if (! _contentBounds.isEmpty())
         {
-            ODL_LOG("(haveValues)"); //####
+            ODL_LOG("(! _contentBounds.isEmpty())"); //####
+            // The panel is sized to fit the entities as they are displayed, after zooming.
+            juce::Rectangle<int> zoomedBounds((_contentBounds.toFloat() *
+                                               _zoom).getSmallestIntegerContainer());
+            int                  minX = zoomedBounds.getX();
+            int                  maxX = zoomedBounds.getRight();
+            int                  minY = zoomedBounds.getY();
+            int                  maxY = zoomedBounds.getBottom();
+
             ODL_LL4("minX = ", minX, "maxX = ", maxX, "minY = ", minY, "maxY = ", maxY); //####
             juce::Rectangle<int> oldBounds(getBounds());
             int                  minLeft = jmin(0, minX);
@@ -238,56 +757,57 @@ EntitiesPanel::adjustSize(const bool andRepaint)
 
             ODL_LL4("minLeft = ", minLeft, "minTop = ", minTop, "maxRight = ", maxRight, //####
                     "maxBottom = ", maxBottom); //####
+            // The scrollbars only need to be adjusted if the extent of the panel has changed.
             if (oldBounds != newBounds)
             {
                 ODL_LOG("about to call setBounds()"); //####
                 setBounds(newBounds);
-            }
-            ScrollBar *          horizBar = within->getHorizontalScrollBar();
-            ScrollBar *          vertBar = within->getVerticalScrollBar();
-            juce::Rectangle<int> currBounds(getBounds());
-            int                  currX = currBounds.getX();
-            int                  currY = currBounds.getY();
-            int                  currW = currBounds.getWidth();
-            int                  currH = currBounds.getHeight();
-
-            ODL_LL4("currX = ", currX, "currY = ", currY, "currW = ", currW, "currH = ", //####
-                    currH); //####
-            if (vertBar)
-            {
-                ODL_LL2("CR.y = ", outerT, "CR.h = ", outerH); //####
-                Range<double> currLimits(vertBar->getRangeLimit());
-                Range<double> currRange(vertBar->getCurrentRange());
-                Range<double> newLimits(currY, currY + currH);
-                Range<double> newRange(outerT, outerH);
-
-                if (currLimits != newLimits)
-                {
-                    vertBar->setRangeLimits(newLimits);
-                }
-                if (currRange != newRange)
-                {
-                    vertBar->setCurrentRange(newRange);
-                }
-            }
-            if (horizBar)
-            {
-                ODL_LL2("CR.x = ", outerL, "CR.w = ", outerW); //####
-                Range<double> currLimits(horizBar->getRangeLimit());
-                Range<double> currRange(horizBar->getCurrentRange());
-                Range<double> newLimits(currX, currX + currW);
-                Range<double> newRange(outerL, outerW);
-
-                if (currLimits != newLimits)
+                ScrollBar *          horizBar = within->getHorizontalScrollBar();
+                ScrollBar *          vertBar = within->getVerticalScrollBar();
+                juce::Rectangle<int> currBounds(getBounds());
+                int                  currX = currBounds.getX();
+                int                  currY = currBounds.getY();
+                int                  currW = currBounds.getWidth();
+                int                  currH = currBounds.getHeight();
+
+                ODL_LL4("currX = ", currX, "currY = ", currY, "currW = ", currW, //####
+                        "currH = ", currH); //####
+                if (vertBar)
                 {
-                    horizBar->setRangeLimits(newLimits);
+                    ODL_LL2("CR.y = ", outerT, "CR.h = ", outerH); //####
+                    Range<double> currLimits(vertBar->getRangeLimit());
+                    Range<double> currRange(vertBar->getCurrentRange());
+                    Range<double> newLimits(currY, currY + currH);
+                    Range<double> newRange(outerT, outerH);
+
+                    if (currLimits != newLimits)
+                    {
+                        vertBar->setRangeLimits(newLimits);
+                    }
+                    if (currRange != newRange)
+                    {
+                        vertBar->setCurrentRange(newRange);
+                    }
                 }
-                if (currRange != newRange)
+                if (horizBar)
                 {
-                    horizBar->setCurrentRange(newRange);
+                    ODL_LL2("CR.x = ", outerL, "CR.w = ", outerW); //####
+                    Range<double> currLimits(horizBar->getRangeLimit());
+                    Range<double> currRange(horizBar->getCurrentRange());
+                    Range<double> newLimits(currX, currX + currW);
+                    Range<double> newRange(outerL, outerW);
+
+                    if (currLimits != newLimits)
+                    {
+                        horizBar->setRangeLimits(newLimits);
+                    }
+                    if (currRange != newRange)
+                    {
+                        horizBar->setCurrentRange(newRange);
+                    }
                 }
+                within->setViewPosition(outerL, outerT);
             }
-            within->setViewPosition(outerL, outerT);
             if (andRepaint)
             {
                 within->repaint();
@@ -297,6 +817,130 @@ EntitiesPanel::adjustSize(const bool andRepaint)
     ODL_OBJEXIT(); //####
 } // EntitiesPanel::adjustSize
 
+void
+EntitiesPanel::applySearch(void)
+{
+    ODL_OBJENTER(); //####
+    bool            searchIsActive = (0 < _searchText.length());
+    ContainerSet    candidates;
+    ContainerSet    previousMatches;
+    ChannelEntrySet previousPorts;
+
+    previousMatches.swap(_searchMatches);
+    previousPorts.swap(_matchingPorts);
+    if (kSearchSequenceLength <= _searchText.length())
+    {
+        std::set<YarpString>                sequences;
+        ContainerTrigramMap::const_iterator fewest(_searchTrigrams.end());
+        bool                                allPresent = true;
+
+        // Only the entities that contain the least common sequence of the search text can match.
+        getSearchSequences(_searchText, sequences);
+        for (std::set<YarpString>::const_iterator walker(sequences.begin());
+             allPresent && (sequences.end() != walker); ++walker)
+        {
+            ContainerTrigramMap::const_iterator match(_searchTrigrams.find(*walker));
+
+            if (_searchTrigrams.end() == match)
+            {
+                allPresent = false;
+            }
+            else if ((_searchTrigrams.end() == fewest) ||
+                     (fewest->second.size() > match->second.size()))
+            {
+                fewest = match;
+            }
+        }
+        if (allPresent && (_searchTrigrams.end() != fewest))
+        {
+            candidates = fewest->second;
+        }
+    }
+    else if (searchIsActive)
+    {
+        // The search text is too short to use the index, so every entity has to be checked.
+        for (ContainerTextMap::const_iterator walker(_searchTexts.begin());
+             _searchTexts.end() != walker; ++walker)
+        {
+            candidates.insert(walker->first);
+        }
+    }
+    // The new matches are left undimmed as they are found.
+    for (ContainerSet::const_iterator walker(candidates.begin()); candidates.end() != walker;
+         ++walker)
+    {
+        matchSearch(*walker);
+    }
+    if (searchIsActive != _searchIsApplied)
+    {
+        // Starting or ending a search changes every entity.
+        for (ContainerList::const_iterator it(_knownEntities.begin()); _knownEntities.end() != it;
+             ++it)
+        {
+            ChannelContainer * anEntity = *it;
+
+            if (anEntity)
+            {
+                anEntity->setDimmed(searchIsActive &&
+                                    (_searchMatches.end() == _searchMatches.find(anEntity)));
+            }
+        }
+        _searchIsApplied = searchIsActive;
+        repaint();
+    }
+    else if (searchIsActive)
+    {
+        juce::Rectangle<int> damagedArea;
+
+        // Only the entities that have stopped or started matching, and their connections, need to
+        // be redrawn.
+        for (ContainerSet::const_iterator walker(previousMatches.begin());
+             previousMatches.end() != walker; ++walker)
+        {
+            ChannelContainer * anEntity = *walker;
+
+            if (_searchMatches.end() == _searchMatches.find(anEntity))
+            {
+                anEntity->setDimmed(true);
+                damagedArea = damagedArea.getUnion(anEntity->getIncidentBounds());
+            }
+        }
+        for (ContainerSet::const_iterator walker(_searchMatches.begin());
+             _searchMatches.end() != walker; ++walker)
+        {
+            ChannelContainer * anEntity = *walker;
+
+            if (previousMatches.end() == previousMatches.find(anEntity))
+            {
+                damagedArea = damagedArea.getUnion(anEntity->getIncidentBounds());
+            }
+        }
+        // A port that has stopped or started matching is drawn differently, even if its entity
+        // still matches.
+        for (ChannelEntrySet::const_iterator walker(previousPorts.begin());
+             previousPorts.end() != walker; ++walker)
+        {
+            if (_matchingPorts.end() == _matchingPorts.find(*walker))
+            {
+                (*walker)->repaintEntry();
+            }
+        }
+        for (ChannelEntrySet::const_iterator walker(_matchingPorts.begin());
+             _matchingPorts.end() != walker; ++walker)
+        {
+            if (previousPorts.end() == previousPorts.find(*walker))
+            {
+                (*walker)->repaintEntry();
+            }
+        }
+        if (! damagedArea.isEmpty())
+        {
+            repaintUnscaledArea(damagedArea);
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::applySearch
+
 void
 EntitiesPanel::clearAllNewlyCreatedFlags(void)
 {
@@ -357,9 +1001,8 @@ EntitiesPanel::clearMarkers(void)
     ODL_OBJEXIT(); //####
 } // EntitiesPanel::clearMarkers
 
-#if defined(USE_OGDF_POSITIONING_)
 void
-EntitiesPanel::clearNodeValues(void)
+EntitiesPanel::clearOutData(void)
 {
     ODL_OBJENTER(); //####
     for (ContainerList::const_iterator it(_knownEntities.begin()); _knownEntities.end() != it; ++it)
@@ -368,34 +1011,78 @@ EntitiesPanel::clearNodeValues(void)
 
         if (anEntity)
         {
-            anEntity->setNode(NULL);
+            delete anEntity;
         }
     }
-
+    removeAllChildren();
+    _knownPorts.clear();
+    _knownEntities.clear();
+    _hostGroups.clear();
+    _searchTexts.clear();
+    _searchTrigrams.clear();
+    _searchMatches.clear();
+    _matchingPorts.clear();
+    _connectionGrid.clear();
+    _entityGrid.clear();
+    _indexedConnectionBounds.clear();
+    _indexedEntityBounds.clear();
+    _contentBounds = juce::Rectangle<int>();
+    _contentBoundsValid = true;
     ODL_OBJEXIT(); //####
-} // EntitiesPanel::clearNodeValues
-#endif // defined(USE_OGDF_POSITIONING_)
+} // EntitiesPanel::clearOutData
 
 void
-EntitiesPanel::clearOutData(void)
+EntitiesPanel::countDrawnItems(const juce::Rectangle<int> & clipArea,
+                               DrawingCounts &              counts)
 {
     ODL_OBJENTER(); //####
+    ODL_P2("clipArea = ", &clipArea, "counts = ", &counts); //####
+    ContainerSet         candidates;
+    juce::Rectangle<int> drawArea((clipArea.toFloat() / _zoom).getSmallestIntegerContainer());
+
+    // The entity index is in unscaled coordinates, while the clip area has been scaled.
+    if (! _visibleArea.isEmpty())
+    {
+        juce::Rectangle<float> unscaledArea(_visibleArea.toFloat() / _zoom);
+
+        drawArea = drawArea.getIntersection(unscaledArea.getSmallestIntegerContainer());
+    }
+    counts._connectionsDrawn = _connectionsDrawn;
+    counts._connectionsTotal = getNumberOfConnections();
+    counts._entitiesDrawn = counts._portsDrawn = 0;
+    counts._entitiesTotal = _knownEntities.size();
+    counts._portsTotal = 0;
     for (ContainerList::const_iterator it(_knownEntities.begin()); _knownEntities.end() != it; ++it)
     {
         ChannelContainer * anEntity = *it;
 
         if (anEntity)
         {
-            delete anEntity;
+            counts._portsTotal += anEntity->getNumPorts();
         }
     }
-    removeAllChildren();
-    _knownPorts.clear();
-    _knownEntities.clear();
-    ODL_OBJEXIT(); //####
-} // EntitiesPanel::clearOutData
+    if (! drawArea.isEmpty())
+    {
+        gatherFromGrid(_entityGrid, drawArea, candidates);
+    }
+    for (ContainerSet::const_iterator it(candidates.begin()); candidates.end() != it; ++it)
+    {
+        ChannelContainer * anEntity = *it;
 
-void
+        if (anEntity && anEntity->isVisible() && anEntity->getBounds().intersects(drawArea))
+        {
+            ++counts._entitiesDrawn;
+            // The ports are not drawn when the entities are shown as glyphs.
+            if (! _showGlyphs)
+            {
+                counts._portsDrawn += anEntity->getNumPorts();
+            }
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::countDrawnItems
+
+void
 EntitiesPanel::displayAndProcessPopupMenu(void)
 {
     ODL_OBJENTER(); //####
@@ -420,15 +1107,65 @@ EntitiesPanel::drawConnections(Graphics & gg)
 {
     ODL_OBJENTER(); //####
     ODL_P1("gg = ", &gg); //####
-    for (ContainerList::const_iterator it(_knownEntities.begin()); _knownEntities.end() != it; ++it)
+    ContainerSet         groupedSources;
+    ContainerSet         visibleSources;
+    AffineTransform      toPanel(AffineTransform::scale(_zoom));
+    juce::Rectangle<int> drawArea;
+
+    // The connections are calculated in unscaled coordinates, as are the spatial indices.
+    gg.addTransform(toPanel);
+    drawArea = gg.getClipBounds();
+    // Nothing outside of the viewport can be seen, even if the clip region is larger.
+    if (! _visibleArea.isEmpty())
     {
-        ChannelContainer * anEntity = *it;
+        juce::Rectangle<float> unscaledArea(_visibleArea.toFloat() / _zoom);
 
-        if (anEntity)
+        drawArea = drawArea.getIntersection(unscaledArea.getSmallestIntegerContainer());
+    }
+    _connectionsDrawn = 0;
+    // Only the entities with connections that might overlap the area being drawn need to be asked
+    // to draw them.
+    if (! drawArea.isEmpty())
+    {
+        gatherFromGrid(_connectionGrid, drawArea, visibleSources);
+        // The indexed bounds of the ports in a collapsed host group don't match where their
+        // connections are drawn, so they are always included.
+        for (HostGroupMap::const_iterator walker(_hostGroups.begin());
+             _hostGroups.end() != walker; ++walker)
         {
-            anEntity->drawOutgoingConnections(gg);
+            ChannelContainer * aGroup = walker->second;
+
+            if (aGroup->isCollapsed() && aGroup->isVisible())
+            {
+                const ContainerList & members = aGroup->getGroupMembers();
+
+                groupedSources.insert(members.begin(), members.end());
+            }
         }
     }
+    if (_showGlyphs)
+    {
+        visibleSources.insert(groupedSources.begin(), groupedSources.end());
+        _connectionsDrawn = drawMergedConnections(gg, drawArea, visibleSources, false);
+    }
+    else
+    {
+        for (ContainerSet::const_iterator it(visibleSources.begin()); visibleSources.end() != it;
+             ++it)
+        {
+            ChannelContainer * anEntity = *it;
+
+            if (anEntity)
+            {
+                _connectionsDrawn += anEntity->drawOutgoingConnections(gg, drawArea);
+            }
+        }
+        if (! groupedSources.empty())
+        {
+            _connectionsDrawn += drawMergedConnections(gg, drawArea, groupedSources, true);
+        }
+    }
+    ODL_LL1("_connectionsDrawn <- ", _connectionsDrawn); //####
     if (_dragConnectionActive && _firstAddPoint)
     {
         _firstAddPoint->drawDragLine(gg, _dragPosition, _firstAddPoint->wasUdpConnectionRequest(),
@@ -437,6 +1174,123 @@ EntitiesPanel::drawConnections(Graphics & gg)
     ODL_OBJEXIT(); //####
 } // EntitiesPanel::drawConnections
 
+size_t
+EntitiesPanel::drawMergedConnections(Graphics &                   gg,
+                                     const juce::Rectangle<int> & drawArea,
+                                     const ContainerSet &         sources,
+                                     const bool                   groupedOnly)
+{
+    ODL_OBJENTER(); //####
+    ODL_P3("gg = ", &gg, "drawArea = ", &drawArea, "sources = ", &sources); //####
+    ODL_B1("groupedOnly = ", groupedOnly); //####
+    ContainerPairCounts counts;
+    size_t              result = 0;
+
+    // Collect the number of connections between each pair of visible entities, ignoring the
+    // direction of the connections.
+    for (ContainerSet::const_iterator it(sources.begin()); sources.end() != it; ++it)
+    {
+        ChannelContainer * anEntity = *it;
+        ChannelContainer * thisEnd = (anEntity ? anEntity->getRepresentative() : NULL);
+
+        if (thisEnd && thisEnd->isVisible())
+        {
+            bool isGrouped = (thisEnd != anEntity);
+
+            for (int ii = 0, mm = anEntity->getNumPorts(); mm > ii; ++ii)
+            {
+                ChannelEntry * aPort = anEntity->getPort(ii);
+
+                if (aPort)
+                {
+                    const ChannelConnections & inputs = aPort->getInputConnections();
+                    const ChannelConnections & outputs = aPort->getOutputConnections();
+
+                    for (ChannelConnections::const_iterator walker(outputs.begin());
+                         outputs.end() != walker; ++walker)
+                    {
+                        ChannelEntry *     otherPort = walker->_otherChannel;
+                        ChannelContainer * otherEntity = (otherPort ? otherPort->getParent() :
+                                                          NULL);
+                        ChannelContainer * otherEnd = (otherEntity ?
+                                                       otherEntity->getRepresentative() : NULL);
+
+                        if (otherEnd && (otherEnd != thisEnd) && otherEnd->isVisible() &&
+                            ((! groupedOnly) || isGrouped || (otherEnd != otherEntity)))
+                        {
+                            if (thisEnd < otherEnd)
+                            {
+                                ++counts[ContainerPair(thisEnd, otherEnd)];
+                            }
+                            else
+                            {
+                                ++counts[ContainerPair(otherEnd, thisEnd)];
+                            }
+                        }
+                    }
+                    // The incoming connections of a grouped port are counted here unless they
+                    // were already counted as the outgoing connections of another source.
+                    for (ChannelConnections::const_iterator walker(inputs.begin());
+                         isGrouped && (inputs.end() != walker); ++walker)
+                    {
+                        ChannelEntry *     otherPort = walker->_otherChannel;
+                        ChannelContainer * otherEntity = (otherPort ? otherPort->getParent() :
+                                                          NULL);
+                        ChannelContainer * otherEnd = (otherEntity ?
+                                                       otherEntity->getRepresentative() : NULL);
+
+                        if (otherEnd && (otherEnd != thisEnd) && otherEnd->isVisible() &&
+                            (sources.end() == sources.find(otherEntity)))
+                        {
+                            if (thisEnd < otherEnd)
+                            {
+                                ++counts[ContainerPair(thisEnd, otherEnd)];
+                            }
+                            else
+                            {
+                                ++counts[ContainerPair(otherEnd, thisEnd)];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    gg.setColour(kMergedConnectionColour);
+    for (ContainerPairCounts::const_iterator walker(counts.begin()); counts.end() != walker;
+         ++walker)
+    {
+        juce::Rectangle<int> firstBounds(walker->first.first->getBounds());
+        juce::Rectangle<int> secondBounds(walker->first.second->getBounds());
+
+        if (drawArea.intersects(firstBounds.getUnion(secondBounds)))
+        {
+            // The width grows slowly with the number of connections, and is kept legible
+            // regardless of the zoom level.
+            double      weight = 1 + log(static_cast<double>(walker->second));
+            float       width = static_cast<float>((kMergedConnectionWidth * weight) / _zoom);
+            Line<float> aLine(firstBounds.getCentre().toFloat(),
+                              secondBounds.getCentre().toFloat());
+
+            gg.drawLine(aLine, width);
+            ++result;
+        }
+    }
+    ODL_OBJEXIT_LL(result); //####
+    return result;
+} // EntitiesPanel::drawMergedConnections
+
+void
+EntitiesPanel::findEntitiesInArea(const juce::Rectangle<int> & area,
+                                  ContainerSet &               found)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("found = ", &found); //####
+    gatherFromGrid(_entityGrid, area, found);
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::findEntitiesInArea
+
 ChannelContainer *
 EntitiesPanel::findKnownEntity(const YarpString & name)
 {
@@ -484,6 +1338,52 @@ EntitiesPanel::findKnownPort(const YarpString & name)
     return result;
 } // EntitiesPanel::findKnownPort
 
+ChannelContainer *
+EntitiesPanel::findNextSearchMatch(ChannelContainer * current,
+                                   const bool         forward)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("current = ", current); //####
+    ODL_B1("forward = ", forward); //####
+    ChannelContainer * result = NULL;
+    ContainerList      ordered;
+
+    // Ports in a collapsed host group are reached through the group.
+    for (ContainerSet::const_iterator walker(_searchMatches.begin());
+         _searchMatches.end() != walker; ++walker)
+    {
+        ChannelContainer * anEntity = (*walker)->getRepresentative();
+
+        if (anEntity->isVisible() && (! anEntity->isHiddenByGroup()))
+        {
+            ordered.push_back(anEntity);
+        }
+    }
+    std::sort(ordered.begin(), ordered.end(), isBeforeInReadingOrder);
+    ordered.erase(std::unique(ordered.begin(), ordered.end()), ordered.end());
+    if (! ordered.empty())
+    {
+        ContainerList::const_iterator match(std::find(ordered.begin(), ordered.end(), current));
+
+        if (ordered.end() == match)
+        {
+            result = (forward ? ordered.front() : ordered.back());
+        }
+        else if (forward)
+        {
+            ++match;
+            result = ((ordered.end() == match) ? ordered.front() : *match);
+        }
+        else
+        {
+            result = ((ordered.begin() == match) ? ordered.back() : *(match - 1));
+        }
+    }
+    ODL_OBJEXIT_P(result); //####
+    return result;
+} // EntitiesPanel::findNextSearchMatch
+
 void
 EntitiesPanel::forgetPort(ChannelEntry * aPort)
 {
@@ -491,6 +1391,11 @@ EntitiesPanel::forgetPort(ChannelEntry * aPort)
     ODL_P1("aPort = ", aPort); //####
     if (aPort)
     {
+        // A port that is going away can't be monitored, so the monitoring is turned off.
+        if (aPort->isBeingMonitored() && _container)
+        {
+            _container->toggleActivityIndicator(*aPort);
+        }
         YarpString                aPortName(aPort->getName().toStdString().c_str());
         ChannelEntryMap::iterator match(_knownPorts.find(aPortName));
 
@@ -535,6 +1440,34 @@ const
     return result;
 } // EntitiesPanel::getEntity
 
+size_t
+EntitiesPanel::getNumberOfConnections(void)
+const
+{
+    ODL_OBJENTER(); //####
+    size_t count = 0;
+
+    for (ContainerList::const_iterator it(_knownEntities.begin()); _knownEntities.end() != it; ++it)
+    {
+        ChannelContainer * anEntity = *it;
+
+        if (anEntity)
+        {
+            for (int ii = 0, mm = anEntity->getNumPorts(); mm > ii; ++ii)
+            {
+                ChannelEntry * aPort = anEntity->getPort(ii);
+
+                if (aPort)
+                {
+                    count += aPort->getOutputConnections().size();
+                }
+            }
+        }
+    }
+    ODL_OBJEXIT_LL(count); //####
+    return count;
+} // EntitiesPanel::getNumberOfConnections
+
 size_t
 EntitiesPanel::getNumberOfEntities(void)
 const
@@ -557,7 +1490,8 @@ const
     {
         ChannelContainer * anEntity = *it;
 
-        if (anEntity && (! anEntity->isVisible()))
+        // Entities that are hidden because of their host group can't be unhidden directly.
+        if (anEntity && (! anEntity->isVisible()) && (! anEntity->isHiddenByGroup()))
         {
             ++count;
         }
@@ -587,22 +1521,81 @@ EntitiesPanel::locateEntry(const Position & location)
 const
 {
     ODL_OBJENTER(); //####
-    ChannelEntry * result = NULL;
-
-    for (ContainerList::const_iterator it(_knownEntities.begin());
-         (! result) && (_knownEntities.end() != it); ++it)
+    ChannelEntry *     result = NULL;
+    ChannelContainer * topEntity = NULL;
+    ContainerSet       candidates;
+    int                topIndex = -1;
+    Point<int>         where(location.toInt());
+
+    gatherFromGrid(_entityGrid, juce::Rectangle<int>(where.getX(), where.getY(), 1, 1),
+                   candidates);
+    // The candidates are ordered by address, so the entity that is drawn on top is the one with
+    // the highest position among the children of the panel.
+    for (ContainerSet::const_iterator it(candidates.begin()); candidates.end() != it; ++it)
     {
         ChannelContainer * anEntity = *it;
 
-        if (anEntity)
+        if (anEntity && anEntity->isVisible() && anEntity->getBounds().contains(where))
         {
-            result = anEntity->locateEntry(location);
+            int index = getIndexOfChildComponent(anEntity);
+
+            if (topIndex < index)
+            {
+                topEntity = anEntity;
+                topIndex = index;
+            }
         }
     }
+    if (topEntity)
+    {
+        result = topEntity->locateEntry(location);
+    }
     ODL_OBJEXIT_P(result); //####
     return result;
 } // EntitiesPanel::locateEntry
 
+bool
+EntitiesPanel::matchSearch(ChannelContainer * anEntity)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("anEntity = ", anEntity); //####
+    bool                             result = false;
+    ContainerTextMap::const_iterator match(_searchTexts.find(anEntity));
+
+    if ((_searchTexts.end() != match) && (YarpString::npos != match->second.find(_searchText)))
+    {
+        ChannelContainer * aGroup = anEntity->getHostGroup();
+
+        result = true;
+        _searchMatches.insert(anEntity);
+        anEntity->setDimmed(false);
+        for (int ii = 0, mm = anEntity->getNumPorts(); mm > ii; ++ii)
+        {
+            ChannelEntry * aPort = anEntity->getPort(ii);
+
+            if (aPort)
+            {
+                String portText(String(aPort->getPortName().c_str()) + "\n" +
+                                aPort->getPortNumber().c_str());
+
+                if (portText.toLowerCase().contains(_searchText.c_str()))
+                {
+                    _matchingPorts.insert(aPort);
+                }
+            }
+        }
+        // A collapsed host group stands in for its ports, so it must not be dimmed if one of
+        // them matches.
+        if (aGroup)
+        {
+            _searchMatches.insert(aGroup);
+            aGroup->setDimmed(false);
+        }
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // EntitiesPanel::matchSearch
+
 #if (! MAC_OR_LINUX_)
 # pragma warning(push)
 # pragma warning(disable: 4100)
@@ -659,10 +1652,56 @@ EntitiesPanel::paint(Graphics & gg)
 {
     ODL_OBJENTER(); //####
     ODL_P1("gg = ", &gg); //####
+    _paintStartTicks = Time::getHighResolutionTicks();
     drawConnections(gg);
+    ODL_LL2("connections drawn = ", _connectionsDrawn, "connections = ", //####
+            getNumberOfConnections()); //####
     ODL_OBJEXIT(); //####
 } // EntitiesPanel::paint
 
+void
+EntitiesPanel::paintOverChildren(Graphics & gg)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("gg = ", &gg); //####
+    // The entities are drawn between paint() and paintOverChildren(), so this covers a full frame.
+    double elapsedTime = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() -
+                                                            _paintStartTicks);
+
+    _paintTimeTotal += elapsedTime;
+    ++_paintCount;
+    if (_container)
+    {
+        StatisticsOverlay & statistics = _container->getStatistics();
+
+        // Counting the items is not free, so it's only done when the counts will be used.
+        if (statistics.isCollecting())
+        {
+            DrawingCounts counts;
+
+            countDrawnItems(gg.getClipBounds(), counts);
+            statistics.recordFrame(elapsedTime * 1000, counts);
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::paintOverChildren
+
+void
+EntitiesPanel::recalculateContentBounds(void)
+{
+    ODL_OBJENTER(); //####
+    juce::Rectangle<int> newBounds;
+
+    for (ContainerBoundsMap::const_iterator walker(_indexedEntityBounds.begin());
+         _indexedEntityBounds.end() != walker; ++walker)
+    {
+        newBounds = newBounds.getUnion(walker->second);
+    }
+    _contentBounds = newBounds;
+    _contentBoundsValid = true;
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::recalculateContentBounds
+
 void
 EntitiesPanel::recallPositions(void)
 {
@@ -671,6 +1710,14 @@ EntitiesPanel::recallPositions(void)
     ODL_OBJEXIT(); //####
 } // EntitiesPanel::recallPositions
 
+void
+EntitiesPanel::recallTopology(void)
+{
+    ODL_OBJENTER(); //####
+    _container->recallTopology();
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::recallTopology
+
 void
 EntitiesPanel::rememberConnectionStartPoint(ChannelEntry * aPort,
                                             const bool     beingAdded)
@@ -720,6 +1767,34 @@ EntitiesPanel::rememberPositions(void)
     ODL_OBJEXIT(); //####
 } // EntitiesPanel::rememberPositions
 
+void
+EntitiesPanel::rememberTopology(void)
+{
+    ODL_OBJENTER(); //####
+    _container->saveTopology();
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::rememberTopology
+
+void
+EntitiesPanel::removeEntity(ChannelContainer * anEntity)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("anEntity = ", anEntity); //####
+    ContainerList::iterator match(std::find(_knownEntities.begin(), _knownEntities.end(),
+                                            anEntity));
+
+    if (_knownEntities.end() != match)
+    {
+        _container->rememberPositionOfEntity(anEntity);
+        removeFromEntityIndex(anEntity);
+        removeFromSearchIndex(anEntity);
+        removeChildComponent(anEntity);
+        delete anEntity;
+        _knownEntities.erase(match);
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::removeEntity
+
 void
 EntitiesPanel::removeInvalidConnections(void)
 {
@@ -767,10 +1842,7 @@ EntitiesPanel::removeUnvisitedEntities(void)
         if ((_knownEntities.end() != walker) && anEntity)
         {
             ODL_LOG("((_knownEntities.end() != walker) && anEntity)"); //####
-            _container->rememberPositionOfEntity(anEntity);
-            removeChildComponent(anEntity);
-            delete anEntity;
-            _knownEntities.erase(walker);
+            removeEntity(anEntity);
             keepGoing = didRemove = true;
         }
     }
@@ -779,6 +1851,77 @@ EntitiesPanel::removeUnvisitedEntities(void)
     return didRemove;
 } // EntitiesPanel::removeUnvisitedEntities
 
+void
+EntitiesPanel::removeFromEntityIndex(ChannelContainer * anEntity)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("anEntity = ", anEntity); //####
+    ContainerBoundsMap::iterator match(_indexedEntityBounds.find(anEntity));
+
+    if (_indexedEntityBounds.end() != match)
+    {
+        updateContentBounds(match->second, juce::Rectangle<int>());
+        removeFromGrid(_entityGrid, anEntity, match->second);
+        _indexedEntityBounds.erase(match);
+    }
+    match = _indexedConnectionBounds.find(anEntity);
+    if (_indexedConnectionBounds.end() != match)
+    {
+        removeFromGrid(_connectionGrid, anEntity, match->second);
+        _indexedConnectionBounds.erase(match);
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::removeFromEntityIndex
+
+void
+EntitiesPanel::removeFromSearchIndex(ChannelContainer * anEntity)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("anEntity = ", anEntity); //####
+    ContainerTextMap::iterator match(_searchTexts.find(anEntity));
+
+    if (_searchTexts.end() != match)
+    {
+        std::set<YarpString> sequences;
+
+        getSearchSequences(match->second, sequences);
+        for (std::set<YarpString>::const_iterator walker(sequences.begin());
+             sequences.end() != walker; ++walker)
+        {
+            ContainerTrigramMap::iterator entry(_searchTrigrams.find(*walker));
+
+            if (_searchTrigrams.end() != entry)
+            {
+                entry->second.erase(anEntity);
+                if (entry->second.empty())
+                {
+                    _searchTrigrams.erase(entry);
+                }
+            }
+        }
+        _searchTexts.erase(match);
+    }
+    _searchMatches.erase(anEntity);
+    for (int ii = 0, mm = anEntity->getNumPorts(); mm > ii; ++ii)
+    {
+        _matchingPorts.erase(anEntity->getPort(ii));
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::removeFromSearchIndex
+
+void
+EntitiesPanel::repaintUnscaledArea(const juce::Rectangle<int> & area)
+{
+    ODL_OBJENTER(); //####
+    ODL_LL4("area.x = ", area.getX(), "area.y = ", area.getY(), "area.w = ", //####
+            area.getWidth(), "area.h = ", area.getHeight()); //####
+    if (! area.isEmpty())
+    {
+        repaint((area.toFloat() * _zoom).getSmallestIntegerContainer());
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::repaintUnscaledArea
+
 void
 EntitiesPanel::resized(void)
 {
@@ -788,6 +1931,19 @@ EntitiesPanel::resized(void)
     ODL_OBJEXIT(); //####
 } // EntitiesPanel::resized
 
+void
+EntitiesPanel::setAllHostGroupsCollapsed(const bool collapse)
+{
+    ODL_OBJENTER(); //####
+    ODL_B1("collapse = ", collapse); //####
+    for (HostGroupMap::const_iterator walker(_hostGroups.begin()); _hostGroups.end() != walker;
+         ++walker)
+    {
+        setHostGroupCollapsed(walker->second, collapse);
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::setAllHostGroupsCollapsed
+
 void
 EntitiesPanel::setDragInfo(const Position position,
                            const bool     isForced)
@@ -796,13 +1952,165 @@ EntitiesPanel::setDragInfo(const Position position,
     ODL_B1("isForced = ", isForced); //####
     if (_firstAddPoint)
     {
+        juce::Rectangle<int> damagedArea(_firstAddPoint->getDragLineBounds(position));
+
+        if (_dragConnectionActive)
+        {
+            damagedArea = damagedArea.getUnion(_firstAddPoint->getDragLineBounds(_dragPosition));
+        }
         _dragConnectionActive = true;
         _dragIsForced = isForced;
         _dragPosition = position;
+        repaintUnscaledArea(damagedArea);
     }
     ODL_OBJEXIT(); //####
 } // EntitiesPanel::setDragInfo
 
+void
+EntitiesPanel::setEntityImageCaching(const bool cacheImages)
+{
+    ODL_OBJENTER(); //####
+    ODL_B1("cacheImages = ", cacheImages); //####
+    if (0 < _paintCount)
+    {
+        char buffer1[DATE_TIME_BUFFER_SIZE_];
+        char buffer2[DATE_TIME_BUFFER_SIZE_];
+
+        Utilities::GetDateAndTime(buffer1, sizeof(buffer1), buffer2, sizeof(buffer2));
+        std::cerr << buffer1 << " " << buffer2 << " Average paint time with entity images " <<
+                    (_cacheEntityImages ? "cached" : "not cached") << " = " <<
+                    ((_paintTimeTotal * 1000) / _paintCount) << "ms over " << _paintCount <<
+                    " paints" << std::endl;
+    }
+    _paintTimeTotal = 0;
+    _paintCount = 0;
+    _cacheEntityImages = cacheImages;
+    for (ContainerList::const_iterator it(_knownEntities.begin()); _knownEntities.end() != it; ++it)
+    {
+        ChannelContainer * anEntity = *it;
+
+        if (anEntity)
+        {
+            anEntity->setBufferedToImage(cacheImages);
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::setEntityImageCaching
+
+void
+EntitiesPanel::setHostGroupCollapsed(ChannelContainer * aGroup,
+                                     const bool         collapse)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("aGroup = ", aGroup); //####
+    ODL_B1("collapse = ", collapse); //####
+    if (aGroup && (kContainerKindHost == aGroup->getKind()) && (collapse != aGroup->isCollapsed()))
+    {
+        const ContainerList & members = aGroup->getGroupMembers();
+
+        if (collapse)
+        {
+            juce::Rectangle<int> area;
+
+            for (ContainerList::const_iterator walker(members.begin()); members.end() != walker;
+                 ++walker)
+            {
+                ChannelContainer * anEntity = *walker;
+
+                if (anEntity->isVisible())
+                {
+                    area = area.getUnion(anEntity->getBounds());
+                    anEntity->setVisible(false);
+                }
+            }
+            if (! area.isEmpty())
+            {
+                aGroup->setTopLeftPosition(area.getX(), area.getY());
+            }
+            aGroup->setCollapsed(true);
+            aGroup->setVisible(true);
+        }
+        else
+        {
+            Point<int> where(aGroup->getPosition());
+
+            aGroup->setCollapsed(false);
+            aGroup->setVisible(false);
+            for (ContainerList::const_iterator walker(members.begin()); members.end() != walker;
+                 ++walker)
+            {
+                ChannelContainer * anEntity = *walker;
+
+                anEntity->setTopLeftPosition(where.getX(), where.getY());
+                anEntity->setVisible(true);
+                where.addXY(0, anEntity->getHeight() + kHostGroupMemberGap);
+            }
+        }
+        // The selected entity might no longer be visible.
+        if (_container)
+        {
+            _container->setChannelOfInterest(NULL);
+            _container->setContainerOfInterest(NULL);
+        }
+        repaint();
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::setHostGroupCollapsed
+
+void
+EntitiesPanel::setSearchText(const String & searchText)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("searchText = ", searchText.toStdString()); //####
+    YarpString newText(searchText.trim().toLowerCase().toStdString());
+
+    if (newText != _searchText)
+    {
+        _searchText = newText;
+        applySearch();
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::setSearchText
+
+void
+EntitiesPanel::setVisibleArea(const juce::Rectangle<int> & newArea)
+{
+    ODL_OBJENTER(); //####
+    ODL_LL4("nA.x = ", newArea.getX(), "nA.y = ", newArea.getY(), "nA.w = ", //####
+            newArea.getWidth(), "nA.h = ", newArea.getHeight()); //####
+    _visibleArea = newArea;
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::setVisibleArea
+
+void
+EntitiesPanel::setZoom(const float newZoom)
+{
+    ODL_OBJENTER(); //####
+    ODL_D1("newZoom = ", newZoom); //####
+    float actualZoom = jlimit(kMinimumZoom, kMaximumZoom, newZoom);
+
+    if (actualZoom != _zoom)
+    {
+        AffineTransform toPanel(AffineTransform::scale(actualZoom));
+
+        _zoom = actualZoom;
+        _showGlyphs = (kGlyphZoomThreshold > _zoom);
+        for (ContainerList::const_iterator it(_knownEntities.begin());
+             _knownEntities.end() != it; ++it)
+        {
+            ChannelContainer * anEntity = *it;
+
+            if (anEntity)
+            {
+                anEntity->setTransform(toPanel);
+                anEntity->setGlyphMode(_showGlyphs);
+            }
+        }
+        adjustSize(true);
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::setZoom
+
 void
 EntitiesPanel::skipScan(void)
 {
@@ -822,7 +2130,7 @@ EntitiesPanel::unhideEntities(void)
     {
         ChannelContainer * anEntity = *it;
 
-        if (anEntity && (! anEntity->isVisible()))
+        if (anEntity && (! anEntity->isVisible()) && (! anEntity->isHiddenByGroup()))
         {
             anEntity->setHidden();
         }
@@ -831,6 +2139,276 @@ EntitiesPanel::unhideEntities(void)
     ODL_OBJEXIT(); //####
 } // EntitiesPanel::unhideEntities
 
+void
+EntitiesPanel::updateConnectionIndex(ChannelContainer * anEntity)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("anEntity = ", anEntity); //####
+    ContainerBoundsMap::iterator match(_indexedConnectionBounds.find(anEntity));
+    juce::Rectangle<int>         newBounds(anEntity->getOutgoingConnectionBounds());
+
+    if (_indexedConnectionBounds.end() == match)
+    {
+        if (! newBounds.isEmpty())
+        {
+            addToGrid(_connectionGrid, anEntity, newBounds);
+            _indexedConnectionBounds.insert(ContainerBoundsMap::value_type(anEntity, newBounds));
+        }
+    }
+    else if (match->second != newBounds)
+    {
+        removeFromGrid(_connectionGrid, anEntity, match->second);
+        if (newBounds.isEmpty())
+        {
+            _indexedConnectionBounds.erase(match);
+        }
+        else
+        {
+            addToGrid(_connectionGrid, anEntity, newBounds);
+            match->second = newBounds;
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::updateConnectionIndex
+
+void
+EntitiesPanel::updateContentBounds(const juce::Rectangle<int> & oldBounds,
+                                   const juce::Rectangle<int> & newBounds)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("oldBounds = ", &oldBounds, "newBounds = ", &newBounds); //####
+    if (_contentBoundsValid)
+    {
+        // Growth can be handled directly, but if an entity that defined an edge has moved inwards
+        // or gone the bounds must be recalculated, which is deferred until they are needed.
+        if (leavesEdgeOfArea(oldBounds, newBounds, _contentBounds))
+        {
+            _contentBoundsValid = false;
+        }
+        else
+        {
+            _contentBounds = _contentBounds.getUnion(newBounds);
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::updateContentBounds
+
+void
+EntitiesPanel::updateEntityIndex(ChannelContainer * anEntity)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("anEntity = ", anEntity); //####
+    // Entities report their size while they are being constructed, before they have been added.
+    if (anEntity && (this == anEntity->getParentComponent()))
+    {
+        ContainerBoundsMap::iterator match(_indexedEntityBounds.find(anEntity));
+        juce::Rectangle<int>         newBounds(anEntity->getBounds());
+        ContainerSet                 sources;
+
+        if (_indexedEntityBounds.end() == match)
+        {
+            updateContentBounds(juce::Rectangle<int>(), newBounds);
+            addToGrid(_entityGrid, anEntity, newBounds);
+            _indexedEntityBounds.insert(ContainerBoundsMap::value_type(anEntity, newBounds));
+        }
+        else if (match->second != newBounds)
+        {
+            updateContentBounds(match->second, newBounds);
+            removeFromGrid(_entityGrid, anEntity, match->second);
+            addToGrid(_entityGrid, anEntity, newBounds);
+            match->second = newBounds;
+        }
+        updateConnectionIndex(anEntity);
+        // The incoming connections belong to other entities, but their extents depend on this one.
+        for (int ii = 0, mm = anEntity->getNumPorts(); mm > ii; ++ii)
+        {
+            ChannelEntry * aPort = anEntity->getPort(ii);
+
+            if (aPort)
+            {
+                const ChannelConnections & inputs(aPort->getInputConnections());
+
+                for (ChannelConnections::const_iterator walker(inputs.begin());
+                     inputs.end() != walker; ++walker)
+                {
+                    if (walker->_otherChannel)
+                    {
+                        ChannelContainer * otherEntity = walker->_otherChannel->getParent();
+
+                        if (otherEntity && (otherEntity != anEntity) &&
+                            (this == otherEntity->getParentComponent()))
+                        {
+                            sources.insert(otherEntity);
+                        }
+                    }
+                }
+            }
+        }
+        for (ContainerSet::const_iterator it(sources.begin()); sources.end() != it; ++it)
+        {
+            updateConnectionIndex(*it);
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::updateEntityIndex
+
+void
+EntitiesPanel::updateEntityIndexForAll(void)
+{
+    ODL_OBJENTER(); //####
+    _connectionGrid.clear();
+    _entityGrid.clear();
+    _indexedConnectionBounds.clear();
+    _indexedEntityBounds.clear();
+    // Any of the entities may have moved, so the content bounds are recalculated when they are
+    // next needed.
+    _contentBoundsValid = false;
+    for (ContainerList::const_iterator it(_knownEntities.begin()); _knownEntities.end() != it; ++it)
+    {
+        ChannelContainer * anEntity = *it;
+
+        if (anEntity)
+        {
+            juce::Rectangle<int> entityBounds(anEntity->getBounds());
+
+            addToGrid(_entityGrid, anEntity, entityBounds);
+            _indexedEntityBounds.insert(ContainerBoundsMap::value_type(anEntity, entityBounds));
+            updateConnectionIndex(anEntity);
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::updateEntityIndexForAll
+
+void
+EntitiesPanel::updateHostGroups(void)
+{
+    ODL_OBJENTER(); //####
+    std::map<YarpString, ContainerList> portsByHost;
+
+    for (ContainerList::const_iterator it(_knownEntities.begin()); _knownEntities.end() != it; ++it)
+    {
+        ChannelContainer * anEntity = *it;
+
+        if (anEntity && (kContainerKindOther == anEntity->getKind()) && anEntity->wasVisited())
+        {
+            portsByHost[anEntity->getIPAddress()].push_back(anEntity);
+        }
+    }
+    // Dissolve the groups that no longer have enough ports; their stand-ins weren't visited, so
+    // they will be removed along with the other unvisited entities.
+    for (HostGroupMap::iterator walker(_hostGroups.begin()); _hostGroups.end() != walker; )
+    {
+        std::map<YarpString, ContainerList>::const_iterator match(portsByHost.find(walker->first));
+
+        if ((portsByHost.end() == match) || (kMinimumHostGroupSize > match->second.size()))
+        {
+            ChannelContainer *    aGroup = walker->second;
+            const ContainerList & members = aGroup->getGroupMembers();
+
+            for (ContainerList::const_iterator it(members.begin()); members.end() != it; ++it)
+            {
+                ChannelContainer * anEntity = *it;
+
+                anEntity->setHostGroup(NULL);
+                if (aGroup->isCollapsed())
+                {
+                    anEntity->setTopLeftPosition(aGroup->getX(), aGroup->getY());
+                    anEntity->setVisible(true);
+                }
+            }
+            _hostGroups.erase(walker++);
+        }
+        else
+        {
+            ++walker;
+        }
+    }
+    for (std::map<YarpString, ContainerList>::const_iterator walker(portsByHost.begin());
+         portsByHost.end() != walker; ++walker)
+    {
+        if (kMinimumHostGroupSize <= walker->second.size())
+        {
+            ChannelContainer *     aGroup;
+            HostGroupMap::iterator match(_hostGroups.find(walker->first));
+
+            if (_hostGroups.end() == match)
+            {
+                aGroup = new ChannelContainer(kContainerKindHost, walker->first, walker->first, "",
+                                              "", "", "", *this);
+                aGroup->setCollapsed(true);
+                addEntity(aGroup);
+                _hostGroups.insert(HostGroupMap::value_type(walker->first, aGroup));
+            }
+            else
+            {
+                aGroup = match->second;
+            }
+            juce::Rectangle<int> area;
+
+            aGroup->setVisited();
+            for (ContainerList::const_iterator it(walker->second.begin());
+                 walker->second.end() != it; ++it)
+            {
+                ChannelContainer * anEntity = *it;
+
+                if (aGroup != anEntity->getHostGroup())
+                {
+                    if ((! anEntity->isNew()) && anEntity->isVisible())
+                    {
+                        area = area.getUnion(anEntity->getBounds());
+                    }
+                    anEntity->setHostGroup(aGroup);
+                    if (aGroup->isCollapsed())
+                    {
+                        anEntity->setVisible(false);
+                    }
+                }
+            }
+            // A new group takes the place of any of its ports that were already displayed, rather
+            // than being laid out.
+            if (aGroup->isNew() && (! area.isEmpty()))
+            {
+                aGroup->setTopLeftPosition(area.getX(), area.getY());
+                aGroup->setOld();
+            }
+            aGroup->setGroupMembers(walker->second);
+        }
+    }
+    // Group membership decides which stand-ins are left undimmed by a search, so the search is
+    // redone now that the members have been assigned.
+    if (0 < _searchText.length())
+    {
+        applySearch();
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::updateHostGroups
+
+void
+EntitiesPanel::updateSearchIndex(ChannelContainer * anEntity)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("anEntity = ", anEntity); //####
+    if (anEntity)
+    {
+        std::set<YarpString> sequences;
+        YarpString           searchText(getSearchTextForEntity(anEntity));
+
+        removeFromSearchIndex(anEntity);
+        _searchTexts[anEntity] = searchText;
+        getSearchSequences(searchText, sequences);
+        for (std::set<YarpString>::const_iterator walker(sequences.begin());
+             sequences.end() != walker; ++walker)
+        {
+            _searchTrigrams[*walker].insert(anEntity);
+        }
+        if (0 < _searchText.length())
+        {
+            anEntity->setDimmed(! matchSearch(anEntity));
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // EntitiesPanel::updateSearchIndex
+
 #if defined(__APPLE__)
 # pragma mark Global functions
 #endif // defined(__APPLE__)
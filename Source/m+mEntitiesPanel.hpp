@@ -89,9 +89,12 @@ namespace MPlusM_Manager
         ~EntitiesPanel(void);
 
         /*! @brief Add an entity to the list of known entities.
-         @param[in] anEntity The entity to be added. */
+         @param[in] anEntity The entity to be added.
+         @param[in] reportAddition @c true if the addition is to be logged and @c false
+         otherwise. */
         void
-        addEntity(ChannelContainer * anEntity);
+        addEntity(ChannelContainer * anEntity,
+                  const bool         reportAddition = true);
 
         /*! @brief Recalculate size based on entities present.
          @param[in] andRepaint @c true if a repaint should be performed as well, and @c false if
@@ -115,16 +118,28 @@ namespace MPlusM_Manager
         void
         clearMarkers(void);
 
-# if defined(USE_OGDF_POSITIONING_)
-        /*! @brief Clear any node values. */
-        void
-        clearNodeValues(void);
-# endif // defined(USE_OGDF_POSITIONING_)
-
         /*! @brief Release all data held by the panel. */
         void
         clearOutData(void);
 
+        /*! @brief Return @c true if the rendered images of entities are cached and @c false
+         otherwise.
+         @returns @c true if the rendered images of entities are cached and @c false otherwise. */
+        inline bool
+        entityImagesAreCached(void)
+        const
+        {
+            return _cacheEntityImages;
+        } // entityImagesAreCached
+
+        /*! @brief Collect the entities that might overlap an area.
+         @param[in] area The area of interest.
+         @param[in,out] found The entities that were found. */
+        void
+        findEntitiesInArea(const juce::Rectangle<int> & area,
+                           ContainerSet &               found)
+        const;
+
         /*! @brief Find an entity in the currently-displayed list by name.
          @param[in] name The name of the entity.
          @returns @c NULL if the entity cannot be found and non-@c NULL if it is found. */
@@ -137,6 +152,18 @@ namespace MPlusM_Manager
         ChannelEntry *
         findKnownPort(const YarpString & name);
 
+        /*! @brief Return the match for the active search that follows or precedes an entity.
+         The matches are ordered from top to bottom and then from left to right, and the order
+         wraps around at either end.
+         @param[in] current The entity to start from, or @c NULL to start from either end.
+         @param[in] forward @c true if the following match is wanted and @c false if the
+         preceding match is wanted.
+         @returns The match or @c NULL if there are no visible matches. */
+        ChannelContainer *
+        findNextSearchMatch(ChannelContainer * current,
+                            const bool         forward)
+        const;
+
         /*! @brief Remove a port from the set of known ports.
          @param[in] aPort The port to be removed. */
         void
@@ -150,6 +177,24 @@ namespace MPlusM_Manager
             return *_defaultBoldFont;
         } // getBoldFont
 
+        /*! @brief Return the scale factor applied to the entities and connections.
+         @returns The scale factor applied to the entities and connections. */
+        inline float
+        getZoom(void)
+        const
+        {
+            return _zoom;
+        } // getZoom
+
+        /*! @brief Return the number of connections that were drawn by the most recent paint.
+         @returns The number of connections that were drawn by the most recent paint. */
+        inline size_t
+        getNumberOfConnectionsDrawn(void)
+        const
+        {
+            return _connectionsDrawn;
+        } // getNumberOfConnectionsDrawn
+
         /*! @brief Return the container in which the panel is embedded.
          @returns The container in which the panel is embedded. */
         inline ContentPanel *
@@ -192,12 +237,36 @@ namespace MPlusM_Manager
             return *_defaultNormalFont;
         } // getNormalFont
 
+        /*! @brief Return the number of connections between entities.
+         @returns The number of connections between entities. */
+        size_t
+        getNumberOfConnections(void)
+        const;
+
         /*! @brief Return the number of entities.
          @returns The number of entities. */
         size_t
         getNumberOfEntities(void)
         const;
 
+        /*! @brief Returns the number of hosts whose standalone ports are grouped together.
+         @returns The number of hosts whose standalone ports are grouped together. */
+        inline size_t
+        getNumberOfHostGroups(void)
+        const
+        {
+            return _hostGroups.size();
+        } // getNumberOfHostGroups
+
+        /*! @brief Returns the number of entities that match the active search.
+         @returns The number of entities that match the active search. */
+        inline size_t
+        getNumberOfSearchMatches(void)
+        const
+        {
+            return _searchMatches.size();
+        } // getNumberOfSearchMatches
+
         /*! @brief Returns the number of hidden entities.
          @returns The number of hidden entities. */
         size_t
@@ -217,6 +286,26 @@ namespace MPlusM_Manager
             return _dragConnectionActive;
         } // isDragActive
 
+        /*! @brief Return @c true if a port matches the active search and @c false otherwise.
+         @param[in] aPort The port of interest.
+         @returns @c true if the port matches the active search and @c false otherwise. */
+        inline bool
+        isSearchMatch(ChannelEntry * aPort)
+        const
+        {
+            return (_matchingPorts.end() != _matchingPorts.find(aPort));
+        } // isSearchMatch
+
+        /*! @brief Return @c true if the entities and connections are scaled and @c false
+         otherwise.
+         @returns @c true if the entities and connections are scaled and @c false otherwise. */
+        inline bool
+        isZoomed(void)
+        const
+        {
+            return (1 != _zoom);
+        } // isZoomed
+
         /*! @brief Returns an entry at the given location, if it exists.
          @param[in] location The coordinates to check.
          @returns A pointer to the entry at the given location, or @c NULL if there is none. */
@@ -224,10 +313,21 @@ namespace MPlusM_Manager
         locateEntry(const Position & location)
         const;
 
+        /*! @brief Time the drawing of synthetic sets of entities, ports and connections into an
+         offscreen image and report the results.
+         @returns @c true if every synthetic set was drawn completely and @c false otherwise. */
+        static bool
+        performDrawingBenchmark(void);
+
         /*! @brief Restore the positions of all the entities in the panel. */
         void
         recallPositions(void);
 
+        /*! @brief Display the entities and connections that were known at the end of the previous
+         session, until they are confirmed by a scan. */
+        void
+        recallTopology(void);
+
         /*! @brief Record the initial entry when adding or removing a connection.
          @param[in] aPort The first entry selected.
          @param[in] beingAdded @c true if the connection is being added and @c false if it is being
@@ -245,6 +345,15 @@ namespace MPlusM_Manager
         void
         rememberPositions(void);
 
+        /*! @brief Record the entities and connections in the panel, for the next session. */
+        void
+        rememberTopology(void);
+
+        /*! @brief Remove an entity from the panel and delete it.
+         @param[in] anEntity The entity to be removed. */
+        void
+        removeEntity(ChannelContainer * anEntity);
+
         /*! @brief Remove connections that are invalid. */
         void
         removeInvalidConnections(void);
@@ -254,7 +363,21 @@ namespace MPlusM_Manager
         bool
         removeUnvisitedEntities(void);
 
+        /*! @brief Repaint an area of the panel.
+         @param[in] area The area to be repainted, before zooming. */
+        void
+        repaintUnscaledArea(const juce::Rectangle<int> & area);
+
+        /*! @brief Change whether the rendered images of entities are cached.
+         The average paint time since the last change is reported, so that the two modes can be
+         compared.
+         @param[in] cacheImages @c true if the rendered images of entities are to be cached and
+         @c false otherwise. */
+        void
+        setEntityImageCaching(const bool cacheImages);
+
         /*! @brief Update the dragging information.
+         The areas covered by the previous and new drag lines are repainted.
          @param[in] position The location of the dragging connection.
          @param[in] isForced @c true if the drag line should show a forced connection and @c false
          otherwise. */
@@ -262,6 +385,43 @@ namespace MPlusM_Manager
         setDragInfo(const Position position,
                     const bool     isForced);
 
+        /*! @brief Change the text that the entities and ports are searched for.
+         Entities whose names, IP addresses, kinds or ports contain the text are drawn normally,
+         with the matching ports highlighted, and the remaining entities are dimmed. The search
+         ignores case, and empty text ends the search.
+         @param[in] searchText The text to search for. */
+        void
+        setSearchText(const String & searchText);
+
+        /*! @brief Record the area of the panel that is visible in the containing viewport.
+         @param[in] newArea The area of the panel that is visible. */
+        void
+        setVisibleArea(const juce::Rectangle<int> & newArea);
+
+        /*! @brief Change whether the standalone ports of every host are displayed as a single
+         entity.
+         @param[in] collapse @c true if the ports of each host are to be displayed as a single
+         entity and @c false if they are to be displayed separately. */
+        void
+        setAllHostGroupsCollapsed(const bool collapse);
+
+        /*! @brief Change whether the standalone ports of a host are displayed as a single entity.
+         When a group is collapsed, the stand-in for the host is placed where the ports were; when
+         it is expanded, the ports are stacked where the stand-in was.
+         @param[in] aGroup The container that stands in for the host.
+         @param[in] collapse @c true if the ports are to be displayed as a single entity and
+         @c false if they are to be displayed separately. */
+        void
+        setHostGroupCollapsed(ChannelContainer * aGroup,
+                              const bool         collapse);
+
+        /*! @brief Change the scale factor applied to the entities and connections.
+         At low zoom levels the entities are drawn as simplified glyphs and the connections between
+         each pair of entities are merged into a single line.
+         @param[in] newZoom The new scale factor, which is limited to the supported range. */
+        void
+        setZoom(const float newZoom);
+
         /*! @brief Ignore the result of the next scan. */
         void
         skipScan(void);
@@ -270,10 +430,43 @@ namespace MPlusM_Manager
         void
         unhideEntities(void);
 
+        /*! @brief Refresh the spatial index entries for an entity and for the connections that
+         touch it.
+         @param[in] anEntity The entity that has been moved, resized or reconnected. */
+        void
+        updateEntityIndex(ChannelContainer * anEntity);
+
+        /*! @brief Rebuild the spatial index for all the entities and connections. */
+        void
+        updateEntityIndexForAll(void);
+
+        /*! @brief Group the standalone ports that were seen by the latest scan by their IP address.
+         Hosts with enough ports are given a container that stands in for all of them; groups
+         that no longer have enough ports are dissolved. New groups start out collapsed. */
+        void
+        updateHostGroups(void);
+
+        /*! @brief Refresh the search index entries for an entity, and whether it matches the
+         active search.
+         @param[in] anEntity The entity that has been added or has had ports added. */
+        void
+        updateSearchIndex(ChannelContainer * anEntity);
+
     protected :
 
     private :
 
+        /*! @brief Apply the active search to all the entities. */
+        void
+        applySearch(void);
+
+        /*! @brief Count the items that were drawn in a frame, along with the number that exist.
+         @param[in] clipArea The area of the panel that was drawn.
+         @param[out] counts The number of items that were drawn and the number that exist. */
+        void
+        countDrawnItems(const juce::Rectangle<int> & clipArea,
+                        DrawingCounts &              counts);
+
         /*! @brief Respond to a request for a popup menu. */
         void
         displayAndProcessPopupMenu(void);
@@ -283,6 +476,29 @@ namespace MPlusM_Manager
         void
         drawConnections(Graphics & gg);
 
+        /*! @brief Display the connections between containers, with a single line for all the
+         connections between each pair of containers.
+         The ports in a collapsed host group are replaced by the container that stands in for the
+         host, and their incoming connections are included as well as their outgoing connections.
+         @param[in,out] gg The graphics context in which to draw.
+         @param[in] drawArea The area in which connections are visible.
+         @param[in] sources The containers whose outgoing connections might be visible.
+         @param[in] groupedOnly @c true if only the connections that involve a collapsed host
+         group are to be drawn and @c false if all the connections are to be drawn.
+         @returns The number of lines that were drawn. */
+        size_t
+        drawMergedConnections(Graphics &                   gg,
+                              const juce::Rectangle<int> & drawArea,
+                              const ContainerSet &         sources,
+                              const bool                   groupedOnly);
+
+        /*! @brief Check whether an entity matches the active search, and if it does, record it
+         and its matching ports and make sure that it is not dimmed.
+         @param[in] anEntity The entity to check.
+         @returns @c true if the entity matches the active search and @c false otherwise. */
+        bool
+        matchSearch(ChannelContainer * anEntity);
+
         /*! @brief Called when a mouse button is pressed.
          @param[in] ee Details about the position and status of the mouse event. */
         virtual void
@@ -298,10 +514,43 @@ namespace MPlusM_Manager
         virtual void
         paint(Graphics & gg);
 
+        /*! @brief Called after the children of the component have been drawn.
+         @param[in,out] gg The graphics context in which to draw. */
+        virtual void
+        paintOverChildren(Graphics & gg);
+
+        /*! @brief Recalculate the area covered by all the entities. */
+        void
+        recalculateContentBounds(void);
+
+        /*! @brief Remove an entity from the spatial index.
+         @param[in] anEntity The entity to be removed. */
+        void
+        removeFromEntityIndex(ChannelContainer * anEntity);
+
+        /*! @brief Remove an entity from the search index and from the matches for the active
+         search.
+         @param[in] anEntity The entity to be removed. */
+        void
+        removeFromSearchIndex(ChannelContainer * anEntity);
+
         /*! @brief Called when the component size has been changed. */
         virtual void
         resized(void);
 
+        /*! @brief Update the area covered by all the entities after a change to an entity.
+         @param[in] oldBounds The previous bounds of the entity, or an empty rectangle if it is new.
+         @param[in] newBounds The current bounds of the entity, or an empty rectangle if it has
+         been removed. */
+        void
+        updateContentBounds(const juce::Rectangle<int> & oldBounds,
+                            const juce::Rectangle<int> & newBounds);
+
+        /*! @brief Refresh the spatial index entries for the outgoing connections of an entity.
+         @param[in] anEntity The entity whose outgoing connections are to be indexed. */
+        void
+        updateConnectionIndex(ChannelContainer * anEntity);
+
     public :
 
     protected :
@@ -311,15 +560,53 @@ namespace MPlusM_Manager
         /*! @brief The set of known ports. */
         ChannelEntryMap _knownPorts;
 
+        /*! @brief The containers that stand in for the standalone ports on each host. */
+        HostGroupMap _hostGroups;
+
         /*! @brief A collection of known services and ports. */
         ContainerList _knownEntities;
 
+        /*! @brief The spatial index for the outgoing connections of the known entities. */
+        ContainerGrid _connectionGrid;
+
+        /*! @brief The spatial index for the known entities. */
+        ContainerGrid _entityGrid;
+
+        /*! @brief The bounds used for the outgoing connections in the spatial index. */
+        ContainerBoundsMap _indexedConnectionBounds;
+
+        /*! @brief The bounds used for the known entities in the spatial index. */
+        ContainerBoundsMap _indexedEntityBounds;
+
+        /*! @brief The text that is searched for each of the known entities. */
+        ContainerTextMap _searchTexts;
+
+        /*! @brief The search index, mapping three-character sequences to the entities whose
+         search text contains them. */
+        ContainerTrigramMap _searchTrigrams;
+
+        /*! @brief The entities that match the active search. */
+        ContainerSet _searchMatches;
+
+        /*! @brief The ports that match the active search. */
+        ChannelEntrySet _matchingPorts;
+
+        /*! @brief The text being searched for, in lower case, or an empty string if there is no
+         active search. */
+        YarpString _searchText;
+
         /*! @brief The bold font to be used. */
         ScopedPointer<Font> _defaultBoldFont;
 
         /*! @brief The normal font to be used. */
         ScopedPointer<Font> _defaultNormalFont;
 
+        /*! @brief The area covered by all the entities, before zooming. */
+        juce::Rectangle<int> _contentBounds;
+
+        /*! @brief The area of the panel that is visible in the containing viewport. */
+        juce::Rectangle<int> _visibleArea;
+
         /*! @brief The coordinates of the drag-connection operation. */
         Position _dragPosition;
 
@@ -332,18 +619,48 @@ namespace MPlusM_Manager
         /*! @brief The container in which the panel is embedded. */
         ContentPanel * _container;
 
+        /*! @brief The number of connections that were drawn by the most recent paint. */
+        size_t _connectionsDrawn;
+
+        /*! @brief The high-resolution tick count when the current paint started. */
+        int64 _paintStartTicks;
+
+        /*! @brief The total time spent painting since the last change of caching mode, in
+         seconds. */
+        double _paintTimeTotal;
+
+        /*! @brief The number of paints since the last change of caching mode. */
+        size_t _paintCount;
+
+        /*! @brief The scale factor applied to the entities and connections. */
+        float _zoom;
+
+        /*! @brief @c true if the rendered images of entities are cached and @c false otherwise. */
+        bool _cacheEntityImages;
+
+        /*! @brief @c true if the area covered by all the entities is up to date and @c false if it
+         must be recalculated. */
+        bool _contentBoundsValid;
+
         /*! @brief @c true if a drag-connection operation is active. */
         bool _dragConnectionActive;
 
         /*! @brief @c true if the drag operation is for a forced connection. */
         bool _dragIsForced;
 
+        /*! @brief @c true if the entities have been dimmed for an active search and @c false
+         otherwise. */
+        bool _searchIsApplied;
+
+        /*! @brief @c true if the entities are drawn as simplified glyphs and @c false otherwise. */
+        bool _showGlyphs;
+
 # if defined(__APPLE__)
 #  pragma clang diagnostic push
 #  pragma clang diagnostic ignored "-Wunused-private-field"
 # endif // defined(__APPLE__)
         /*! @brief Filler to pad to alignment boundary */
-        char _filler[7];
+        char _filler[4];
 # if defined(__APPLE__)
 #  pragma clang diagnostic pop
 # endif // defined(__APPLE__)
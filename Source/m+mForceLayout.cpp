@@ -0,0 +1,546 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mForceLayout.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for the built-in force-directed entity layout.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-18
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mForceLayout.hpp"
+#include "m+mLayoutThread.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for the built-in force-directed entity layout. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+using namespace std;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    /*! @brief A background job that accumulates the forces for a range of entities. */
+    class ForceJob : public ThreadPoolJob
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The class that this class is derived from. */
+        typedef ThreadPoolJob inherited;
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in] owner The layout that the forces are calculated for.
+         @param[in] first The index of the first entity in the range.
+         @param[in] last The index just past the last entity in the range. */
+        ForceJob(ForceLayout & owner,
+                 const size_t  first,
+                 const size_t  last) :
+            inherited("layout forces"), _owner(owner), _first(first), _last(last)
+        {
+        } // ForceJob
+
+        /*! @brief The destructor. */
+        virtual
+        ~ForceJob(void)
+        {
+        } // ~ForceJob
+
+    protected :
+
+    private :
+
+        /*! @brief Perform the job.
+         @returns The status of the job. */
+        virtual JobStatus
+        runJob(void)
+        {
+            _owner.accumulateForces(_first, _last);
+            return jobHasFinished;
+        } // runJob
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The layout that the forces are calculated for. */
+        ForceLayout & _owner;
+
+        /*! @brief The index of the first entity in the range. */
+        size_t _first;
+
+        /*! @brief The index just past the last entity in the range. */
+        size_t _last;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ForceJob)
+
+    }; // ForceJob
+
+} // MPlusM_Manager
+
+/*! @brief The ratio of cell size to distance below which a quadtree cell is treated as a single
+ body. Larger values are faster and less accurate. */
+static const float kBarnesHutTheta = 0.8f;
+
+/*! @brief The strength of the pull of each entity towards the centre of all the entities, which
+ keeps unconnected entities from drifting away. */
+static const float kGravity = 0.5f;
+
+/*! @brief The largest number of levels in the quadtree; entities that are closer together than
+ this allows share a cell. */
+static const int kMaxTreeDepth = 24;
+
+/*! @brief The smallest distance used when calculating the repulsion between entities. */
+static const float kMinimumDistance = 1;
+
+/*! @brief The movement, in pixels, below which the layout is considered to be settled. */
+static const float kMinimumMovement = 0.5f;
+
+/*! @brief The number of entities below which the forces are accumulated on a single thread. */
+static const size_t kMinimumParallelSize = 500;
+
+/*! @brief The number of steps in a layout. */
+static const int kNumIterations = 250;
+
+/*! @brief The gap to be left between connected entities. */
+static const float kSpacing = 60;
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+ForceLayout::ForceLayout(LayoutNodeList &       nodes,
+                         const LayoutEdgeList & edges,
+                         const int              maxThreads) :
+    _nodes(nodes), _adjacency(), _adjacencyStart(nodes.size() + 1, 0), _cells(),
+    _moveX(nodes.size(), 0), _moveY(nodes.size(), 0), _radii(nodes.size(), 0), _x(nodes.size(), 0),
+    _y(nodes.size(), 0), _jobs(), _pool(), _centreX(0), _centreY(0), _idealLength(kSpacing)
+{
+    ODL_ENTER(); //####
+    ODL_P2("nodes = ", &nodes, "edges = ", &edges); //####
+    ODL_LL1("maxThreads = ", maxThreads); //####
+    size_t numNodes = nodes.size();
+    float  totalRadius = 0;
+
+    for (size_t ii = 0; numNodes > ii; ++ii)
+    {
+        const LayoutNode & aNode = nodes[ii];
+
+        _radii[ii] = (Position(aNode._width, aNode._height).getDistanceFromOrigin() / 2);
+        _x[ii] = aNode._position.getX() + (aNode._width / 2);
+        _y[ii] = aNode._position.getY() + (aNode._height / 2);
+        totalRadius += _radii[ii];
+    }
+    if (0 < numNodes)
+    {
+        _idealLength += (2 * totalRadius / numNodes);
+    }
+    // Build a compact adjacency list, so that each entity can gather its own attractive forces
+    // without writing to any other entity.
+    for (LayoutEdgeList::const_iterator walker(edges.begin()); edges.end() != walker; ++walker)
+    {
+        if (walker->first != walker->second)
+        {
+            ++_adjacencyStart[walker->first + 1];
+            ++_adjacencyStart[walker->second + 1];
+        }
+    }
+    for (size_t ii = 0; numNodes > ii; ++ii)
+    {
+        _adjacencyStart[ii + 1] += _adjacencyStart[ii];
+    }
+    std::vector<size_t> filled(_adjacencyStart.begin(), _adjacencyStart.end() - 1);
+
+    _adjacency.resize(_adjacencyStart[numNodes]);
+    for (LayoutEdgeList::const_iterator walker(edges.begin()); edges.end() != walker; ++walker)
+    {
+        if (walker->first != walker->second)
+        {
+            _adjacency[filled[walker->first]++] = walker->second;
+            _adjacency[filled[walker->second]++] = walker->first;
+        }
+    }
+    if (kMinimumParallelSize <= numNodes)
+    {
+        int    numThreads = jmax(1, SystemStats::getNumCpus());
+
+        if (0 < maxThreads)
+        {
+            numThreads = jmin(numThreads, maxThreads);
+        }
+        size_t chunkSize = ((numNodes + numThreads - 1) / numThreads);
+
+        _pool = new ThreadPool(numThreads);
+        for (size_t first = 0; numNodes > first; first += chunkSize)
+        {
+            _jobs.add(new ForceJob(*this, first, jmin(numNodes, first + chunkSize)));
+        }
+    }
+    ODL_EXIT_P(this); //####
+} // ForceLayout::ForceLayout
+
+ForceLayout::~ForceLayout(void)
+{
+    ODL_OBJENTER(); //####
+    _pool = NULL;
+    ODL_OBJEXIT(); //####
+} // ForceLayout::~ForceLayout
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+ForceLayout::accumulateForces(const size_t first,
+                              const size_t last)
+{
+    ODL_OBJENTER(); //####
+    ODL_LL2("first = ", first, "last = ", last); //####
+    int   stack[(3 * kMaxTreeDepth) + 4];
+    float idealSquared = (_idealLength * _idealLength);
+
+    for (size_t ii = first; last > ii; ++ii)
+    {
+        float forceX = 0;
+        float forceY = 0;
+
+        if (_nodes[ii]._movable)
+        {
+            float thisX = _x[ii];
+            float thisY = _y[ii];
+            float thisRadius = _radii[ii];
+            int   depth = 0;
+
+            // Repulsion, using the centres of mass of distant cells in place of their entities.
+            stack[depth++] = 0;
+            for ( ; 0 < depth; )
+            {
+                const QuadCell & aCell = _cells[stack[--depth]];
+
+                if ((0 < aCell._count) && (static_cast<int>(ii) != aCell._body))
+                {
+                    float  deltaX = thisX - static_cast<float>(aCell._sumX / aCell._count);
+                    float  deltaY = thisY - static_cast<float>(aCell._sumY / aCell._count);
+                    float  distance = sqrt((deltaX * deltaX) + (deltaY * deltaY));
+
+                    if ((0 > aCell._children) || (aCell._size < (kBarnesHutTheta * distance)))
+                    {
+                        float gap = distance;
+
+                        if (kMinimumDistance > distance)
+                        {
+                            // The entities coincide, so pick a direction to separate them.
+                            deltaX = ((ii & 1) ? kMinimumDistance : -kMinimumDistance);
+                            deltaY = ((ii & 2) ? kMinimumDistance : -kMinimumDistance);
+                            distance = sqrt((deltaX * deltaX) + (deltaY * deltaY));
+                        }
+                        if (0 <= aCell._body)
+                        {
+                            // Nearby single entities repel according to the space between them.
+                            gap -= (thisRadius + _radii[aCell._body]);
+                        }
+                        float strength = ((idealSquared * aCell._count) /
+                                          jmax(kMinimumDistance, gap));
+
+                        forceX += ((deltaX / distance) * strength);
+                        forceY += ((deltaY / distance) * strength);
+                    }
+                    else
+                    {
+                        for (int jj = 0; 4 > jj; ++jj)
+                        {
+                            stack[depth++] = aCell._children + jj;
+                        }
+                    }
+                }
+            }
+            // Attraction to connected entities.
+            for (size_t jj = _adjacencyStart[ii], mm = _adjacencyStart[ii + 1]; mm > jj; ++jj)
+            {
+                size_t other = _adjacency[jj];
+                float  deltaX = _x[other] - thisX;
+                float  deltaY = _y[other] - thisY;
+                float  distance = sqrt((deltaX * deltaX) + (deltaY * deltaY));
+
+                forceX += ((deltaX * distance) / _idealLength);
+                forceY += ((deltaY * distance) / _idealLength);
+            }
+            // Gravity.
+            forceX += ((_centreX - thisX) * kGravity);
+            forceY += ((_centreY - thisY) * kGravity);
+        }
+        _moveX[ii] = forceX;
+        _moveY[ii] = forceY;
+    }
+    ODL_OBJEXIT(); //####
+} // ForceLayout::accumulateForces
+
+bool
+ForceLayout::arrange(LayoutThread & controller,
+                     const int64    generation)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("controller = ", &controller); //####
+    ODL_LL1("generation = ", generation); //####
+    bool   result = true;
+    size_t numNodes = _nodes.size();
+    float  initialStep = (_idealLength * sqrt(static_cast<float>(numNodes)) / 4);
+    float  largestMove = kMinimumMovement;
+
+    for (int step = 0; result && (kNumIterations > step) && (kMinimumMovement <= largestMove);
+         ++step)
+    {
+        if (controller.isStale(generation))
+        {
+            result = false;
+        }
+        else
+        {
+            // The largest permitted movement shrinks as the layout proceeds, so that it settles
+            // down.
+            float stepLimit = jmax(kMinimumMovement,
+                                   ((initialStep * (kNumIterations - step)) / kNumIterations));
+
+            buildTree();
+            if (_pool)
+            {
+                for (int ii = 0, mm = _jobs.size(); mm > ii; ++ii)
+                {
+                    _pool->addJob(_jobs[ii], false);
+                }
+                for (int ii = 0, mm = _jobs.size(); mm > ii; ++ii)
+                {
+                    _pool->waitForJobToFinish(_jobs[ii], -1);
+                }
+            }
+            else
+            {
+                accumulateForces(0, numNodes);
+            }
+            largestMove = 0;
+            for (size_t ii = 0; numNodes > ii; ++ii)
+            {
+                float moveX = _moveX[ii];
+                float moveY = _moveY[ii];
+                float length = sqrt((moveX * moveX) + (moveY * moveY));
+
+                if (stepLimit < length)
+                {
+                    moveX *= (stepLimit / length);
+                    moveY *= (stepLimit / length);
+                    length = stepLimit;
+                }
+                _x[ii] += moveX;
+                _y[ii] += moveY;
+                largestMove = jmax(largestMove, length);
+            }
+        }
+    }
+    if (result)
+    {
+        for (size_t ii = 0; numNodes > ii; ++ii)
+        {
+            LayoutNode & aNode = _nodes[ii];
+
+            if (aNode._movable)
+            {
+                aNode._position = Position(_x[ii] - (aNode._width / 2),
+                                           _y[ii] - (aNode._height / 2));
+            }
+        }
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ForceLayout::arrange
+
+void
+ForceLayout::buildTree(void)
+{
+    ODL_OBJENTER(); //####
+    size_t numNodes = _nodes.size();
+
+    _cells.clear();
+    if (0 < numNodes)
+    {
+        float    minX = _x[0];
+        float    maxX = minX;
+        float    minY = _y[0];
+        float    maxY = minY;
+        QuadCell root;
+
+        for (size_t ii = 1; numNodes > ii; ++ii)
+        {
+            minX = jmin(minX, _x[ii]);
+            maxX = jmax(maxX, _x[ii]);
+            minY = jmin(minY, _y[ii]);
+            maxY = jmax(maxY, _y[ii]);
+        }
+        root._sumX = root._sumY = 0;
+        root._left = minX;
+        root._top = minY;
+        root._size = jmax(maxX - minX, maxY - minY) + 1;
+        root._children = root._body = -1;
+        root._count = 0;
+        _cells.reserve(4 * numNodes);
+        _cells.push_back(root);
+        for (size_t ii = 0; numNodes > ii; ++ii)
+        {
+            insertBody(static_cast<int>(ii));
+        }
+        _centreX = static_cast<float>(_cells[0]._sumX / numNodes);
+        _centreY = static_cast<float>(_cells[0]._sumY / numNodes);
+    }
+    ODL_OBJEXIT(); //####
+} // ForceLayout::buildTree
+
+void
+ForceLayout::insertBody(const int body)
+{
+    ODL_OBJENTER(); //####
+    ODL_LL1("body = ", body); //####
+    float thisX = _x[body];
+    float thisY = _y[body];
+    int   cell = 0;
+
+    // Note that the cells are referred to by index, as splitting a cell can move the cells.
+    for (int depth = 0; 0 <= cell; ++depth)
+    {
+        _cells[cell]._sumX += thisX;
+        _cells[cell]._sumY += thisY;
+        if (0 <= _cells[cell]._children)
+        {
+            // Descend into the sub-cell that contains the entity.
+            const QuadCell & aCell = _cells[cell];
+            float            halfSize = (aCell._size / 2);
+
+            ++_cells[cell]._count;
+            cell = aCell._children + (((aCell._left + halfSize) <= thisX) ? 1 : 0) +
+                   (((aCell._top + halfSize) <= thisY) ? 2 : 0);
+        }
+        else if (0 == _cells[cell]._count++)
+        {
+            _cells[cell]._body = body;
+            cell = -1;
+        }
+        else if ((kMaxTreeDepth <= depth) || (0 > _cells[cell]._body))
+        {
+            // The cell is too small to divide; the entities share it.
+            _cells[cell]._body = -1;
+            cell = -1;
+        }
+        else
+        {
+            // Move the existing entity into a sub-cell, then continue with the new entity.
+            int   other = _cells[cell]._body;
+            float halfSize;
+            int   otherCell;
+
+            splitCell(cell);
+            halfSize = (_cells[cell]._size / 2);
+            otherCell = _cells[cell]._children +
+                        (((_cells[cell]._left + halfSize) <= _x[other]) ? 1 : 0) +
+                        (((_cells[cell]._top + halfSize) <= _y[other]) ? 2 : 0);
+            _cells[otherCell]._sumX = _x[other];
+            _cells[otherCell]._sumY = _y[other];
+            _cells[otherCell]._body = other;
+            _cells[otherCell]._count = 1;
+            _cells[cell]._body = -1;
+            cell = _cells[cell]._children + (((_cells[cell]._left + halfSize) <= thisX) ? 1 : 0) +
+                   (((_cells[cell]._top + halfSize) <= thisY) ? 2 : 0);
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // ForceLayout::insertBody
+
+void
+ForceLayout::splitCell(const int cell)
+{
+    ODL_OBJENTER(); //####
+    ODL_LL1("cell = ", cell); //####
+    QuadCell subCell;
+    float    halfSize = (_cells[cell]._size / 2);
+
+    subCell._sumX = subCell._sumY = 0;
+    subCell._size = halfSize;
+    subCell._children = subCell._body = -1;
+    subCell._count = 0;
+    _cells[cell]._children = static_cast<int>(_cells.size());
+    for (int ii = 0; 4 > ii; ++ii)
+    {
+        subCell._left = _cells[cell]._left + ((ii & 1) ? halfSize : 0);
+        subCell._top = _cells[cell]._top + ((ii & 2) ? halfSize : 0);
+        _cells.push_back(subCell);
+    }
+    ODL_OBJEXIT(); //####
+} // ForceLayout::splitCell
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
@@ -0,0 +1,216 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mForceLayout.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for the built-in force-directed entity layout.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-18
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmForceLayout_HPP_))
+# define mpmForceLayout_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for the built-in force-directed entity layout. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    class LayoutThread;
+
+    /*! @brief A force-directed entity layout.
+     Connected entities attract each other and all entities repel each other; the repulsion is
+     approximated with a quadtree (the Barnes-Hut method), so that each step costs O(n log n) rather
+     than O(n^2), and the forces are accumulated in parallel for large layouts. */
+    class ForceLayout
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief A cell of the quadtree that is used to approximate the repulsion. */
+        struct QuadCell
+        {
+            /*! @brief The sum of the horizontal positions of the entities in the cell. */
+            double _sumX;
+
+            /*! @brief The sum of the vertical positions of the entities in the cell. */
+            double _sumY;
+
+            /*! @brief The left edge of the cell. */
+            float _left;
+
+            /*! @brief The width and height of the cell. */
+            float _size;
+
+            /*! @brief The top edge of the cell. */
+            float _top;
+
+            /*! @brief The index of the first of the four sub-cells, or a negative value if the
+             cell has not been divided. */
+            int _children;
+
+            /*! @brief The entity in the cell if there is exactly one, or a negative value. */
+            int _body;
+
+            /*! @brief The number of entities in the cell. */
+            int _count;
+
+        }; // QuadCell
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in,out] nodes The entities to be laid out.
+         @param[in] edges The connections between the entities.
+         @param[in] maxThreads The largest number of threads to use for large layouts, or zero to
+         use one thread per processor. */
+        ForceLayout(LayoutNodeList &       nodes,
+                    const LayoutEdgeList & edges,
+                    const int              maxThreads);
+
+        /*! @brief The destructor. */
+        virtual
+        ~ForceLayout(void);
+
+        /*! @brief Calculate the movement of a range of entities for the current step.
+         This can be called from several threads at once, as long as the ranges do not overlap.
+         @param[in] first The index of the first entity in the range.
+         @param[in] last The index just past the last entity in the range. */
+        void
+        accumulateForces(const size_t first,
+                         const size_t last);
+
+        /*! @brief Calculate new positions for the movable entities.
+         @param[in] controller The thread that requested the layout.
+         @param[in] generation The request number of the layout.
+         @returns @c true if the layout was completed and @c false if it was abandoned. */
+        bool
+        arrange(LayoutThread & controller,
+                const int64    generation);
+
+        /*! @brief Return the number of threads used to accumulate the forces.
+         @returns The number of threads used to accumulate the forces. */
+        inline int
+        getThreadCount(void)
+        const
+        {
+            return _jobs.size();
+        } // getThreadCount
+
+    protected :
+
+    private :
+
+        /*! @brief Rebuild the quadtree from the current entity positions. */
+        void
+        buildTree(void);
+
+        /*! @brief Add an entity to the quadtree.
+         @param[in] body The index of the entity. */
+        void
+        insertBody(const int body);
+
+        /*! @brief Divide a quadtree cell into four sub-cells.
+         @param[in] cell The index of the cell to be divided. */
+        void
+        splitCell(const int cell);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The entities to be laid out. */
+        LayoutNodeList & _nodes;
+
+        /*! @brief The indices of the connected entities, grouped by entity. */
+        std::vector<size_t> _adjacency;
+
+        /*! @brief The position in the adjacency list of the first connected entity of each
+         entity. */
+        std::vector<size_t> _adjacencyStart;
+
+        /*! @brief The quadtree that is used to approximate the repulsion. */
+        std::vector<QuadCell> _cells;
+
+        /*! @brief The horizontal movement of each entity in the current step. */
+        std::vector<float> _moveX;
+
+        /*! @brief The vertical movement of each entity in the current step. */
+        std::vector<float> _moveY;
+
+        /*! @brief The radius of each entity. */
+        std::vector<float> _radii;
+
+        /*! @brief The horizontal position of the centre of each entity. */
+        std::vector<float> _x;
+
+        /*! @brief The vertical position of the centre of each entity. */
+        std::vector<float> _y;
+
+        /*! @brief The background jobs that accumulate the forces.
+         Note that the jobs must outlive the pool, so this is declared before the pool. */
+        OwnedArray<ThreadPoolJob> _jobs;
+
+        /*! @brief The threads that accumulate the forces. */
+        ScopedPointer<ThreadPool> _pool;
+
+        /*! @brief The horizontal position of the centre of all the entities. */
+        float _centreX;
+
+        /*! @brief The vertical position of the centre of all the entities. */
+        float _centreY;
+
+        /*! @brief The preferred distance between the centres of connected entities. */
+        float _idealLength;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ForceLayout)
+
+    }; // ForceLayout
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmForceLayout_HPP_)
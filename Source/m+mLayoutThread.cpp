@@ -0,0 +1,780 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mLayoutThread.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for the background entity layout.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-18
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mLayoutThread.hpp"
+#include "m+mContentPanel.hpp"
+#include "m+mForceLayout.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(USE_OGDF_POSITIONING_)
+# if MAC_OR_LINUX_
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunused-parameter"
+# else // ! MAC_OR_LINUX_
+#  pragma warning(push)
+#  pragma warning(disable: 4100)
+# endif // ! MAC_OR_LINUX_
+# include <ogdf/basic/GraphAttributes.h>
+# include <ogdf/energybased/FMMMLayout.h>
+# if MAC_OR_LINUX_
+#  pragma clang diagnostic pop
+# else // ! MAC_OR_LINUX_
+#  pragma warning(pop)
+# endif // ! MAC_OR_LINUX_
+#endif // defined(USE_OGDF_POSITIONING_)
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for the background entity layout. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+using namespace std;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The numbers of entities in the synthetic graphs that are used for benchmarking. */
+static const size_t kBenchmarkSizes[] = { 100, 1000, 5000 };
+
+/*! @brief The number of connections per entity in the synthetic graphs that are used for
+ benchmarking. */
+static const float kBenchmarkConnectionRatio = 1.5f;
+
+/*! @brief The largest synthetic graph that is laid out with OGDF when benchmarking. An OGDF
+ layout can't be interrupted, so larger graphs would hold up a new layout or the shutdown. */
+static const size_t kBenchmarkOgdfSizeLimit = 1000;
+
+/*! @brief The preferred distance between the centres of connected entities in a local layout. */
+static const float kLocalEdgeLength = 150;
+
+/*! @brief The largest distance that an entity can move in one step of a local layout. */
+static const float kLocalInitialStep = 30;
+
+/*! @brief The number of steps in a local layout. */
+static const int kLocalIterations = 50;
+
+/*! @brief The minimum gap between entities in a local layout. */
+static const float kLocalSpacing = 20;
+
+/*! @brief The fraction of the difference from the preferred distance that is corrected for each
+ connection in a local layout. */
+static const float kLocalSpringStrength = 0.2f;
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Create a random graph of a given size, resembling a typical set of entities.
+ The same graph is produced for each size, so that the results of benchmarks can be compared.
+ @param[in] numNodes The number of entities to create.
+ @param[out] nodes The entities in the graph.
+ @param[out] edges The connections between the entities. */
+static void
+createSyntheticGraph(const size_t     numNodes,
+                     LayoutNodeList & nodes,
+                     LayoutEdgeList & edges)
+{
+    ODL_ENTER(); //####
+    ODL_LL1("numNodes = ", numNodes); //####
+    ODL_P2("nodes = ", &nodes, "edges = ", &edges); //####
+    Random randomizer(static_cast<int64>(numNodes));
+    float  extent = (300 * sqrt(static_cast<float>(numNodes)));
+    size_t numEdges = static_cast<size_t>(kBenchmarkConnectionRatio * numNodes);
+
+    nodes.clear();
+    edges.clear();
+    for (size_t ii = 0; numNodes > ii; ++ii)
+    {
+        LayoutNode aNode;
+
+        aNode._name = "entity" + String(static_cast<int>(ii)).toStdString();
+        aNode._width = static_cast<float>(100 + randomizer.nextInt(150));
+        aNode._height = static_cast<float>(40 + randomizer.nextInt(120));
+        aNode._position = aNode._provisional = Position(randomizer.nextFloat() * extent,
+                                                        randomizer.nextFloat() * extent);
+        aNode._movable = true;
+        nodes.push_back(aNode);
+    }
+    // Connect each entity to an earlier one, so that most of the graph is connected, then add
+    // some extra connections.
+    for (size_t ii = 1; numNodes > ii; ++ii)
+    {
+        int earlier = randomizer.nextInt(static_cast<int>(ii));
+
+        edges.push_back(LayoutEdge(ii, static_cast<size_t>(earlier)));
+    }
+    for ( ; numEdges > edges.size(); )
+    {
+        int first = randomizer.nextInt(static_cast<int>(numNodes));
+        int second = randomizer.nextInt(static_cast<int>(numNodes));
+
+        edges.push_back(LayoutEdge(static_cast<size_t>(first), static_cast<size_t>(second)));
+    }
+    ODL_EXIT(); //####
+} // createSyntheticGraph
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+void
+LayoutThread::relaxLocally(LayoutNodeList &       nodes,
+                           const LayoutEdgeList & edges)
+{
+    ODL_ENTER(); //####
+    ODL_P2("nodes = ", &nodes, "edges = ", &edges); //####
+    size_t                           numNodes = nodes.size();
+    std::vector<std::vector<size_t> > neighbours(numNodes);
+    std::vector<float>               radii(numNodes);
+
+    for (LayoutEdgeList::const_iterator walker(edges.begin()); edges.end() != walker; ++walker)
+    {
+        if (walker->first != walker->second)
+        {
+            neighbours[walker->first].push_back(walker->second);
+            neighbours[walker->second].push_back(walker->first);
+        }
+    }
+    for (size_t ii = 0; numNodes > ii; ++ii)
+    {
+        const LayoutNode & aNode = nodes[ii];
+
+        radii[ii] = (Position(aNode._width, aNode._height).getDistanceFromOrigin() / 2);
+    }
+    for (int step = 0; kLocalIterations > step; ++step)
+    {
+        // The largest permitted movement shrinks as the layout proceeds, so that it settles down.
+        float stepLimit = ((kLocalInitialStep * (kLocalIterations - step)) / kLocalIterations);
+
+        for (size_t ii = 0; numNodes > ii; ++ii)
+        {
+            LayoutNode & thisNode = nodes[ii];
+
+            if (thisNode._movable)
+            {
+                Position                    thisCentre(thisNode._position +
+                                                       Position(thisNode._width / 2,
+                                                                thisNode._height / 2));
+                Position                    movement;
+                const std::vector<size_t> & connected = neighbours[ii];
+
+                // Pull connected entities towards the preferred distance.
+                for (size_t jj = 0, mm = connected.size(); mm > jj; ++jj)
+                {
+                    const LayoutNode & otherNode = nodes[connected[jj]];
+                    Position           delta(otherNode._position +
+                                             Position(otherNode._width / 2,
+                                                      otherNode._height / 2) - thisCentre);
+                    float              distance = jmax(1.0f, delta.getDistanceFromOrigin());
+
+                    movement += (delta * ((kLocalSpringStrength * (distance - kLocalEdgeLength)) /
+                                          distance));
+                }
+                // Push apart entities that are too close together.
+                for (size_t jj = 0; numNodes > jj; ++jj)
+                {
+                    if (ii != jj)
+                    {
+                        const LayoutNode & otherNode = nodes[jj];
+                        Position           delta(thisCentre - (otherNode._position +
+                                                               Position(otherNode._width / 2,
+                                                                        otherNode._height / 2)));
+                        float              distance = delta.getDistanceFromOrigin();
+                        float              minimum = (radii[ii] + radii[jj] + kLocalSpacing);
+
+                        if (minimum > distance)
+                        {
+                            if (1 > distance)
+                            {
+                                // The entities coincide, so pick a direction to separate them.
+                                delta = Position(1, (ii < jj) ? 1.0f : -1.0f);
+                                distance = delta.getDistanceFromOrigin();
+                            }
+                            movement += (delta * ((minimum - distance) / distance));
+                        }
+                    }
+                }
+                float length = movement.getDistanceFromOrigin();
+
+                if (stepLimit < length)
+                {
+                    movement *= (stepLimit / length);
+                }
+                thisNode._position += movement;
+            }
+        }
+    }
+    ODL_EXIT(); //####
+} // LayoutThread::relaxLocally
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+LayoutThread::LayoutThread(ContentPanel & owner) :
+    inherited("entity layout"), _pendingEdges(), _pendingNodes(), _results(), _owner(owner),
+    _resultsTime(0), _phaseStartTime(0), _requestedGeneration(0), _nodeCount(0),
+    _phase(kLayoutPhaseIdle), _benchmarkIsPending(false), _layoutIsComplete(false),
+    _requestIsPending(false),
+#if defined(USE_NATIVE_POSITIONING_)
+    _useNativeLayout(true)
+#else // ! defined(USE_NATIVE_POSITIONING_)
+    _useNativeLayout(false)
+#endif // ! defined(USE_NATIVE_POSITIONING_)
+{
+    ODL_ENTER(); //####
+    ODL_P1("owner = ", &owner); //####
+    ODL_EXIT_P(this); //####
+} // LayoutThread::LayoutThread
+
+LayoutThread::~LayoutThread(void)
+{
+    ODL_OBJENTER(); //####
+    // An OGDF layout can't be interrupted, and killing the thread while it runs could leave the
+    // layout in an unknown state, so the thread is given as long as it needs to finish.
+    signalThreadShouldExit();
+    notify();
+    stopThread(-1);
+    ODL_OBJEXIT(); //####
+} // LayoutThread::~LayoutThread
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+bool
+LayoutThread::checkAndClearIfLayoutIsComplete(LayoutNodeList & results,
+                                              double &         elapsedTime)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("results = ", &results, "elapsedTime = ", &elapsedTime); //####
+    const ScopedLock lock(_lock);
+    bool             result = _layoutIsComplete;
+
+    if (result)
+    {
+        results.swap(_results);
+        _results.clear();
+        elapsedTime = _resultsTime;
+        _layoutIsComplete = false;
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // LayoutThread::checkAndClearIfLayoutIsComplete
+
+bool
+LayoutThread::checkLayoutDeterminism(const LayoutNodeList & original,
+                                     const LayoutEdgeList & edges,
+                                     const int64            generation,
+                                     int &                  threadCount)
+{
+    ODL_OBJENTER(); //####
+    ODL_P3("original = ", &original, "edges = ", &edges, "threadCount = ", &threadCount); //####
+    ODL_LL1("generation = ", generation); //####
+    bool result = false;
+
+    threadCount = 0;
+#if defined(USE_NATIVE_POSITIONING_)
+    LayoutNodeList parallelNodes(original);
+    LayoutNodeList serialNodes(original);
+    ForceLayout    parallelEngine(parallelNodes, edges, 0);
+    ForceLayout    serialEngine(serialNodes, edges, 1);
+
+    threadCount = parallelEngine.getThreadCount();
+    if (serialEngine.arrange(*this, generation) && parallelEngine.arrange(*this, generation))
+    {
+        result = true;
+        for (size_t ii = 0, mm = serialNodes.size(); result && (mm > ii); ++ii)
+        {
+            // The positions must match exactly, not merely to within a tolerance.
+            result = (serialNodes[ii]._position == parallelNodes[ii]._position);
+        }
+    }
+#endif // defined(USE_NATIVE_POSITIONING_)
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // LayoutThread::checkLayoutDeterminism
+
+bool
+LayoutThread::getProgress(String & description)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("description = ", &description); //####
+    const ScopedLock lock(_lock);
+    bool             result;
+    String           entityCount(static_cast<int>(_nodeCount));
+    int64            elapsedSeconds = ((Time::currentTimeMillis() - _phaseStartTime) / 1000);
+
+    switch (_phase)
+    {
+        case kLayoutPhaseBenchmarking :
+            description = "Benchmarking the layout of " + entityCount + " entities";
+            result = true;
+            break;
+
+        case kLayoutPhaseArranging :
+            description = "Arranging " + entityCount + " entities (" + String(elapsedSeconds) +
+                          "s)";
+            result = true;
+            break;
+
+        default :
+            result = false;
+            break;
+
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // LayoutThread::getProgress
+
+bool
+LayoutThread::isStale(const int64 generation)
+{
+    ODL_OBJENTER(); //####
+    ODL_LL1("generation = ", generation); //####
+    const ScopedLock lock(_lock);
+    bool             result = (threadShouldExit() || (generation != _requestedGeneration));
+
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // LayoutThread::isStale
+
+bool
+LayoutThread::isUsingNativeLayout(void)
+{
+    ODL_OBJENTER(); //####
+    const ScopedLock lock(_lock);
+    bool             result = _useNativeLayout;
+
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // LayoutThread::isUsingNativeLayout
+
+void
+LayoutThread::performBenchmark(const int64 generation)
+{
+    ODL_OBJENTER(); //####
+    ODL_LL1("generation = ", generation); //####
+    char buffer1[DATE_TIME_BUFFER_SIZE_];
+    char buffer2[DATE_TIME_BUFFER_SIZE_];
+
+    Utilities::GetDateAndTime(buffer1, sizeof(buffer1), buffer2, sizeof(buffer2));
+    std::cerr << buffer1 << " " << buffer2 << " Benchmarking entity layouts with " <<
+                SystemStats::getNumCpus() << " processors" << std::endl;
+    for (size_t ii = 0, mm = (sizeof(kBenchmarkSizes) / sizeof(*kBenchmarkSizes));
+         (mm > ii) && (! isStale(generation)); ++ii)
+    {
+        LayoutEdgeList edges;
+        LayoutNodeList original;
+
+        createSyntheticGraph(kBenchmarkSizes[ii], original, edges);
+        setPhase(kLayoutPhaseBenchmarking, original.size());
+        triggerRepaint();
+        for (int engine = 0; (2 > engine) && (! isStale(generation)); ++engine)
+        {
+            LayoutNodeList nodes(original);
+            bool           completed;
+            bool           isNative = (0 == engine);
+            bool           skipped = ((! isNative) && (kBenchmarkOgdfSizeLimit < original.size()));
+            double         startTime = Time::getMillisecondCounterHiRes();
+
+            if (isNative)
+            {
+                completed = performNativeLayout(nodes, edges, generation);
+            }
+            else if (skipped)
+            {
+                completed = false;
+            }
+            else
+            {
+                completed = performOgdfLayout(nodes, edges, Position(), generation);
+            }
+            double elapsedTime = (Time::getMillisecondCounterHiRes() - startTime);
+
+            Utilities::GetDateAndTime(buffer1, sizeof(buffer1), buffer2, sizeof(buffer2));
+            if (skipped)
+            {
+                std::cerr << buffer1 << " " << buffer2 << " Layout of " << nodes.size() <<
+                            " entities with OGDF was skipped, as it can't be interrupted" <<
+                            std::endl;
+            }
+            else if (completed)
+            {
+                std::cerr << buffer1 << " " << buffer2 << " Layout of " << nodes.size() <<
+                            " entities and " << edges.size() << " connections with " <<
+                            (isNative ? "the built-in layout" : "OGDF") << " took " <<
+                            elapsedTime << "ms" << std::endl;
+            }
+            else if (! isStale(generation))
+            {
+                std::cerr << buffer1 << " " << buffer2 << " Layout of " << nodes.size() <<
+                            " entities with " << (isNative ? "the built-in layout" : "OGDF") <<
+                            " is not available" << std::endl;
+            }
+        }
+        if (! isStale(generation))
+        {
+            int  threadCount;
+            bool identical = checkLayoutDeterminism(original, edges, generation, threadCount);
+
+            // A single parallel job runs the same code path as the serial layout, so there is
+            // nothing to compare.
+            if ((1 < threadCount) && (! isStale(generation)))
+            {
+                Utilities::GetDateAndTime(buffer1, sizeof(buffer1), buffer2, sizeof(buffer2));
+                std::cerr << buffer1 << " " << buffer2 << " Layout of " << original.size() <<
+                            " entities with 1 and " << threadCount << " threads gave " <<
+                            (identical ? "identical" : "different") << " positions" << std::endl;
+            }
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // LayoutThread::performBenchmark
+
+bool
+LayoutThread::performLayout(LayoutNodeList &       nodes,
+                            const LayoutEdgeList & edges,
+                            const Position &       anchor,
+                            const int64            generation)
+{
+    ODL_OBJENTER(); //####
+    ODL_P3("nodes = ", &nodes, "edges = ", &edges, "anchor = ", &anchor); //####
+    ODL_LL1("generation = ", generation); //####
+    bool result;
+
+    setPhase(kLayoutPhaseArranging, nodes.size());
+    triggerRepaint();
+    if (isUsingNativeLayout())
+    {
+        result = performNativeLayout(nodes, edges, generation);
+    }
+    else
+    {
+        result = performOgdfLayout(nodes, edges, anchor, generation);
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // LayoutThread::performLayout
+
+bool
+LayoutThread::performNativeLayout(LayoutNodeList &       nodes,
+                                  const LayoutEdgeList & edges,
+                                  const int64            generation)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("nodes = ", &nodes, "edges = ", &edges); //####
+    ODL_LL1("generation = ", generation); //####
+    bool result = false;
+
+#if defined(USE_NATIVE_POSITIONING_)
+    ForceLayout engine(nodes, edges, 0);
+
+    result = engine.arrange(*this, generation);
+#endif // defined(USE_NATIVE_POSITIONING_)
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // LayoutThread::performNativeLayout
+
+bool
+LayoutThread::performOgdfLayout(LayoutNodeList &       nodes,
+                                const LayoutEdgeList & edges,
+                                const Position &       anchor,
+                                const int64            generation)
+{
+    ODL_OBJENTER(); //####
+    ODL_P3("nodes = ", &nodes, "edges = ", &edges, "anchor = ", &anchor); //####
+    ODL_LL1("generation = ", generation); //####
+    bool result = false;
+
+#if defined(USE_OGDF_POSITIONING_)
+    ScopedPointer<ogdf::Graph>           gg(new ogdf::Graph);
+    ScopedPointer<ogdf::GraphAttributes> ga(new ogdf::GraphAttributes(*gg));
+
+    if (ga)
+    {
+        std::vector<ogdf::node> graphNodes;
+        std::vector<bool>       wasConnected(nodes.size(), false);
+        ogdf::node              phantomNode = gg->newNode();
+
+        ga->setDirected(true);
+        // If nodes are not connected, OGDF will pile them all at the origin; by adding a 'phantom'
+        // node that is connected to every other node, we force OGDF to spread the nodes out.
+        ga->width(phantomNode) = 1;
+        ga->height(phantomNode) = 1;
+        ga->x(phantomNode) = anchor.getX();
+        ga->y(phantomNode) = anchor.getY();
+        for (LayoutNodeList::const_iterator walker(nodes.begin()); nodes.end() != walker;
+             ++walker)
+        {
+            ogdf::node aNode = gg->newNode();
+
+            ga->width(aNode) = walker->_width;
+            ga->height(aNode) = walker->_height;
+            ga->x(aNode) = walker->_position.getX();
+            ga->y(aNode) = walker->_position.getY();
+            graphNodes.push_back(aNode);
+        }
+        // Set up the edges (connections).
+        for (LayoutEdgeList::const_iterator walker(edges.begin()); edges.end() != walker;
+             ++walker)
+        {
+            if (walker->first != walker->second)
+            {
+                /*ogdf::edge ee =*/ gg->newEdge(graphNodes[walker->first],
+                                                graphNodes[walker->second]);
+
+                wasConnected[walker->first] = wasConnected[walker->second] = true;
+            }
+        }
+        for (size_t ii = 0, mm = graphNodes.size(); mm > ii; ++ii)
+        {
+            if (! wasConnected[ii])
+            {
+                /*ogdf::edge phantomNodeToThis =*/ gg->newEdge(phantomNode, graphNodes[ii]);
+
+            }
+        }
+        if (! isStale(generation))
+        {
+            // Apply an energy-based layout.
+            ScopedPointer<ogdf::FMMMLayout> fmmm(new ogdf::FMMMLayout);
+
+            if (fmmm)
+            {
+                fmmm->useHighLevelOptions(true);
+                fmmm->newInitialPlacement(false); //true);
+                fmmm->qualityVersusSpeed(ogdf::FMMMLayout::qvsGorgeousAndEfficient);
+                fmmm->allowedPositions(ogdf::FMMMLayout::apAll);
+                fmmm->initialPlacementMult(ogdf::FMMMLayout::ipmAdvanced);
+                fmmm->initialPlacementForces(ogdf::FMMMLayout::ipfKeepPositions);
+                fmmm->repForcesStrength(2);
+                fmmm->call(*ga);
+                // The layout itself cannot be interrupted, but its results can be discarded if a
+                // newer layout has been requested in the meantime.
+                if (! isStale(generation))
+                {
+                    for (size_t ii = 0, mm = graphNodes.size(); mm > ii; ++ii)
+                    {
+                        LayoutNode & aNode = nodes[ii];
+
+                        if (aNode._movable)
+                        {
+                            aNode._position = Position(static_cast<float>(ga->x(graphNodes[ii])),
+                                                       static_cast<float>(ga->y(graphNodes[ii])));
+                        }
+                    }
+                    result = true;
+                }
+            }
+        }
+    }
+#endif // defined(USE_OGDF_POSITIONING_)
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // LayoutThread::performOgdfLayout
+
+void
+LayoutThread::requestBenchmark(void)
+{
+    ODL_OBJENTER(); //####
+    {
+        const ScopedLock lock(_lock);
+
+        _benchmarkIsPending = true;
+    }
+    notify();
+    ODL_OBJEXIT(); //####
+} // LayoutThread::requestBenchmark
+
+void
+LayoutThread::requestLayout(const LayoutNodeList & nodes,
+                            const LayoutEdgeList & edges,
+                            const Position &       anchor)
+{
+    ODL_OBJENTER(); //####
+    ODL_P3("nodes = ", &nodes, "edges = ", &edges, "anchor = ", &anchor); //####
+    {
+        const ScopedLock lock(_lock);
+
+        _pendingNodes = nodes;
+        _pendingEdges = edges;
+        _pendingAnchor = anchor;
+        // Any layout that is in progress or whose results have not been collected is now stale.
+        ++_requestedGeneration;
+        _layoutIsComplete = false;
+        _results.clear();
+        _requestIsPending = true;
+    }
+    notify();
+    ODL_OBJEXIT(); //####
+} // LayoutThread::requestLayout
+
+void
+LayoutThread::run(void)
+{
+    ODL_OBJENTER(); //####
+    for ( ; ! threadShouldExit(); )
+    {
+        LayoutNodeList nodes;
+        LayoutEdgeList edges;
+        Position       anchor;
+        int64          generation = 0;
+        bool           haveBenchmark = false;
+        bool           haveRequest = false;
+
+        {
+            const ScopedLock lock(_lock);
+
+            if (_requestIsPending)
+            {
+                nodes.swap(_pendingNodes);
+                edges.swap(_pendingEdges);
+                anchor = _pendingAnchor;
+                generation = _requestedGeneration;
+                _requestIsPending = false;
+                haveRequest = true;
+            }
+            else if (_benchmarkIsPending)
+            {
+                // A benchmark is abandoned if a layout is requested while it is running.
+                generation = _requestedGeneration;
+                _benchmarkIsPending = false;
+                haveBenchmark = true;
+            }
+        }
+        if (haveRequest)
+        {
+            double startTime = Time::getMillisecondCounterHiRes();
+
+            if (performLayout(nodes, edges, anchor, generation))
+            {
+                double           elapsedTime = (Time::getMillisecondCounterHiRes() - startTime);
+                const ScopedLock lock(_lock);
+
+                // Check again, as a newer layout might have been requested since the last check.
+                if (generation == _requestedGeneration)
+                {
+                    _results.swap(nodes);
+                    _resultsTime = elapsedTime;
+                    _layoutIsComplete = true;
+                }
+            }
+            setPhase(kLayoutPhaseIdle);
+            // The results are collected by the panel when it is repainted.
+            triggerRepaint();
+        }
+        else if (haveBenchmark)
+        {
+            performBenchmark(generation);
+            setPhase(kLayoutPhaseIdle);
+            triggerRepaint();
+        }
+        else
+        {
+            wait(MIDDLE_SLEEP_);
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // LayoutThread::run
+
+void
+LayoutThread::setNativeLayout(const bool useNative)
+{
+    ODL_OBJENTER(); //####
+    ODL_B1("useNative = ", useNative); //####
+    const ScopedLock lock(_lock);
+
+    _useNativeLayout = useNative;
+    ODL_OBJEXIT(); //####
+} // LayoutThread::setNativeLayout
+
+void
+LayoutThread::setPhase(const LayoutPhase newPhase,
+                       const size_t      nodeCount)
+{
+    ODL_OBJENTER(); //####
+    ODL_LL2("newPhase = ", newPhase, "nodeCount = ", nodeCount); //####
+    const ScopedLock lock(_lock);
+
+    _phase = newPhase;
+    _nodeCount = nodeCount;
+    _phaseStartTime = Time::currentTimeMillis();
+    ODL_OBJEXIT(); //####
+} // LayoutThread::setPhase
+
+void
+LayoutThread::triggerRepaint(void)
+{
+    ODL_OBJENTER(); //####
+    // Because this is a background thread, we mustn't do any UI work without first grabbing a
+    // MessageManagerLock.
+    const MessageManagerLock mml(Thread::getCurrentThread());
+
+    // If something is trying to kill this job, the lock will fail, in which case we'd better
+    // return.
+    if (mml.lockWasGained())
+    {
+        _owner.requestWindowRepaint();
+    }
+    ODL_OBJEXIT(); //####
+} // LayoutThread::triggerRepaint
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
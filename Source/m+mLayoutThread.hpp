@@ -0,0 +1,279 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mLayoutThread.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for the background entity layout.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-18
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmLayoutThread_HPP_))
+# define mpmLayoutThread_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for the background entity layout. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    class ContentPanel;
+
+    /*! @brief A background entity layout thread.
+     The layout works on a copy of the entities and connections, so that the displayed entities can
+     change while it is running. */
+    class LayoutThread : public Thread
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The class that this class is derived from. */
+        typedef Thread inherited;
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in] owner The panel that displays the entities. */
+        explicit
+        LayoutThread(ContentPanel & owner);
+
+        /*! @brief The destructor. */
+        virtual
+        ~LayoutThread(void);
+
+        /*! @brief Returns @c true if a layout has completed and @c false otherwise.
+         Note that the results are only returned once; the flag is cleared so that the next call
+         will return @c false until another layout completes.
+         @param[out] results The entities with their new positions.
+         @param[out] elapsedTime The time taken by the layout, in milliseconds.
+         @returns @c true if a layout has completed and @c false otherwise. */
+        bool
+        checkAndClearIfLayoutIsComplete(LayoutNodeList & results,
+                                        double &         elapsedTime);
+
+        /*! @brief Return a description of the layout that is in progress.
+         @param[out] description The description of the layout.
+         @returns @c true if a layout is in progress and @c false otherwise. */
+        bool
+        getProgress(String & description);
+
+        /*! @brief Returns @c true if a layout has been superseded or the thread is stopping and
+         @c false otherwise.
+         @param[in] generation The request number of the layout.
+         @returns @c true if the layout has been superseded and @c false otherwise. */
+        bool
+        isStale(const int64 generation);
+
+        /*! @brief Returns @c true if the built-in layout is used rather than OGDF.
+         @returns @c true if the built-in layout is used and @c false if OGDF is used. */
+        bool
+        isUsingNativeLayout(void);
+
+        /*! @brief Move a small set of entities to reduce their overlap with each other and to bring
+         connected entities closer together.
+         Only the movable entities are changed, and the cost depends only on the size of the set, so
+         this is suitable for placing newly-discovered entities among entities that are already
+         displayed.
+         @param[in,out] nodes The entities to be laid out.
+         @param[in] edges The connections between the entities. */
+        static void
+        relaxLocally(LayoutNodeList &       nodes,
+                     const LayoutEdgeList & edges);
+
+        /*! @brief Request a benchmark of the available layouts.
+         The results are reported on the standard error stream. */
+        void
+        requestBenchmark(void);
+
+        /*! @brief Request a layout of a set of entities.
+         Any layout that has not yet completed is abandoned.
+         @param[in] nodes The entities to be laid out.
+         @param[in] edges The connections between the entities.
+         @param[in] anchor The position to use for the node that holds unconnected entities. */
+        void
+        requestLayout(const LayoutNodeList & nodes,
+                      const LayoutEdgeList & edges,
+                      const Position &       anchor);
+
+        /*! @brief Select the layout to be used.
+         @param[in] useNative @c true if the built-in layout is to be used and @c false if OGDF is
+         to be used. */
+        void
+        setNativeLayout(const bool useNative);
+
+    protected :
+
+    private :
+
+        /*! @brief Lay out a synthetic graph with a single thread and with one thread per processor
+         and compare the resulting positions.
+         @param[in] original The entities to be laid out.
+         @param[in] edges The connections between the entities.
+         @param[in] generation The request number that the benchmark was started with.
+         @param[out] threadCount The number of threads used by the parallel layout.
+         @returns @c true if both layouts completed and every entity has the same position in each
+         and @c false otherwise. */
+        bool
+        checkLayoutDeterminism(const LayoutNodeList & original,
+                               const LayoutEdgeList & edges,
+                               const int64            generation,
+                               int &                  threadCount);
+
+        /*! @brief Time the layout of synthetic graphs of several sizes and report the results.
+         @param[in] generation The request number that the benchmark was started with. */
+        void
+        performBenchmark(const int64 generation);
+
+        /*! @brief Calculate new positions for the movable entities.
+         @param[in,out] nodes The entities to be laid out.
+         @param[in] edges The connections between the entities.
+         @param[in] anchor The position to use for the node that holds unconnected entities.
+         @param[in] generation The request number of the layout.
+         @returns @c true if the layout was completed and @c false if it was abandoned. */
+        bool
+        performLayout(LayoutNodeList &       nodes,
+                      const LayoutEdgeList & edges,
+                      const Position &       anchor,
+                      const int64            generation);
+
+        /*! @brief Calculate new positions for the movable entities with the built-in layout.
+         @param[in,out] nodes The entities to be laid out.
+         @param[in] edges The connections between the entities.
+         @param[in] generation The request number of the layout.
+         @returns @c true if the layout was completed and @c false if it was abandoned or is not
+         available. */
+        bool
+        performNativeLayout(LayoutNodeList &       nodes,
+                            const LayoutEdgeList & edges,
+                            const int64            generation);
+
+        /*! @brief Calculate new positions for the movable entities with OGDF.
+         @param[in,out] nodes The entities to be laid out.
+         @param[in] edges The connections between the entities.
+         @param[in] anchor The position to use for the node that holds unconnected entities.
+         @param[in] generation The request number of the layout.
+         @returns @c true if the layout was completed and @c false if it was abandoned or is not
+         available. */
+        bool
+        performOgdfLayout(LayoutNodeList &       nodes,
+                          const LayoutEdgeList & edges,
+                          const Position &       anchor,
+                          const int64            generation);
+
+        /*! @brief Perform the background layout. */
+        virtual void
+        run(void);
+
+        /*! @brief Record the stage reached by the layout.
+         @param[in] newPhase The stage reached by the layout.
+         @param[in] nodeCount The number of entities being laid out. */
+        void
+        setPhase(const LayoutPhase newPhase,
+                 const size_t      nodeCount = 0);
+
+        /*! @brief Tell the displayed panel to do a repaint. */
+        void
+        triggerRepaint(void);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The connections for the next layout. */
+        LayoutEdgeList _pendingEdges;
+
+        /*! @brief The entities for the next layout. */
+        LayoutNodeList _pendingNodes;
+
+        /*! @brief The entities from the most recently completed layout. */
+        LayoutNodeList _results;
+
+        /*! @brief A lock to manage access to shared resources. */
+        CriticalSection _lock;
+
+        /*! @brief The panel that displays the entities. */
+        ContentPanel & _owner;
+
+        /*! @brief The position to use for the node that holds unconnected entities in the next
+         layout. */
+        Position _pendingAnchor;
+
+        /*! @brief The time taken by the most recently completed layout, in milliseconds. */
+        double _resultsTime;
+
+        /*! @brief The time at which the current stage of the layout started. */
+        int64 _phaseStartTime;
+
+        /*! @brief The number of the most recent layout request. */
+        int64 _requestedGeneration;
+
+        /*! @brief The number of entities being laid out. */
+        size_t _nodeCount;
+
+        /*! @brief The stage reached by the layout. */
+        LayoutPhase _phase;
+
+        /*! @brief @c true if a benchmark has been requested and not yet started and @c false
+         otherwise. */
+        bool _benchmarkIsPending;
+
+        /*! @brief @c true if the results of a layout are available and @c false otherwise. */
+        bool _layoutIsComplete;
+
+        /*! @brief @c true if a layout has been requested and not yet started and @c false
+         otherwise. */
+        bool _requestIsPending;
+
+        /*! @brief @c true if the built-in layout is used and @c false if OGDF is used. */
+        bool _useNativeLayout;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LayoutThread)
+
+    }; // LayoutThread
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmLayoutThread_HPP_)
@@ -115,6 +115,9 @@ using namespace std;
 /*! @brief @c true if an exit has been requested and @c false otherwise. */
 static bool lExitRequested = false;
 
+/*! @brief The command-line option to run the drawing benchmark without a window and then exit. */
+static const char * kBenchmarkDrawingOption = "--benchmark-drawing";
+
 /*! @brief The number of milliseconds to sleep while waiting for a process to finish. */
 static const int kProcessSleepSlice = 5;
 
@@ -1143,18 +1146,9 @@ ManagerApplication::getUserName(void)
     return result;
 } // ManagerApplication::getUserName
 
-#if (! MAC_OR_LINUX_)
-# pragma warning(push)
-# pragma warning(disable: 4100)
-#endif // ! MAC_OR_LINUX_
 void
 ManagerApplication::initialise(const String & commandLine)
 {
-#if (! defined(ODL_ENABLE_LOGGING_))
-# if MAC_OR_LINUX_
-#  pragma unused(commandLine)
-# endif // MAC_OR_LINUX_
-#endif // ! defined(ODL_ENABLE_LOGGING_)
     ODL_OBJENTER(); //####
     ODL_S1s("commandLine = ", commandLine.toStdString()); //####
     bool launchedRegistry = false;
@@ -1164,60 +1158,70 @@ ManagerApplication::initialise(const String & commandLine)
 #endif // MAC_OR_LINUX_
     Common::Initialize(ProjectInfo::projectName);
     Utilities::SetUpGlobalStatusReporter();
-#if defined(MpM_ReportOnConnections)
-    ChannelStatusReporter * reporter = Utilities::GetGlobalStatusReporter();
-#endif // defined(MpM_ReportOnConnections)
-
-    Utilities::CheckForNameServerReporter();
-    loadApplicationLists();
-    _buttonHeight = LookAndFeel::getDefaultLookAndFeel().getAlertWindowButtonHeight();
-    _mainWindow = new ManagerWindow(ProjectInfo::projectName);
-    if (Utilities::CheckForValidNetwork(true))
+    if (StringArray::fromTokens(commandLine, true).contains(kBenchmarkDrawingOption))
     {
-        _yarp = new yarp::os::Network; // This is necessary to establish any connections to the YARP
-                                       // infrastructure.
+        // The benchmark needs neither a window nor YARP, so that it can be run from a script.
+        setApplicationReturnValue(EntitiesPanel::performDrawingBenchmark() ? 0 : 1);
+        quit();
     }
     else
     {
-        ODL_LOG("! (yarp::os::Network::checkNetwork())"); //####
-        MpM_WARNING_("YARP network not running.");
-        _yarpPath = findPathToExecutable("yarp");
-        _yarp = checkForYarpAndLaunchIfDesired();
-    }
-    if (_yarp)
-    {
-        if (! Utilities::CheckForRegistryService())
+#if defined(MpM_ReportOnConnections)
+        ChannelStatusReporter * reporter = Utilities::GetGlobalStatusReporter();
+#endif // defined(MpM_ReportOnConnections)
+
+        Utilities::CheckForNameServerReporter();
+        loadApplicationLists();
+        _buttonHeight = LookAndFeel::getDefaultLookAndFeel().getAlertWindowButtonHeight();
+        _mainWindow = new ManagerWindow(ProjectInfo::projectName);
+        if (Utilities::CheckForValidNetwork(true))
         {
-            _registryServicePath = findPathToExecutable(MpM_REGISTRY_EXECUTABLE_NAME_);
-            launchedRegistry = checkForRegistryServiceAndLaunchIfDesired();
+            // This is necessary to establish any connections to the YARP infrastructure.
+            _yarp = new yarp::os::Network;
         }
-        EntitiesPanel & entities = _mainWindow->getEntitiesPanel();
-
-        entities.recallPositions();
-        _peeker = new Common::GeneralChannel(false);
-        _peekHandler = new PeekInputHandler;
-        if (_peeker && _peekHandler)
+        else
         {
+            ODL_LOG("! (yarp::os::Network::checkNetwork())"); //####
+            MpM_WARNING_("YARP network not running.");
+            _yarpPath = findPathToExecutable("yarp");
+            _yarp = checkForYarpAndLaunchIfDesired();
+        }
+        if (_yarp)
+        {
+            if (! Utilities::CheckForRegistryService())
+            {
+                _registryServicePath = findPathToExecutable(MpM_REGISTRY_EXECUTABLE_NAME_);
+                launchedRegistry = checkForRegistryServiceAndLaunchIfDesired();
+            }
+            EntitiesPanel & entities = _mainWindow->getEntitiesPanel();
+
+            entities.recallPositions();
+            // Show what was known at the end of the previous session while the first scan is
+            // done.
+            entities.recallTopology();
+            _peeker = new Common::GeneralChannel(false);
+            _peekHandler = new PeekInputHandler;
+            if (_peeker && _peekHandler)
+            {
 #if defined(MpM_ReportOnConnections)
-            _peeker->setReporter(reporter);
-            _peeker->getReport(reporter);
+                _peeker->setReporter(reporter);
+                _peeker->getReport(reporter);
 #endif // defined(MpM_ReportOnConnections)
-            YarpString peekName = Common::GetRandomChannelName(HIDDEN_CHANNEL_PREFIX_ "peek_/"
-                                                               DEFAULT_CHANNEL_ROOT_);
+                YarpString peekName =
+                                Common::GetRandomChannelName(HIDDEN_CHANNEL_PREFIX_ "peek_/"
+                                                             DEFAULT_CHANNEL_ROOT_);
 
-            if (_peeker->openWithRetries(peekName, STANDARD_WAIT_TIME_))
-            {
-                _peeker->setReader(*_peekHandler);
-                _scanner = new ScannerThread(*_mainWindow, launchedRegistry);
-                _scanner->startThread();
+                if (_peeker->openWithRetries(peekName, STANDARD_WAIT_TIME_))
+                {
+                    _peeker->setReader(*_peekHandler);
+                    _scanner = new ScannerThread(*_mainWindow, launchedRegistry);
+                    _scanner->startThread();
+                }
             }
         }
     }
     ODL_OBJEXIT(); //####
 } // ManagerApplication::initialise
-#if (! MAC_OR_LINUX_)
-# pragma warning(pop)
-#endif // ! MAC_OR_LINUX_
 
 void
 ManagerApplication::loadApplicationLists(void)
@@ -1352,11 +1356,19 @@ ManagerApplication::shutdown(void)
         _yarpLauncher = NULL; // shuts down thread
         restoreYarpConfiguration();
     }
-    EntitiesPanel & entities = _mainWindow->getEntitiesPanel();
+    // There is no window if only the drawing benchmark was run.
+    if (_mainWindow)
+    {
+        EntitiesPanel & entities = _mainWindow->getEntitiesPanel();
 
-    entities.rememberPositions();
+        entities.rememberPositions();
+        entities.rememberTopology();
+    }
 #if defined(MpM_DoExplicitClose)
-    _peeker->close();
+    if (_peeker)
+    {
+        _peeker->close();
+    }
 #endif // defined(MpM_DoExplicitClose)
     Common::GeneralChannel::RelinquishChannel(_peeker);
     _mainWindow = NULL; // (deletes our window)
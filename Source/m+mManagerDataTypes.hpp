@@ -79,12 +79,21 @@
 /*! @brief A longer sleep, in milliseconds. */
 # define LONG_SLEEP_ (VERY_SHORT_SLEEP_ * 100)
 
+/*! @brief The number of samples kept in the metrics history of a channel. */
+# define METRICS_HISTORY_SIZE_ 60
+
 /*! @brief A slightly longer sleep, in milliseconds. */
 # define MIDDLE_SLEEP_ (VERY_SHORT_SLEEP_ * 7)
 
 /*! @brief The minimum time for a thread to sleep, in milliseconds. */
 # define SHORT_SLEEP_ (VERY_SHORT_SLEEP_ * 4)
 
+//# define USE_FLYWEIGHT_PORTS_ /* Draw ports as rows of their entity rather than as components. */
+
+# define USE_LOCAL_POSITIONING_ /* Use local relaxation for entities found after the first scan. */
+
+# define USE_NATIVE_POSITIONING_ /* Use the built-in force-directed layout for entity placement. */
+
 # define USE_OGDF_FOR_FIRST_POSITIONING_ONLY_ /* Use OGDF for the initial entity placement. */
 
 # define USE_OGDF_POSITIONING_ /* Use OGDF for new entity placement.*/
@@ -99,6 +108,20 @@ namespace MPlusM_Manager
     class EntityData;
     class PortData;
 
+    /*! @brief The measurement that an alert rule is applied to. */
+    enum AlertMetric
+    {
+        /*! @brief The rate of bytes sent and received. */
+        kAlertMetricBytes,
+
+        /*! @brief The rate of messages sent and received. */
+        kAlertMetricMessages,
+
+        /*! @brief Force the size to be 4 bytes. */
+        kAlertMetricUnknown = 0x7FFFFFF
+
+    }; // AlertMetric
+
     /*! @brief The anchor position for a connection between ports. */
     enum AnchorSide
     {
@@ -188,6 +211,9 @@ namespace MPlusM_Manager
         /*! @brief The container is not a service. */
         kContainerKindOther,
 
+        /*! @brief The container stands in for the standalone ports on a single host. */
+        kContainerKindHost,
+
         /*! @brief Force the size to be 4 bytes. */
         kContainerKindUnknown = 0x7FFFFFF
 
@@ -199,6 +225,9 @@ namespace MPlusM_Manager
         /*! @brief Placeholder to ensure that the menu items don't start at zero. */
         kPopupEntityDummy = 0x2200,
 
+        /*! @brief Show the standalone ports of a host as a single entity. */
+        kPopupCollapseHostGroup,
+
         /*! @brief Configure settings for an input / output service or adapter. */
         kPopupConfigureService,
 
@@ -214,6 +243,9 @@ namespace MPlusM_Manager
         /*! @brief Display the channel metrics for a service or adapter. */
         kPopupDisplayServiceMetrics,
 
+        /*! @brief Show the standalone ports of a host as separate entities. */
+        kPopupExpandHostGroup,
+
         /*! @brief Hide the entity. */
         kPopupHideEntity,
 
@@ -225,6 +257,23 @@ namespace MPlusM_Manager
 
     }; // EntityPopupMenuSelection
 
+    /*! @brief The stage reached by a background layout. */
+    enum LayoutPhase
+    {
+        /*! @brief No layout is in progress. */
+        kLayoutPhaseIdle,
+
+        /*! @brief The layout algorithm is running. */
+        kLayoutPhaseArranging,
+
+        /*! @brief The layout algorithms are being timed. */
+        kLayoutPhaseBenchmarking,
+
+        /*! @brief Force the size to be 4 bytes. */
+        kLayoutPhaseUnknown = 0x7FFFFFF
+
+    }; // LayoutPhase
+
     /*! @brief The primary direction of the port. */
     enum PortDirection
     {
@@ -262,6 +311,92 @@ namespace MPlusM_Manager
 
     }; // PortUsage
 
+    /*! @brief What the widths of the connections show. */
+    enum TrafficWeighting
+    {
+        /*! @brief The widths show the kind of connection. */
+        kTrafficWeightingNone,
+
+        /*! @brief The widths show the rate of bytes carried. */
+        kTrafficWeightingBytes,
+
+        /*! @brief The widths show the rate of messages carried. */
+        kTrafficWeightingMessages,
+
+        /*! @brief Force the size to be 4 bytes. */
+        kTrafficWeightingUnknown = 0x7FFFFFF
+
+    }; // TrafficWeighting
+
+    /*! @brief The traffic counted on a monitored port since the counts were last collected. */
+    struct ActivityCounter
+    {
+        /*! @brief The number of bytes received. */
+        Atomic<int64> _bytes;
+
+        /*! @brief The number of messages received. */
+        Atomic<int64> _messages;
+
+    }; // ActivityCounter
+
+    /*! @brief The traffic seen on a monitored port during the most recent sampling interval. */
+    struct ActivitySample
+    {
+        /*! @brief The number of bytes received per second. */
+        double _bytesPerSecond;
+
+        /*! @brief The number of messages received per second. */
+        double _messagesPerSecond;
+
+    }; // ActivitySample
+
+    /*! @brief The state of an alert rule for one channel. */
+    struct AlertCondition
+    {
+        /*! @brief The position of the rule in the list of rules. */
+        size_t _ruleIndex;
+
+        /*! @brief The time at which the rule started to match, in milliseconds since the epoch, or
+         zero if the rule doesn't match. */
+        int64 _since;
+
+        /*! @brief The most recent measurement that the rule was applied to. */
+        double _value;
+
+        /*! @brief @c true if the rule has matched for long enough to raise an alert and @c false
+         otherwise. */
+        bool _active;
+
+    }; // AlertCondition
+
+    /*! @brief A rule that raises an alert when a rate of traffic crosses a threshold. */
+    struct AlertRule
+    {
+        /*! @brief The rule as it was written. */
+        YarpString _text;
+
+        /*! @brief The channel name or service kind that the rule applies to. */
+        YarpString _target;
+
+        /*! @brief How long the rule must match before an alert is raised, in milliseconds. */
+        int64 _duration;
+
+        /*! @brief The threshold for the rate. */
+        double _threshold;
+
+        /*! @brief The measurement that the rule is applied to. */
+        AlertMetric _metric;
+
+        /*! @brief @c true if the rule matches rates above the threshold and @c false if it matches
+         rates below the threshold. */
+        bool _above;
+
+        /*! @brief @c true if the rule applies to a kind of service and @c false if it applies to
+         a channel. */
+        bool _byKind;
+
+    }; // AlertRule
+
     /*! @brief The information used to launch an application. */
     struct ApplicationInfo
     {
@@ -288,6 +423,20 @@ namespace MPlusM_Manager
 
     }; // ApplicationInfo
 
+    /*! @brief The alert rules that apply to a channel, and their states. */
+    struct ChannelAlertState
+    {
+        /*! @brief The states of the rules that apply to the channel. */
+        std::vector<AlertCondition> _conditions;
+
+        /*! @brief The kind of the service that owns the channel. */
+        YarpString _serviceKind;
+
+        /*! @brief The name of the primary port of the service that owns the channel. */
+        YarpString _servicePortName;
+
+    }; // ChannelAlertState
+
     /*! @brief The form of a channel connection. */
     struct ChannelInfo
     {
@@ -320,6 +469,164 @@ namespace MPlusM_Manager
 
     }; // ConnectionDetails
 
+    /*! @brief The number of items drawn in a frame, along with the number that exist. */
+    struct DrawingCounts
+    {
+        /*! @brief The number of connections that were drawn. */
+        size_t _connectionsDrawn;
+
+        /*! @brief The number of connections between the entities. */
+        size_t _connectionsTotal;
+
+        /*! @brief The number of entities that were drawn. */
+        size_t _entitiesDrawn;
+
+        /*! @brief The number of entities that are known. */
+        size_t _entitiesTotal;
+
+        /*! @brief The number of ports that were drawn. */
+        size_t _portsDrawn;
+
+        /*! @brief The number of ports of the known entities. */
+        size_t _portsTotal;
+
+    }; // DrawingCounts
+
+    /*! @brief The information for an entity that is being laid out. */
+    struct LayoutNode
+    {
+        /*! @brief The name of the entity. */
+        YarpString _name;
+
+        /*! @brief The position of the top-left corner of the entity. */
+        Point<float> _position;
+
+        /*! @brief The position of the top-left corner of the entity when the layout was requested.
+         */
+        Point<float> _provisional;
+
+        /*! @brief The height of the entity. */
+        float _height;
+
+        /*! @brief The width of the entity. */
+        float _width;
+
+        /*! @brief @c true if the layout can move the entity and @c false if it must stay where it
+         is. */
+        bool _movable;
+
+    }; // LayoutNode
+
+    /*! @brief An alert that has been raised for a channel. */
+    struct MetricsAlert
+    {
+        /*! @brief The name of the channel. */
+        YarpString _channelName;
+
+        /*! @brief The rule that raised the alert, as it was written. */
+        YarpString _ruleText;
+
+        /*! @brief The name of the primary port of the service that owns the channel. */
+        YarpString _servicePortName;
+
+        /*! @brief The time at which the rule started to match, in milliseconds since the epoch. */
+        int64 _since;
+
+        /*! @brief The most recent measurement that the rule was applied to. */
+        double _value;
+
+    }; // MetricsAlert
+
+    /*! @brief The counters reported by a service for one of its channels. */
+    struct MetricsSample
+    {
+        /*! @brief The number of bytes received. */
+        int64 _inBytes;
+
+        /*! @brief The number of messages received. */
+        int64 _inMessages;
+
+        /*! @brief The number of bytes sent. */
+        int64 _outBytes;
+
+        /*! @brief The number of messages sent. */
+        int64 _outMessages;
+
+        /*! @brief The time at which the counters were collected, in milliseconds since the epoch.
+         */
+        int64 _time;
+
+    }; // MetricsSample
+
+    /*! @brief The most recent counters for a channel, held in a ring of fixed size so that a long
+     session doesn't grow the history. */
+    struct MetricsHistory
+    {
+        /*! @brief The samples, with the oldest at _next once the ring has filled. */
+        MetricsSample _samples[METRICS_HISTORY_SIZE_];
+
+        /*! @brief The number of samples in the ring. */
+        size_t _count;
+
+        /*! @brief The position in the ring for the next sample. */
+        size_t _next;
+
+    }; // MetricsHistory
+
+    /*! @brief The metrics reported by a service for one of its channels. */
+    struct MetricsRecord
+    {
+        /*! @brief The name of the channel. */
+        YarpString _channelName;
+
+        /*! @brief The counters for the channel. */
+        MetricsSample _counters;
+
+    }; // MetricsRecord
+
+    /*! @brief The layout of a sample in the long-term metrics store.
+     The channel is identified by a hash of its name, so that every record has the same size. */
+    struct MetricsStoreRecord
+    {
+        /*! @brief The hash of the name of the channel. */
+        int64 _channelKey;
+
+        /*! @brief The counters for the channel. */
+        MetricsSample _counters;
+
+    }; // MetricsStoreRecord
+
+    /*! @brief The traffic on a channel between two samples of its counters. */
+    struct MetricsRates
+    {
+        /*! @brief The number of bytes received per second. */
+        double _inBytesPerSecond;
+
+        /*! @brief The number of messages received per second. */
+        double _inMessagesPerSecond;
+
+        /*! @brief The number of bytes sent per second. */
+        double _outBytesPerSecond;
+
+        /*! @brief The number of messages sent per second. */
+        double _outMessagesPerSecond;
+
+    }; // MetricsRates
+
+    /*! @brief The range of times of the records in a segment of the long-term metrics store. */
+    struct MetricsSegmentRange
+    {
+        /*! @brief The time of the first record, in milliseconds since the epoch. */
+        int64 _firstTime;
+
+        /*! @brief The time of the most recent record, in milliseconds since the epoch. */
+        int64 _lastTime;
+
+        /*! @brief The number of records in the segment. */
+        uint32 _recordCount;
+
+    }; // MetricsSegmentRange
+
     /*! @brief The name and direction for a port. */
     struct NameAndDirection
     {
@@ -345,30 +652,220 @@ namespace MPlusM_Manager
 
     }; // PortInfo
 
+    /*! @brief A message received by a scrolling monitor. */
+    struct MonitorRecord
+    {
+        /*! @brief The contents of the message, shortened if it is long. */
+        String _text;
+
+        /*! @brief The time at which the message was received, in milliseconds since the epoch. */
+        int64 _receivedTime;
+
+        /*! @brief The size of the message, in bytes. */
+        size_t _size;
+
+    }; // MonitorRecord
+
+    /*! @brief A line of a scrolling monitor, which can stand for several messages when they arrive
+     faster than they can be displayed. */
+    struct MonitorRow
+    {
+        /*! @brief The first message that the line stands for. */
+        MonitorRecord _record;
+
+        /*! @brief The number of following messages that are not shown separately. */
+        int64 _skipped;
+
+    }; // MonitorRow
+
+    /*! @brief The figures that show how well the scanner is keeping up. */
+    struct ScannerHealth
+    {
+        /*! @brief The time taken by the most recent scan, in milliseconds. */
+        double _lastScanDuration;
+
+        /*! @brief The time at which the most recent successful scan finished, in milliseconds since
+         the epoch. */
+        int64 _lastScanTime;
+
+        /*! @brief The number of scans that have succeeded. */
+        int64 _scansCompleted;
+
+        /*! @brief The number of scans that could not gather the ports. */
+        int64 _scansFailed;
+
+    }; // ScannerHealth
+
+    /*! @brief The last known position of an entity. */
+    struct RememberedPosition
+    {
+        /*! @brief The position of the top-left corner of the entity. */
+        Point<float> _position;
+
+        /*! @brief The time at which the entity was last seen, in milliseconds since the epoch. */
+        int64 _lastSeen;
+
+    }; // RememberedPosition
+
+    /*! @brief The average traffic on a channel over the periods kept in the long-term metrics
+     store. */
+    struct StoredRates
+    {
+        /*! @brief The average rates over the most recent day. */
+        MetricsRates _day;
+
+        /*! @brief The average rates over the most recent hour. */
+        MetricsRates _hour;
+
+        /*! @brief @c true if the average rates over the most recent day are known and @c false
+         otherwise. */
+        bool _hasDay;
+
+        /*! @brief @c true if the average rates over the most recent hour are known and @c false
+         otherwise. */
+        bool _hasHour;
+
+    }; // StoredRates
+
+    /*! @brief The recent traffic on a channel, relative to the busiest channel. */
+    struct TrafficWeight
+    {
+        /*! @brief The rate of bytes, from zero for no traffic to one for the busiest channel. */
+        float _bytes;
+
+        /*! @brief The rate of messages, from zero for no traffic to one for the busiest channel.
+         */
+        float _messages;
+
+    }; // TrafficWeight
+
     /*! @brief Coordinates on the display. */
     typedef Point<float> Position;
 
     /*! @brief The set of connections to the channel. */
     typedef std::vector<ChannelInfo> ChannelConnections;
 
+    /*! @brief The positions of the alert rules for each channel name or service kind. */
+    typedef std::map<YarpString, std::vector<size_t> > AlertRuleIndexMap;
+
+    /*! @brief A collection of alert rules. */
+    typedef std::vector<AlertRule> AlertRuleList;
+
+    /*! @brief The alert rules for a set of channels, indexed by channel name. */
+    typedef std::map<YarpString, ChannelAlertState> ChannelAlertStateMap;
+
+    /*! @brief A collection of raised alerts. */
+    typedef std::vector<MetricsAlert> MetricsAlertList;
+
+    /*! @brief The metrics histories for a set of channels, indexed by channel name. */
+    typedef std::map<YarpString, MetricsHistory> MetricsHistoryMap;
+
+    /*! @brief The metrics reported by a service, one record per channel. */
+    typedef std::vector<MetricsRecord> MetricsRecordList;
+
+    /*! @brief A sequence of rates, with the oldest first. */
+    typedef std::vector<double> MetricsRateList;
+
+    /*! @brief A sequence of samples, with the oldest first. */
+    typedef std::vector<MetricsSample> MetricsSampleList;
+
+    /*! @brief The samples of a set of channels, indexed by the name of the channel. */
+    typedef std::map<YarpString, MetricsSampleList> MetricsSampleMap;
+
+    /*! @brief The ranges of times of a set of segments, indexed by the path to the segment. */
+    typedef std::map<String, MetricsSegmentRange> MetricsSegmentMap;
+
+    /*! @brief A sequence of records for the long-term metrics store, with the oldest first. */
+    typedef std::vector<MetricsStoreRecord> MetricsStoreRecordList;
+
+    /*! @brief The recent traffic on a set of channels, indexed by channel name. */
+    typedef std::map<YarpString, TrafficWeight> TrafficWeightMap;
+
+    /*! @brief The average traffic of a set of channels, indexed by the name of the channel. */
+    typedef std::map<YarpString, StoredRates> StoredRatesMap;
+
+    /*! @brief The traffic counters for the monitored ports, indexed by port name. */
+    typedef std::map<YarpString, ActivityCounter *> ActivityCounterMap;
+
+    /*! @brief The most recent traffic samples for the monitored ports, indexed by port name. */
+    typedef std::map<YarpString, ActivitySample> ActivitySampleMap;
+
+    /*! @brief A flag for each of a set of ports, indexed by port name. */
+    typedef std::map<YarpString, bool> ActivityStateMap;
+
     /*! @brief A collection of application details. */
     typedef std::vector<ApplicationInfo> ApplicationList;
 
     /*! @brief A collection of connections. */
     typedef std::vector<ConnectionDetails> ConnectionList;
 
+    /*! @brief A sequence of messages received by a scrolling monitor. */
+    typedef std::vector<MonitorRecord> MonitorRecordList;
+
+    /*! @brief The lines of a scrolling monitor. */
+    typedef std::vector<MonitorRow> MonitorRowList;
+
     /*! @brief A collection of services and ports. */
     typedef std::vector<ChannelContainer *> ContainerList;
 
+    /*! @brief A set of services and ports. */
+    typedef std::set<ChannelContainer *> ContainerSet;
+
+    /*! @brief The horizontal and vertical indices of a cell of the spatial index. */
+    typedef std::pair<int, int> GridCell;
+
+    /*! @brief A mapping from spatial index cells to the services and ports that overlap them. */
+    typedef std::map<GridCell, ContainerSet> ContainerGrid;
+
+    /*! @brief A mapping from services and ports to the bounds that they were indexed with. */
+    typedef std::map<ChannelContainer *, juce::Rectangle<int> > ContainerBoundsMap;
+
+    /*! @brief A mapping from services and ports to their positions in a sequence. */
+    typedef std::map<ChannelContainer *, size_t> ContainerIndexMap;
+
+    /*! @brief A mapping from services and ports to the text that is searched for them. */
+    typedef std::map<ChannelContainer *, YarpString> ContainerTextMap;
+
+    /*! @brief A mapping from three-character sequences to the services and ports whose search
+     text contains them. */
+    typedef std::map<YarpString, ContainerSet> ContainerTrigramMap;
+
+    /*! @brief A pair of services and ports, used to merge the connections between them. */
+    typedef std::pair<ChannelContainer *, ChannelContainer *> ContainerPair;
+
+    /*! @brief A mapping from pairs of services and ports to the number of connections between
+     them. */
+    typedef std::map<ContainerPair, size_t> ContainerPairCounts;
+
     /*! @brief A collection of entities (services, standalone ports, et cetera). */
     typedef std::vector<EntityData *> EntitiesList;
 
+    /*! @brief A connection between two entities that are being laid out, as indices of the
+     entities. */
+    typedef std::pair<size_t, size_t> LayoutEdge;
+
+    /*! @brief A sequence of connections between entities that are being laid out. */
+    typedef std::vector<LayoutEdge> LayoutEdgeList;
+
+    /*! @brief A sequence of entities that are being laid out. */
+    typedef std::vector<LayoutNode> LayoutNodeList;
+
+    /*! @brief A sequence of channels. */
+    typedef std::vector<ChannelEntry *> ChannelEntryList;
+
     /*! @brief A mapping from strings to channels. */
     typedef std::map<YarpString, ChannelEntry *> ChannelEntryMap;
 
+    /*! @brief A set of channels. */
+    typedef std::set<ChannelEntry *> ChannelEntrySet;
+
     /*! @brief A mapping from strings to ports. */
     typedef std::map<YarpString, PortData *> PortDataMap;
 
+    /*! @brief A mapping from IP addresses to the entities that stand in for the standalone ports
+     on each host. */
+    typedef std::map<YarpString, ChannelContainer *> HostGroupMap;
+
     /*! @brief A collection of ports. */
     typedef std::vector<PortData *> Ports;
 
@@ -378,12 +875,22 @@ namespace MPlusM_Manager
     /*! @brief A collection of port names. */
     typedef std::set<YarpString> PortSet;
 
-    /*! @brief A mapping from entity names to positions. */
-    typedef std::map<YarpString, Position> PositionMap;
+    /*! @brief A mapping from entity names to their last known positions. */
+    typedef std::map<YarpString, RememberedPosition> PositionMap;
 
     /*! @brief A mapping from strings to service descriptions. */
     typedef std::map<YarpString, MplusM::Utilities::ServiceDescriptor> ServiceMap;
 
+    /*! @brief The channels of a set of services, indexed by the name of the primary port. */
+    typedef std::map<YarpString, PortSet> ServiceChannelMap;
+
+    /*! @brief The kinds of a set of services, indexed by the name of the primary port. */
+    typedef std::map<YarpString, YarpString> ServiceKindMap;
+
+    /*! @brief The times at which a set of services entered a state, in milliseconds since the
+     epoch, indexed by the name of the primary port. */
+    typedef std::map<YarpString, int64> ServiceTimeMap;
+
     /*! @brief A collection of singular port names. */
     typedef std::map<YarpString, NameAndDirection> SingularPortMap;
 
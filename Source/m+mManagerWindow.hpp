@@ -90,7 +90,55 @@ namespace MPlusM_Manager
             kCommandLaunchRegistryService,
 
             /*! @brief Launch other executables. */
-            kCommandLaunchExecutables
+            kCommandLaunchExecutables,
+
+            /*! @brief Toggle the caching of the rendered images of entities. */
+            kCommandCacheEntityImages,
+
+            /*! @brief Enlarge the entities and connections. */
+            kCommandZoomIn,
+
+            /*! @brief Shrink the entities and connections. */
+            kCommandZoomOut,
+
+            /*! @brief Show the entities and connections at their normal size. */
+            kCommandZoomReset,
+
+            /*! @brief Toggle between the built-in layout and OGDF. */
+            kCommandUseNativeLayout,
+
+            /*! @brief Time the available layouts. */
+            kCommandBenchmarkLayout,
+
+            /*! @brief Show the standalone ports of each host as a single entity. */
+            kCommandCollapseHostGroups,
+
+            /*! @brief Show the standalone ports of each host as separate entities. */
+            kCommandExpandHostGroups,
+
+            /*! @brief Move to the search box. */
+            kCommandFindEntities,
+
+            /*! @brief Select the next entity that matches the search. */
+            kCommandFindNext,
+
+            /*! @brief Select the previous entity that matches the search. */
+            kCommandFindPrevious,
+
+            /*! @brief Show or hide the drawing and update costs. */
+            kCommandShowStatistics,
+
+            /*! @brief Time the drawing of synthetic sets of entities. */
+            kCommandBenchmarkDrawing,
+
+            /*! @brief Toggle the weighting of connections by their rate of bytes. */
+            kCommandWeightByByteRate,
+
+            /*! @brief Toggle the weighting of connections by their rate of messages. */
+            kCommandWeightByMessageRate,
+
+            /*! @brief Show the alerts raised by the metrics alert rules. */
+            kCommandShowAlerts
 
         }; // CommandIDs
 
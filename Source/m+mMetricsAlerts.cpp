@@ -0,0 +1,494 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mMetricsAlerts.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for the evaluation of alert rules against the collected
+//              metrics.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-18
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mMetricsAlerts.hpp"
+#include "m+mManagerApplication.hpp"
+#include "m+mMetricsThread.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for the evaluation of alert rules against the collected metrics. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+using namespace std;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The environment variable that holds the path to the file of alert rules. */
+static const char * kRulesFileVariable = "MPM_MANAGER_METRICS_ALERT_RULES";
+
+/*! @brief The text shown for a service that a rule applies to but that isn't collecting metrics.
+ */
+static const char * kMetricsDisabledText = "metrics disabled";
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Convert a line of the rules file into a rule.
+ @param[in] aLine The line to be converted.
+ @param[out] aRule The rule described by the line.
+ @returns @c true if the line is a valid rule and @c false otherwise. */
+static bool
+parseRule(const String & aLine,
+          AlertRule &    aRule)
+{
+    ODL_ENTER(); //####
+    ODL_S1s("aLine = ", aLine.toStdString()); //####
+    ODL_P1("aRule = ", &aRule); //####
+    StringArray tokens(StringArray::fromTokens(aLine, " \t", "\""));
+    bool        result;
+
+    tokens.removeEmptyStrings();
+    result = ((5 == tokens.size()) || (6 == tokens.size()));
+    if (result)
+    {
+        aRule._text = aLine.toStdString();
+        aRule._target = tokens[1].unquoted().toStdString();
+        aRule._threshold = tokens[4].getDoubleValue();
+        aRule._duration = ((6 == tokens.size()) ?
+                           static_cast<int64>(tokens[5].getDoubleValue() * 1000) : 0);
+        if (tokens[0].equalsIgnoreCase("channel"))
+        {
+            aRule._byKind = false;
+        }
+        else if (tokens[0].equalsIgnoreCase("kind"))
+        {
+            aRule._byKind = true;
+        }
+        else
+        {
+            result = false;
+        }
+        if (tokens[2].equalsIgnoreCase("bytes"))
+        {
+            aRule._metric = kAlertMetricBytes;
+        }
+        else if (tokens[2].equalsIgnoreCase("messages"))
+        {
+            aRule._metric = kAlertMetricMessages;
+        }
+        else
+        {
+            result = false;
+        }
+        if (tokens[3].equalsIgnoreCase("above"))
+        {
+            aRule._above = true;
+        }
+        else if (tokens[3].equalsIgnoreCase("below"))
+        {
+            aRule._above = false;
+        }
+        else
+        {
+            result = false;
+        }
+        if ((! tokens[4].containsOnly("0123456789.")) ||
+            ((6 == tokens.size()) && (! tokens[5].containsOnly("0123456789."))))
+        {
+            result = false;
+        }
+    }
+    ODL_EXIT_B(result); //####
+    return result;
+} // parseRule
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+MetricsAlerts::MetricsAlerts(void) :
+    _channelRules(), _kindRules(), _rules(), _channelStates(), _disabledServices()
+{
+    ODL_ENTER(); //####
+    String rulesPath(ManagerApplication::getEnvironmentVar(kRulesFileVariable));
+
+    if (rulesPath.isNotEmpty())
+    {
+        loadRules(rulesPath);
+    }
+    ODL_EXIT_P(this); //####
+} // MetricsAlerts::MetricsAlerts
+
+MetricsAlerts::~MetricsAlerts(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // MetricsAlerts::~MetricsAlerts
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+bool
+MetricsAlerts::appliesToService(const YarpString & serviceKind,
+                                const PortSet &    channels)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("serviceKind = ", serviceKind); //####
+    ODL_P1("channels = ", &channels); //####
+    YarpString kindKey(String(serviceKind.c_str()).toLowerCase().toStdString());
+    bool       result = (_kindRules.end() != _kindRules.find(kindKey));
+
+    for (PortSet::const_iterator walker(channels.begin()); (! result) && (channels.end() != walker);
+         ++walker)
+    {
+        result = (_channelRules.end() != _channelRules.find(*walker));
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // MetricsAlerts::appliesToService
+
+bool
+MetricsAlerts::evaluateSample(const YarpString &     channelName,
+                              const YarpString &     servicePortName,
+                              const YarpString &     serviceKind,
+                              const MetricsHistory & history)
+{
+    ODL_OBJENTER(); //####
+    ODL_S3s("channelName = ", channelName, "servicePortName = ", servicePortName, //####
+            "serviceKind = ", serviceKind); //####
+    ODL_P1("history = ", &history); //####
+    bool                result = false;
+    ChannelAlertState & state = _channelStates[channelName];
+    MetricsSample       counters;
+    MetricsRates        rates;
+
+    // The rules are only gathered when the channel is first seen or has changed hands, so that
+    // the number of rules doesn't affect the cost of each sample.
+    if ((servicePortName != state._servicePortName) || (serviceKind != state._serviceKind))
+    {
+        for (size_t ii = 0, mm = state._conditions.size(); mm > ii; ++ii)
+        {
+            if (state._conditions[ii]._active)
+            {
+                result = true;
+            }
+        }
+        state._servicePortName = servicePortName;
+        state._serviceKind = serviceKind;
+        prepareChannel(channelName, state);
+    }
+    if ((! state._conditions.empty()) && MetricsThread::getLatestRates(history, rates) &&
+        MetricsThread::getLatestCounters(history, counters))
+    {
+        for (size_t ii = 0, mm = state._conditions.size(); mm > ii; ++ii)
+        {
+            AlertCondition &  aCondition = state._conditions[ii];
+            const AlertRule & aRule = _rules[aCondition._ruleIndex];
+            bool              wasActive = aCondition._active;
+            bool              matches;
+
+            if (kAlertMetricBytes == aRule._metric)
+            {
+                aCondition._value = (rates._inBytesPerSecond + rates._outBytesPerSecond);
+            }
+            else
+            {
+                aCondition._value = (rates._inMessagesPerSecond + rates._outMessagesPerSecond);
+            }
+            if (aRule._above)
+            {
+                matches = (aCondition._value > aRule._threshold);
+            }
+            else
+            {
+                matches = (aCondition._value < aRule._threshold);
+            }
+            if (matches)
+            {
+                if (0 == aCondition._since)
+                {
+                    aCondition._since = counters._time;
+                }
+                aCondition._active = ((counters._time - aCondition._since) >= aRule._duration);
+            }
+            else
+            {
+                aCondition._since = 0;
+                aCondition._active = false;
+            }
+            if (wasActive != aCondition._active)
+            {
+                result = true;
+            }
+        }
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // MetricsAlerts::evaluateSample
+
+void
+MetricsAlerts::getAlerts(MetricsAlertList & alerts)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("alerts = ", &alerts); //####
+    alerts.clear();
+    for (ChannelAlertStateMap::const_iterator walker(_channelStates.begin());
+         _channelStates.end() != walker; ++walker)
+    {
+        const ChannelAlertState & state = walker->second;
+
+        for (size_t ii = 0, mm = state._conditions.size(); mm > ii; ++ii)
+        {
+            const AlertCondition & aCondition = state._conditions[ii];
+
+            if (aCondition._active)
+            {
+                MetricsAlert anAlert;
+
+                anAlert._channelName = walker->first;
+                anAlert._ruleText = _rules[aCondition._ruleIndex]._text;
+                anAlert._servicePortName = state._servicePortName;
+                anAlert._since = aCondition._since;
+                anAlert._value = aCondition._value;
+                alerts.push_back(anAlert);
+            }
+        }
+    }
+    // The rules can't be applied to a service that isn't collecting metrics, so it is listed on
+    // its own.
+    for (ServiceTimeMap::const_iterator walker(_disabledServices.begin());
+         _disabledServices.end() != walker; ++walker)
+    {
+        MetricsAlert anAlert;
+
+        anAlert._ruleText = kMetricsDisabledText;
+        anAlert._servicePortName = walker->first;
+        anAlert._since = walker->second;
+        anAlert._value = 0;
+        alerts.push_back(anAlert);
+    }
+    ODL_OBJEXIT(); //####
+} // MetricsAlerts::getAlerts
+
+void
+MetricsAlerts::loadRules(const String & rulesPath)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("rulesPath = ", rulesPath.toStdString()); //####
+    File rulesFile(File::getCurrentWorkingDirectory().getChildFile(rulesPath));
+
+    if (rulesFile.existsAsFile())
+    {
+        StringArray lines(StringArray::fromLines(rulesFile.loadFileAsString()));
+
+        for (int ii = 0, mm = lines.size(); mm > ii; ++ii)
+        {
+            String aLine(lines[ii].trim());
+
+            if (aLine.isNotEmpty() && (! aLine.startsWithChar('#')))
+            {
+                AlertRule aRule;
+
+                if (parseRule(aLine, aRule))
+                {
+                    size_t index = _rules.size();
+
+                    _rules.push_back(aRule);
+                    if (aRule._byKind)
+                    {
+                        // Service kinds are matched without regard to case.
+                        YarpString kindKey(String(aRule._target.c_str()).toLowerCase().
+                                           toStdString());
+
+                        _kindRules[kindKey].push_back(index);
+                    }
+                    else
+                    {
+                        _channelRules[aRule._target].push_back(index);
+                    }
+                }
+                else
+                {
+                    char buffer1[DATE_TIME_BUFFER_SIZE_];
+                    char buffer2[DATE_TIME_BUFFER_SIZE_];
+
+                    Utilities::GetDateAndTime(buffer1, sizeof(buffer1), buffer2, sizeof(buffer2));
+                    std::cerr << buffer1 << " " << buffer2 << " Ignoring alert rule '" <<
+                                aLine.toStdString() << "' in " << rulesPath.toStdString() <<
+                                std::endl;
+                }
+            }
+        }
+    }
+    else
+    {
+        char buffer1[DATE_TIME_BUFFER_SIZE_];
+        char buffer2[DATE_TIME_BUFFER_SIZE_];
+
+        Utilities::GetDateAndTime(buffer1, sizeof(buffer1), buffer2, sizeof(buffer2));
+        std::cerr << buffer1 << " " << buffer2 << " Could not read " << rulesPath.toStdString() <<
+                    std::endl;
+    }
+    ODL_OBJEXIT(); //####
+} // MetricsAlerts::loadRules
+
+void
+MetricsAlerts::prepareChannel(const YarpString &  channelName,
+                              ChannelAlertState & state)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("channelName = ", channelName); //####
+    ODL_P1("state = ", &state); //####
+    YarpString                        kindKey(String(state._serviceKind.c_str()).toLowerCase().
+                                              toStdString());
+    AlertRuleIndexMap::const_iterator channelMatch(_channelRules.find(channelName));
+    AlertRuleIndexMap::const_iterator kindMatch(_kindRules.find(kindKey));
+    std::vector<size_t>               indices;
+
+    if (_channelRules.end() != channelMatch)
+    {
+        indices.insert(indices.end(), channelMatch->second.begin(), channelMatch->second.end());
+    }
+    if (_kindRules.end() != kindMatch)
+    {
+        indices.insert(indices.end(), kindMatch->second.begin(), kindMatch->second.end());
+    }
+    state._conditions.clear();
+    for (size_t ii = 0, mm = indices.size(); mm > ii; ++ii)
+    {
+        AlertCondition aCondition;
+
+        aCondition._ruleIndex = indices[ii];
+        aCondition._since = 0;
+        aCondition._value = 0;
+        aCondition._active = false;
+        state._conditions.push_back(aCondition);
+    }
+    ODL_OBJEXIT(); //####
+} // MetricsAlerts::prepareChannel
+
+bool
+MetricsAlerts::removeUnseenChannels(const PortSet & seenChannels,
+                                    const PortSet & silentServices)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("seenChannels = ", &seenChannels, "silentServices = ", &silentServices); //####
+    bool result = false;
+
+    for (ChannelAlertStateMap::iterator walker(_channelStates.begin());
+         _channelStates.end() != walker; )
+    {
+        const ChannelAlertState & state = walker->second;
+
+        // A service that has stopped responding is not a reason to clear its alerts, as a hung
+        // service is often what the rules are watching for.
+        if ((seenChannels.end() == seenChannels.find(walker->first)) &&
+            (silentServices.end() == silentServices.find(state._servicePortName)))
+        {
+            for (size_t ii = 0, mm = state._conditions.size(); mm > ii; ++ii)
+            {
+                if (state._conditions[ii]._active)
+                {
+                    result = true;
+                }
+            }
+            _channelStates.erase(walker++);
+        }
+        else
+        {
+            ++walker;
+        }
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // MetricsAlerts::removeUnseenChannels
+
+bool
+MetricsAlerts::setDisabledServices(const PortSet & disabledServices)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("disabledServices = ", &disabledServices); //####
+    bool           result = (disabledServices.size() != _disabledServices.size());
+    int64          now = Time::currentTimeMillis();
+    ServiceTimeMap newServices;
+
+    for (PortSet::const_iterator walker(disabledServices.begin());
+         disabledServices.end() != walker; ++walker)
+    {
+        ServiceTimeMap::const_iterator match(_disabledServices.find(*walker));
+
+        if (_disabledServices.end() == match)
+        {
+            newServices[*walker] = now;
+            result = true;
+        }
+        else
+        {
+            newServices[*walker] = match->second;
+        }
+    }
+    _disabledServices.swap(newServices);
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // MetricsAlerts::setDisabledServices
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
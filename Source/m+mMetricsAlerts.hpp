@@ -0,0 +1,183 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mMetricsAlerts.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for the evaluation of alert rules against the collected
+//              metrics.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-18
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmMetricsAlerts_HPP_))
+# define mpmMetricsAlerts_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for the evaluation of alert rules against the collected metrics. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    /*! @brief Raises alerts when the traffic of a channel crosses a threshold for long enough.
+     The rules are read from the file named by an environment variable, one rule per line, in the
+     form:
+
+     (channel|kind) target (bytes|messages) (above|below) threshold [seconds]
+
+     where 'target' is a channel name or a service kind, such as 'Filter', and 'threshold' is a
+     rate per second of the traffic sent and received. Blank lines and lines starting with '#' are
+     ignored. The rules that apply to a channel are gathered when the channel is first seen, so
+     the work done for each sample depends only on the rules for that channel. */
+    class MetricsAlerts
+    {
+    public :
+
+    protected :
+
+    private :
+
+    public :
+
+        /*! @brief The constructor. */
+        MetricsAlerts(void);
+
+        /*! @brief The destructor. */
+        virtual
+        ~MetricsAlerts(void);
+
+        /*! @brief Return @c true if a rule applies to a service or to one of its channels.
+         @param[in] serviceKind The kind of the service.
+         @param[in] channels The channels of the service.
+         @returns @c true if a rule applies to the service and @c false otherwise. */
+        bool
+        appliesToService(const YarpString & serviceKind,
+                         const PortSet &    channels)
+        const;
+
+        /*! @brief Apply the rules for a channel to its most recent sample.
+         @param[in] channelName The name of the channel.
+         @param[in] servicePortName The name of the primary port of the service that owns the
+         channel.
+         @param[in] serviceKind The kind of the service that owns the channel.
+         @param[in] history The metrics history of the channel.
+         @returns @c true if an alert was raised or cleared and @c false otherwise. */
+        bool
+        evaluateSample(const YarpString &     channelName,
+                       const YarpString &     servicePortName,
+                       const YarpString &     serviceKind,
+                       const MetricsHistory & history);
+
+        /*! @brief Return the alerts that have been raised.
+         @param[out] alerts The alerts that have been raised. */
+        void
+        getAlerts(MetricsAlertList & alerts)
+        const;
+
+        /*! @brief Return @c true if there are rules to be applied.
+         @returns @c true if there are rules to be applied and @c false otherwise. */
+        inline bool
+        isActive(void)
+        const
+        {
+            return (! _rules.empty());
+        } // isActive
+
+        /*! @brief Forget the channels that were not part of the most recent collection, except
+         for those of services that did not respond.
+         @param[in] seenChannels The channels that were part of the most recent collection.
+         @param[in] silentServices The primary ports of the services that did not respond.
+         @returns @c true if an alert was cleared and @c false otherwise. */
+        bool
+        removeUnseenChannels(const PortSet & seenChannels,
+                             const PortSet & silentServices);
+
+        /*! @brief Record the services that a rule applies to but that are not collecting
+         metrics, so that they can be listed with the alerts.
+         @param[in] disabledServices The primary ports of the services.
+         @returns @c true if the services differ from those last recorded and @c false otherwise. */
+        bool
+        setDisabledServices(const PortSet & disabledServices);
+
+    protected :
+
+    private :
+
+        /*! @brief Read the rules from a file.
+         @param[in] rulesPath The path to the file. */
+        void
+        loadRules(const String & rulesPath);
+
+        /*! @brief Gather the rules that apply to a channel.
+         @param[in] channelName The name of the channel.
+         @param[in,out] state The alert rules for the channel. */
+        void
+        prepareChannel(const YarpString &  channelName,
+                       ChannelAlertState & state);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The positions of the rules that apply to each channel. */
+        AlertRuleIndexMap _channelRules;
+
+        /*! @brief The positions of the rules that apply to each kind of service. */
+        AlertRuleIndexMap _kindRules;
+
+        /*! @brief The alert rules. */
+        AlertRuleList _rules;
+
+        /*! @brief The rules that apply to each channel that has been seen, and their states. */
+        ChannelAlertStateMap _channelStates;
+
+        /*! @brief The services that a rule applies to but that are not collecting metrics, and
+         the times at which they were first seen that way. */
+        ServiceTimeMap _disabledServices;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MetricsAlerts)
+
+    }; // MetricsAlerts
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmMetricsAlerts_HPP_)
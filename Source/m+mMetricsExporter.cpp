@@ -0,0 +1,461 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mMetricsExporter.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for writing the collected metrics to local files.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-18
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mMetricsExporter.hpp"
+#include "m+mManagerApplication.hpp"
+#include "m+mMetricsThread.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for writing the collected metrics to local files. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+using namespace std;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The heading line of the CSV file. */
+static const char * kCsvFileHeader = "time,kind,name,in bytes,out bytes,in messages,out messages,"
+                                     "in bytes/s,out bytes/s,in messages/s,out messages/s";
+
+/*! @brief The number of older CSV files that are kept when the file is rotated. */
+static const int kCsvFilesKept = 4;
+
+/*! @brief The environment variable that holds the path to the CSV file. */
+static const char * kCsvFileVariable = "MPM_MANAGER_METRICS_CSV_FILE";
+
+/*! @brief The environment variable that holds the size at which the CSV file is rotated, in
+ kilobytes. */
+static const char * kCsvLimitVariable = "MPM_MANAGER_METRICS_CSV_LIMIT";
+
+/*! @brief The size at which the CSV file is rotated, in bytes, if it is not set by the
+ environment. */
+static const int64 kDefaultCsvSizeLimit = (1024 * 1024);
+
+/*! @brief The environment variable that holds the path to the Prometheus file. */
+static const char * kPrometheusFileVariable = "MPM_MANAGER_METRICS_PROMETHEUS_FILE";
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Prepare a name for use as a CSV field.
+ @param[in] aName The name to be prepared.
+ @returns The name, quoted. */
+static String
+escapeCsvField(const YarpString & aName)
+{
+    ODL_ENTER(); //####
+    ODL_S1s("aName = ", aName); //####
+    String result("\"" + String(aName.c_str()).replace("\"", "\"\"") + "\"");
+
+    ODL_EXIT_s(result.toStdString()); //####
+    return result;
+} // escapeCsvField
+
+/*! @brief Prepare a name for use as a Prometheus label value.
+ @param[in] aName The name to be prepared.
+ @returns The name, with the characters that can't appear in a label value escaped. */
+static String
+escapePrometheusLabel(const YarpString & aName)
+{
+    ODL_ENTER(); //####
+    ODL_S1s("aName = ", aName); //####
+    String result(aName.c_str());
+
+    result = result.replace("\\", "\\\\").replace("\"", "\\\"").replace("\n", "\\n");
+    ODL_EXIT_s(result.toStdString()); //####
+    return result;
+} // escapePrometheusLabel
+
+/*! @brief Write a line to the Prometheus file.
+ @param[in,out] outStream The stream to be written to.
+ @param[in] metricName The name of the metric.
+ @param[in] labelName The name of the label that identifies the channel or service.
+ @param[in] aName The name of the channel or service.
+ @param[in] direction The direction of the traffic.
+ @param[in] value The value of the metric. */
+static void
+writePrometheusLine(std::ostream &     outStream,
+                    const String &     metricName,
+                    const char *       labelName,
+                    const YarpString & aName,
+                    const char *       direction,
+                    const double       value)
+{
+    ODL_ENTER(); //####
+    ODL_P1("outStream = ", &outStream); //####
+    ODL_S4s("metricName = ", metricName.toStdString(), "labelName = ", labelName, //####
+            "aName = ", aName, "direction = ", direction); //####
+    ODL_D1("value = ", value); //####
+    outStream << metricName << "{" << labelName << "=\"" << escapePrometheusLabel(aName) <<
+                "\",direction=\"" << direction << "\"} " << String(value, 3) << std::endl;
+    ODL_EXIT(); //####
+} // writePrometheusLine
+
+/*! @brief Write the metrics for a set of channels or services to the Prometheus file.
+ @param[in,out] outStream The stream to be written to.
+ @param[in] prefix The prefix for the names of the metrics.
+ @param[in] labelName The name of the label that identifies the channel or service.
+ @param[in] histories The metrics histories of the channels or services. */
+static void
+writePrometheusSet(std::ostream &            outStream,
+                   const String &            prefix,
+                   const char *              labelName,
+                   const MetricsHistoryMap & histories)
+{
+    ODL_ENTER(); //####
+    ODL_P2("outStream = ", &outStream, "histories = ", &histories); //####
+    ODL_S2s("prefix = ", prefix.toStdString(), "labelName = ", labelName); //####
+    // The lines for each metric must be together, so the histories are examined once per metric.
+    outStream << "# HELP " << prefix << "_bytes_total The number of bytes carried." << std::endl;
+    outStream << "# TYPE " << prefix << "_bytes_total counter" << std::endl;
+    for (MetricsHistoryMap::const_iterator walker(histories.begin()); histories.end() != walker;
+         ++walker)
+    {
+        MetricsSample counters;
+
+        if (MetricsThread::getLatestCounters(walker->second, counters))
+        {
+            writePrometheusLine(outStream, prefix + "_bytes_total", labelName, walker->first, "in",
+                                static_cast<double>(counters._inBytes));
+            writePrometheusLine(outStream, prefix + "_bytes_total", labelName, walker->first, "out",
+                                static_cast<double>(counters._outBytes));
+        }
+    }
+    outStream << "# HELP " << prefix << "_messages_total The number of messages carried." <<
+                std::endl;
+    outStream << "# TYPE " << prefix << "_messages_total counter" << std::endl;
+    for (MetricsHistoryMap::const_iterator walker(histories.begin()); histories.end() != walker;
+         ++walker)
+    {
+        MetricsSample counters;
+
+        if (MetricsThread::getLatestCounters(walker->second, counters))
+        {
+            writePrometheusLine(outStream, prefix + "_messages_total", labelName, walker->first,
+                                "in", static_cast<double>(counters._inMessages));
+            writePrometheusLine(outStream, prefix + "_messages_total", labelName, walker->first,
+                                "out", static_cast<double>(counters._outMessages));
+        }
+    }
+    outStream << "# HELP " << prefix << "_bytes_per_second The most recent rate of bytes." <<
+                std::endl;
+    outStream << "# TYPE " << prefix << "_bytes_per_second gauge" << std::endl;
+    for (MetricsHistoryMap::const_iterator walker(histories.begin()); histories.end() != walker;
+         ++walker)
+    {
+        MetricsRates rates;
+
+        if (MetricsThread::getLatestRates(walker->second, rates))
+        {
+            writePrometheusLine(outStream, prefix + "_bytes_per_second", labelName, walker->first,
+                                "in", rates._inBytesPerSecond);
+            writePrometheusLine(outStream, prefix + "_bytes_per_second", labelName, walker->first,
+                                "out", rates._outBytesPerSecond);
+        }
+    }
+    outStream << "# HELP " << prefix << "_messages_per_second The most recent rate of messages." <<
+                std::endl;
+    outStream << "# TYPE " << prefix << "_messages_per_second gauge" << std::endl;
+    for (MetricsHistoryMap::const_iterator walker(histories.begin()); histories.end() != walker;
+         ++walker)
+    {
+        MetricsRates rates;
+
+        if (MetricsThread::getLatestRates(walker->second, rates))
+        {
+            writePrometheusLine(outStream, prefix + "_messages_per_second", labelName,
+                                walker->first, "in", rates._inMessagesPerSecond);
+            writePrometheusLine(outStream, prefix + "_messages_per_second", labelName,
+                                walker->first, "out", rates._outMessagesPerSecond);
+        }
+    }
+    ODL_EXIT(); //####
+} // writePrometheusSet
+
+/*! @brief Write the rows for a set of channels or services to the CSV file.
+ @param[in,out] outStream The stream to be written to.
+ @param[in] timeStamp The time of the collection, as text.
+ @param[in] kind The kind of the rows.
+ @param[in] histories The metrics histories of the channels or services. */
+static void
+writeCsvRows(OutputStream &            outStream,
+             const String &            timeStamp,
+             const char *              kind,
+             const MetricsHistoryMap & histories)
+{
+    ODL_ENTER(); //####
+    ODL_P2("outStream = ", &outStream, "histories = ", &histories); //####
+    ODL_S2s("timeStamp = ", timeStamp.toStdString(), "kind = ", kind); //####
+    for (MetricsHistoryMap::const_iterator walker(histories.begin()); histories.end() != walker;
+         ++walker)
+    {
+        MetricsSample counters;
+
+        if (MetricsThread::getLatestCounters(walker->second, counters))
+        {
+            MetricsRates rates;
+            String       aRow(timeStamp + "," + kind + "," + escapeCsvField(walker->first) + "," +
+                              String(counters._inBytes) + "," + String(counters._outBytes) + "," +
+                              String(counters._inMessages) + "," +
+                              String(counters._outMessages));
+
+            // The rates are left empty until there are two samples to work them out from.
+            if (MetricsThread::getLatestRates(walker->second, rates))
+            {
+                aRow += "," + String(rates._inBytesPerSecond, 3) + "," +
+                        String(rates._outBytesPerSecond, 3) + "," +
+                        String(rates._inMessagesPerSecond, 3) + "," +
+                        String(rates._outMessagesPerSecond, 3);
+            }
+            else
+            {
+                aRow += ",,,,";
+            }
+            outStream.writeText(aRow + "\n", false, false);
+        }
+    }
+    ODL_EXIT(); //####
+} // writeCsvRows
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+MetricsExporter::MetricsExporter(void) :
+    _csvPath(ManagerApplication::getEnvironmentVar(kCsvFileVariable)),
+    _prometheusPath(ManagerApplication::getEnvironmentVar(kPrometheusFileVariable)),
+    _csvSizeLimit(kDefaultCsvSizeLimit)
+{
+    ODL_ENTER(); //####
+    String sizeLimit(ManagerApplication::getEnvironmentVar(kCsvLimitVariable));
+    File   workingDirectory(File::getCurrentWorkingDirectory());
+
+    if (0 < sizeLimit.getLargeIntValue())
+    {
+        _csvSizeLimit = sizeLimit.getLargeIntValue() * 1024;
+    }
+    // Relative paths are taken from the directory that the application was started in.
+    if (_csvPath.isNotEmpty())
+    {
+        _csvPath = workingDirectory.getChildFile(_csvPath).getFullPathName();
+    }
+    if (_prometheusPath.isNotEmpty())
+    {
+        _prometheusPath = workingDirectory.getChildFile(_prometheusPath).getFullPathName();
+    }
+    ODL_EXIT_P(this); //####
+} // MetricsExporter::MetricsExporter
+
+MetricsExporter::~MetricsExporter(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // MetricsExporter::~MetricsExporter
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+MetricsExporter::exportMetrics(const MetricsHistoryMap & channelHistories,
+                               const MetricsHistoryMap & serviceHistories,
+                               const ScannerHealth &     health)
+{
+    ODL_OBJENTER(); //####
+    ODL_P3("channelHistories = ", &channelHistories, "serviceHistories = ", //####
+           &serviceHistories, "health = ", &health); //####
+    if (_prometheusPath.isNotEmpty())
+    {
+        writePrometheusFile(channelHistories, serviceHistories, health);
+    }
+    if (_csvPath.isNotEmpty())
+    {
+        writeCsvFile(channelHistories, serviceHistories);
+    }
+    ODL_OBJEXIT(); //####
+} // MetricsExporter::exportMetrics
+
+void
+MetricsExporter::rotateCsvFile(void)
+{
+    ODL_OBJENTER(); //####
+    File csvFile(_csvPath);
+
+    if (csvFile.existsAsFile() && (_csvSizeLimit <= csvFile.getSize()))
+    {
+        // The oldest file is dropped, and the others are each moved along by one.
+        File(_csvPath + "." + String(kCsvFilesKept)).deleteFile();
+        for (int ii = kCsvFilesKept - 1; 0 < ii; --ii)
+        {
+            File olderFile(_csvPath + "." + String(ii));
+
+            if (olderFile.existsAsFile())
+            {
+                olderFile.moveFileTo(File(_csvPath + "." + String(ii + 1)));
+            }
+        }
+        if (! csvFile.moveFileTo(File(_csvPath + ".1")))
+        {
+            char buffer1[DATE_TIME_BUFFER_SIZE_];
+            char buffer2[DATE_TIME_BUFFER_SIZE_];
+
+            Utilities::GetDateAndTime(buffer1, sizeof(buffer1), buffer2, sizeof(buffer2));
+            std::cerr << buffer1 << " " << buffer2 << " Could not rotate " <<
+                        _csvPath.toStdString() << std::endl;
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // MetricsExporter::rotateCsvFile
+
+void
+MetricsExporter::writeCsvFile(const MetricsHistoryMap & channelHistories,
+                              const MetricsHistoryMap & serviceHistories)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("channelHistories = ", &channelHistories, "serviceHistories = ", //####
+           &serviceHistories); //####
+    rotateCsvFile();
+    File             csvFile(_csvPath);
+    bool             isNewFile = ((! csvFile.existsAsFile()) || (0 == csvFile.getSize()));
+    FileOutputStream outStream(csvFile);
+
+    if (outStream.failedToOpen())
+    {
+        char buffer1[DATE_TIME_BUFFER_SIZE_];
+        char buffer2[DATE_TIME_BUFFER_SIZE_];
+
+        Utilities::GetDateAndTime(buffer1, sizeof(buffer1), buffer2, sizeof(buffer2));
+        std::cerr << buffer1 << " " << buffer2 << " Could not open " << _csvPath.toStdString() <<
+                    std::endl;
+    }
+    else
+    {
+        String timeStamp(Time::getCurrentTime().formatted("%Y-%m-%d %H:%M:%S"));
+
+        if (isNewFile)
+        {
+            outStream.writeText(String(kCsvFileHeader) + "\n", false, false);
+        }
+        writeCsvRows(outStream, timeStamp, "service", serviceHistories);
+        writeCsvRows(outStream, timeStamp, "channel", channelHistories);
+        outStream.flush();
+    }
+    ODL_OBJEXIT(); //####
+} // MetricsExporter::writeCsvFile
+
+void
+MetricsExporter::writePrometheusFile(const MetricsHistoryMap & channelHistories,
+                                     const MetricsHistoryMap & serviceHistories,
+                                     const ScannerHealth &     health)
+{
+    ODL_OBJENTER(); //####
+    ODL_P3("channelHistories = ", &channelHistories, "serviceHistories = ", //####
+           &serviceHistories, "health = ", &health); //####
+    std::stringstream buff;
+    File              prometheusFile(_prometheusPath);
+
+    writePrometheusSet(buff, "mpm_service", "service", serviceHistories);
+    writePrometheusSet(buff, "mpm_channel", "channel", channelHistories);
+    buff << "# HELP mpm_scanner_scans_total The number of scans that have succeeded." <<
+            std::endl;
+    buff << "# TYPE mpm_scanner_scans_total counter" << std::endl;
+    buff << "mpm_scanner_scans_total " << health._scansCompleted << std::endl;
+    buff << "# HELP mpm_scanner_failed_scans_total The number of scans that could not gather the "
+            "ports." << std::endl;
+    buff << "# TYPE mpm_scanner_failed_scans_total counter" << std::endl;
+    buff << "mpm_scanner_failed_scans_total " << health._scansFailed << std::endl;
+    buff << "# HELP mpm_scanner_last_scan_duration_seconds The time taken by the most recent "
+            "scan." << std::endl;
+    buff << "# TYPE mpm_scanner_last_scan_duration_seconds gauge" << std::endl;
+    buff << "mpm_scanner_last_scan_duration_seconds " <<
+            String(health._lastScanDuration / 1000.0, 3) << std::endl;
+    buff << "# HELP mpm_scanner_last_success_timestamp_seconds The time at which the most recent "
+            "successful scan finished." << std::endl;
+    buff << "# TYPE mpm_scanner_last_success_timestamp_seconds gauge" << std::endl;
+    buff << "mpm_scanner_last_success_timestamp_seconds " << (health._lastScanTime / 1000) <<
+            std::endl;
+    // The file is replaced in one go, so that a reader never sees a partial file.
+    if (prometheusFile.getParentDirectory().createDirectory().wasOk())
+    {
+        TemporaryFile tempFile(prometheusFile);
+
+        if ((! tempFile.getFile().replaceWithText(buff.str())) ||
+            (! tempFile.overwriteTargetFileWithTemporary()))
+        {
+            char buffer1[DATE_TIME_BUFFER_SIZE_];
+            char buffer2[DATE_TIME_BUFFER_SIZE_];
+
+            Utilities::GetDateAndTime(buffer1, sizeof(buffer1), buffer2, sizeof(buffer2));
+            std::cerr << buffer1 << " " << buffer2 << " Could not replace " <<
+                        _prometheusPath.toStdString() << std::endl;
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // MetricsExporter::writePrometheusFile
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
@@ -0,0 +1,145 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mMetricsExporter.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for writing the collected metrics to local files.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-18
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmMetricsExporter_HPP_))
+# define mpmMetricsExporter_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for writing the collected metrics to local files. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    /*! @brief Writes the collected metrics to local files, for use by other tools.
+     The files are named by environment variables, and nothing is written if they are not set. A
+     file in the Prometheus text exposition format is replaced after each collection, so that it can
+     be read by a 'textfile' collector, and rows are added to a CSV file, which is rotated when it
+     becomes too large. Only the data that has already been collected is written, so the services
+     are not asked for anything more. */
+    class MetricsExporter
+    {
+    public :
+
+    protected :
+
+    private :
+
+    public :
+
+        /*! @brief The constructor. */
+        MetricsExporter(void);
+
+        /*! @brief The destructor. */
+        virtual
+        ~MetricsExporter(void);
+
+        /*! @brief Write the collected metrics to the files.
+         @param[in] channelHistories The metrics histories of the channels.
+         @param[in] serviceHistories The metrics histories of the services.
+         @param[in] health The figures for the scanner. */
+        void
+        exportMetrics(const MetricsHistoryMap & channelHistories,
+                      const MetricsHistoryMap & serviceHistories,
+                      const ScannerHealth &     health);
+
+        /*! @brief Return @c true if there are files to be written.
+         @returns @c true if there are files to be written and @c false otherwise. */
+        inline bool
+        isActive(void)
+        const
+        {
+            return (_csvPath.isNotEmpty() || _prometheusPath.isNotEmpty());
+        } // isActive
+
+    protected :
+
+    private :
+
+        /*! @brief Move the CSV file aside if it has become too large. */
+        void
+        rotateCsvFile(void);
+
+        /*! @brief Add rows for the collected metrics to the CSV file.
+         @param[in] channelHistories The metrics histories of the channels.
+         @param[in] serviceHistories The metrics histories of the services. */
+        void
+        writeCsvFile(const MetricsHistoryMap & channelHistories,
+                     const MetricsHistoryMap & serviceHistories);
+
+        /*! @brief Replace the Prometheus file with the collected metrics.
+         @param[in] channelHistories The metrics histories of the channels.
+         @param[in] serviceHistories The metrics histories of the services.
+         @param[in] health The figures for the scanner. */
+        void
+        writePrometheusFile(const MetricsHistoryMap & channelHistories,
+                            const MetricsHistoryMap & serviceHistories,
+                            const ScannerHealth &     health);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The full path to the CSV file, or an empty string if it is not to be written. */
+        String _csvPath;
+
+        /*! @brief The full path to the Prometheus file, or an empty string if it is not to be
+         written. */
+        String _prometheusPath;
+
+        /*! @brief The size at which the CSV file is rotated, in bytes. */
+        int64 _csvSizeLimit;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MetricsExporter)
+
+    }; // MetricsExporter
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmMetricsExporter_HPP_)
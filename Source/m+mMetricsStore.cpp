@@ -0,0 +1,772 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mMetricsStore.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for the long-term storage of the collected metrics.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-18
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mMetricsStore.hpp"
+#include "m+mManagerApplication.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for the long-term storage of the collected metrics. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+using namespace std;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The layout of the start of a segment file, which is followed by the records. */
+struct SegmentHeader
+{
+    /*! @brief The value that identifies a segment file. */
+    uint32 _magic;
+
+    /*! @brief The number of records that have been written to the segment. */
+    uint32 _recordCount;
+
+    /*! @brief The time of the first record, in milliseconds since the epoch. */
+    int64 _firstTime;
+
+    /*! @brief The time of the most recent record, in milliseconds since the epoch. */
+    int64 _lastTime;
+
+}; // SegmentHeader
+
+/*! @brief The names of a set of channels, indexed by the identifiers used in the segments. */
+typedef std::map<int64, YarpString> ChannelKeyMap;
+
+/*! @brief The most recent record for each channel in each interval, indexed by the channel key
+ and the interval number. */
+typedef std::map<std::pair<int64, int64>, MetricsStoreRecord> ReducedRecordMap;
+
+/*! @brief The maximum space taken by the segments, in bytes, if it is not set by the
+ environment. */
+static const int64 kDefaultSizeLimit = (256 * 1024 * 1024);
+
+/*! @brief The environment variable that holds the directory for the segments. */
+static const char * kDirectoryVariable = "MPM_MANAGER_METRICS_STORE_DIRECTORY";
+
+/*! @brief The environment variable that holds the maximum space taken by the segments, in
+ megabytes. */
+static const char * kLimitVariable = "MPM_MANAGER_METRICS_STORE_LIMIT";
+
+/*! @brief The number of records in each segment. */
+static const uint32 kRecordsPerSegment = 8192;
+
+/*! @brief The value that identifies a segment file. */
+static const uint32 kSegmentMagic = 0x4D704D53;
+
+/*! @brief The suffix of the segment files. */
+static const char * kSegmentSuffix = ".mpms";
+
+/*! @brief The number of tiers of segments. */
+static const size_t kTierCount = 3;
+
+/*! @brief The age at which a segment is reduced into the next tier, in milliseconds, for each
+ tier. The last tier is never reduced. */
+static const int64 kTierAges[kTierCount] =
+{
+    (24 * 60 * 60 * 1000LL), (14 * 24 * 60 * 60 * 1000LL), 0
+};
+
+/*! @brief The interval between the samples kept for a channel, in milliseconds, for each tier.
+ The first tier keeps every sample. */
+static const int64 kTierIntervals[kTierCount] =
+{
+    0, (60 * 1000LL), (60 * 60 * 1000LL)
+};
+
+/*! @brief The name of the directory for the segments of each tier. */
+static const char * kTierNames[kTierCount] =
+{
+    "raw", "minute", "hour"
+};
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Return @c true if the first record was collected before the second.
+ @param[in] first The first record to compare.
+ @param[in] second The second record to compare.
+ @returns @c true if the first record was collected before the second. */
+static bool
+compareRecordTimes(const MetricsStoreRecord & first,
+                   const MetricsStoreRecord & second)
+{
+    return (first._counters._time < second._counters._time);
+} // compareRecordTimes
+
+/*! @brief Return @c true if the first sample was collected before the second.
+ @param[in] first The first sample to compare.
+ @param[in] second The second sample to compare.
+ @returns @c true if the first sample was collected before the second. */
+static bool
+compareSampleTimes(const MetricsSample & first,
+                   const MetricsSample & second)
+{
+    return (first._time < second._time);
+} // compareSampleTimes
+
+/*! @brief Return the amount that a counter has grown between two samples.
+ @param[in] earlier The value of the counter in the earlier sample.
+ @param[in] later The value of the counter in the later sample.
+ @returns The growth of the counter, treating a counter that went backwards as having restarted
+ from zero. */
+static int64
+getCounterGrowth(const int64 earlier,
+                 const int64 later)
+{
+    return ((earlier <= later) ? (later - earlier) : later);
+} // getCounterGrowth
+
+/*! @brief Return the size of a segment file.
+ @returns The size of a segment file, in bytes. */
+static int64
+getSegmentSize(void)
+{
+    return static_cast<int64>(sizeof(SegmentHeader) +
+                              (kRecordsPerSegment * sizeof(MetricsStoreRecord)));
+} // getSegmentSize
+
+/*! @brief Return the segment files in a directory, oldest first.
+ @param[in] tierDirectory The directory to be examined.
+ @param[out] paths The paths to the segment files. */
+static void
+getSegmentPaths(const File &  tierDirectory,
+                StringArray & paths)
+{
+    ODL_ENTER(); //####
+    ODL_P1("paths = ", &paths); //####
+    Array<File> segmentFiles;
+
+    paths.clear();
+    tierDirectory.findChildFiles(segmentFiles, File::findFiles, false,
+                                 String("*") + kSegmentSuffix);
+    for (int ii = 0, mm = segmentFiles.size(); mm > ii; ++ii)
+    {
+        paths.add(segmentFiles[ii].getFullPathName());
+    }
+    // The files are named for the time of their first record, padded to a fixed width, so that
+    // sorting the names sorts the segments by age.
+    paths.sort(false);
+    ODL_EXIT(); //####
+} // getSegmentPaths
+
+/*! @brief Return the identifier used for a channel in the segments.
+ @param[in] channelName The name of the channel.
+ @returns The identifier for the channel. */
+static int64
+makeChannelKey(const YarpString & channelName)
+{
+    ODL_ENTER(); //####
+    ODL_S1s("channelName = ", channelName); //####
+    int64 result = String(channelName.c_str()).hashCode64();
+
+    ODL_EXIT_LL(result); //####
+    return result;
+} // makeChannelKey
+
+/*! @brief Map a segment file into memory, checking that it is a valid segment.
+ @param[in] segmentFile The segment file to be mapped.
+ @param[in] mode How the segment will be accessed.
+ @returns The mapped segment, or @c NULL if the file is not a valid segment. */
+static MemoryMappedFile *
+mapSegment(const File &                     segmentFile,
+           const MemoryMappedFile::AccessMode mode)
+{
+    ODL_ENTER(); //####
+    MemoryMappedFile * result = new MemoryMappedFile(segmentFile, mode);
+
+    if (result->getData() && (getSegmentSize() == static_cast<int64>(result->getSize())))
+    {
+        const SegmentHeader * header = static_cast<const SegmentHeader *>(result->getData());
+
+        if ((kSegmentMagic != header->_magic) || (kRecordsPerSegment < header->_recordCount))
+        {
+            delete result;
+            result = NULL;
+        }
+    }
+    else
+    {
+        delete result;
+        result = NULL;
+    }
+    ODL_EXIT_P(result); //####
+    return result;
+} // mapSegment
+
+/*! @brief Create an empty segment file.
+ @param[in] segmentFile The segment file to be created.
+ @returns @c true if the segment file was created and @c false otherwise. */
+static bool
+createSegment(const File & segmentFile)
+{
+    ODL_ENTER(); //####
+    bool result = segmentFile.create().wasOk();
+
+    if (result)
+    {
+        FileOutputStream outStream(segmentFile);
+        SegmentHeader    header;
+
+        // The file is written out at its full size, so that it never has to grow while mapped.
+        memset(&header, 0, sizeof(header));
+        header._magic = kSegmentMagic;
+        result = ((! outStream.failedToOpen()) && outStream.setPosition(0) &&
+                  outStream.truncate().wasOk() && outStream.write(&header, sizeof(header)) &&
+                  outStream.writeRepeatedByte(0, static_cast<size_t>(getSegmentSize() -
+                                                                     sizeof(header))));
+        outStream.flush();
+    }
+    ODL_EXIT_B(result); //####
+    return result;
+} // createSegment
+
+/*! @brief Report a problem with a file of the store.
+ @param[in] problem The description of the problem.
+ @param[in] aFile The file that had the problem. */
+static void
+reportProblem(const char * problem,
+              const File & aFile)
+{
+    ODL_ENTER(); //####
+    ODL_S1("problem = ", problem); //####
+    char buffer1[DATE_TIME_BUFFER_SIZE_];
+    char buffer2[DATE_TIME_BUFFER_SIZE_];
+
+    Utilities::GetDateAndTime(buffer1, sizeof(buffer1), buffer2, sizeof(buffer2));
+    std::cerr << buffer1 << " " << buffer2 << " " << problem << " " <<
+                aFile.getFullPathName().toStdString() << std::endl;
+    ODL_EXIT(); //####
+} // reportProblem
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+bool
+MetricsStore::getAverageRates(const MetricsSampleList & samples,
+                              MetricsRates &            rates)
+{
+    ODL_ENTER(); //####
+    ODL_P2("samples = ", &samples, "rates = ", &rates); //####
+    bool result = (1 < samples.size());
+
+    if (result)
+    {
+        double seconds = ((samples.back()._time - samples.front()._time) / 1000.0);
+
+        result = (0 < seconds);
+        if (result)
+        {
+            MetricsSample total;
+
+            total._inBytes = total._inMessages = total._outBytes = total._outMessages = 0;
+            for (size_t ii = 1, mm = samples.size(); mm > ii; ++ii)
+            {
+                const MetricsSample & earlier = samples[ii - 1];
+                const MetricsSample & later = samples[ii];
+
+                total._inBytes += getCounterGrowth(earlier._inBytes, later._inBytes);
+                total._inMessages += getCounterGrowth(earlier._inMessages, later._inMessages);
+                total._outBytes += getCounterGrowth(earlier._outBytes, later._outBytes);
+                total._outMessages += getCounterGrowth(earlier._outMessages, later._outMessages);
+            }
+            rates._inBytesPerSecond = (total._inBytes / seconds);
+            rates._inMessagesPerSecond = (total._inMessages / seconds);
+            rates._outBytesPerSecond = (total._outBytes / seconds);
+            rates._outMessagesPerSecond = (total._outMessages / seconds);
+        }
+    }
+    ODL_EXIT_B(result); //####
+    return result;
+} // MetricsStore::getAverageRates
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+MetricsStore::MetricsStore(void) :
+    _directory(), _rawSegment(), _lock(), _rawSegmentFile(), _segmentRanges(kTierCount),
+    _sizeLimit(kDefaultSizeLimit)
+{
+    ODL_ENTER(); //####
+    String directoryPath(ManagerApplication::getEnvironmentVar(kDirectoryVariable));
+    String sizeLimit(ManagerApplication::getEnvironmentVar(kLimitVariable));
+
+    if (0 < sizeLimit.getLargeIntValue())
+    {
+        _sizeLimit = sizeLimit.getLargeIntValue() * 1024 * 1024;
+    }
+    if (directoryPath.isNotEmpty())
+    {
+        File directory(File::getCurrentWorkingDirectory().getChildFile(directoryPath));
+
+        if (directory.createDirectory().wasOk())
+        {
+            _directory = directory;
+            loadSegmentRanges();
+            // Segments left by an earlier session may have aged while the application wasn't
+            // running.
+            performMaintenance();
+        }
+        else
+        {
+            reportProblem("Could not create", directory);
+        }
+    }
+    ODL_EXIT_P(this); //####
+} // MetricsStore::MetricsStore
+
+MetricsStore::~MetricsStore(void)
+{
+    ODL_OBJENTER(); //####
+    const ScopedLock lock(_lock);
+
+    _rawSegment = NULL;
+    ODL_OBJEXIT(); //####
+} // MetricsStore::~MetricsStore
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+MetricsStore::addRecords(const MetricsRecordList & records)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("records = ", &records); //####
+    if (isActive() && (! records.empty()))
+    {
+        const ScopedLock       lock(_lock);
+        MetricsStoreRecordList storeRecords;
+
+        for (MetricsRecordList::const_iterator walker(records.begin()); records.end() != walker;
+             ++walker)
+        {
+            MetricsStoreRecord aRecord;
+
+            aRecord._channelKey = makeChannelKey(walker->_channelName);
+            aRecord._counters = walker->_counters;
+            storeRecords.push_back(aRecord);
+        }
+        std::stable_sort(storeRecords.begin(), storeRecords.end(), compareRecordTimes);
+        if (appendToTier(0, storeRecords))
+        {
+            // There's no open segment once the current one has filled, which is the point at
+            // which the store can have aged or grown.
+            if (! _rawSegment)
+            {
+                performMaintenance();
+            }
+        }
+        else
+        {
+            reportProblem("Could not add metrics to", _directory.getChildFile(kTierNames[0]));
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // MetricsStore::addRecords
+
+bool
+MetricsStore::appendToTier(const size_t                   tier,
+                           const MetricsStoreRecordList & records)
+{
+    ODL_OBJENTER(); //####
+    ODL_LL1("tier = ", tier); //####
+    ODL_P1("records = ", &records); //####
+    bool                            result = true;
+    File                            tierDirectory(_directory.getChildFile(kTierNames[tier]));
+    MetricsSegmentMap &             ranges = _segmentRanges[tier];
+    MemoryMappedFile *              segment = ((0 == tier) ? _rawSegment.get() : NULL);
+    File                            currentFile((0 == tier) ? _rawSegmentFile : File::nonexistent);
+    ScopedPointer<MemoryMappedFile> otherSegment;
+
+    for (size_t ii = 0, mm = records.size(); result && (mm > ii); )
+    {
+        if (! segment)
+        {
+            File               segmentFile;
+            MemoryMappedFile * newSegment = NULL;
+
+            // Continue with the newest segment of the tier if it still has room.
+            if ((! ranges.empty()) && (kRecordsPerSegment > ranges.rbegin()->second._recordCount))
+            {
+                segmentFile = File(ranges.rbegin()->first);
+                newSegment = mapSegment(segmentFile, MemoryMappedFile::readWrite);
+            }
+            if (! newSegment)
+            {
+                int64 firstTime = records[ii]._counters._time;
+
+                do
+                {
+                    segmentFile = tierDirectory.getChildFile(String(firstTime).paddedLeft('0', 16) +
+                                                             kSegmentSuffix);
+                    ++firstTime;
+                }
+                while (segmentFile.exists());
+                if (tierDirectory.createDirectory().wasOk() && createSegment(segmentFile))
+                {
+                    newSegment = mapSegment(segmentFile, MemoryMappedFile::readWrite);
+                }
+            }
+            result = (NULL != newSegment);
+            if (result)
+            {
+                if (0 == tier)
+                {
+                    _rawSegment = newSegment;
+                    _rawSegmentFile = segmentFile;
+                }
+                else
+                {
+                    otherSegment = newSegment;
+                }
+                segment = newSegment;
+                currentFile = segmentFile;
+            }
+        }
+        if (result)
+        {
+            SegmentHeader *      header = static_cast<SegmentHeader *>(segment->getData());
+            MetricsStoreRecord * slots = reinterpret_cast<MetricsStoreRecord *>(header + 1);
+
+            for ( ; (mm > ii) && (kRecordsPerSegment > header->_recordCount); ++ii)
+            {
+                const MetricsStoreRecord & aRecord = records[ii];
+
+                slots[header->_recordCount] = aRecord;
+                if (0 == header->_recordCount)
+                {
+                    header->_firstTime = aRecord._counters._time;
+                }
+                header->_lastTime = aRecord._counters._time;
+                // The count is updated last, so that a reader never sees a partial record.
+                ++header->_recordCount;
+            }
+            MetricsSegmentRange & range = ranges[currentFile.getFullPathName()];
+
+            range._firstTime = header->_firstTime;
+            range._lastTime = header->_lastTime;
+            range._recordCount = header->_recordCount;
+            if (kRecordsPerSegment <= header->_recordCount)
+            {
+                if (0 == tier)
+                {
+                    _rawSegment = NULL;
+                    _rawSegmentFile = File::nonexistent;
+                }
+                else
+                {
+                    otherSegment = NULL;
+                }
+                segment = NULL;
+            }
+        }
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // MetricsStore::appendToTier
+
+bool
+MetricsStore::getSamples(const PortSet &    channelNames,
+                         const int64        startTime,
+                         const int64        endTime,
+                         MetricsSampleMap & samples)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("channelNames = ", &channelNames, "samples = ", &samples); //####
+    ODL_LL2("startTime = ", startTime, "endTime = ", endTime); //####
+    ChannelKeyMap keys;
+
+    for (PortSet::const_iterator walker(channelNames.begin()); channelNames.end() != walker;
+         ++walker)
+    {
+        keys.insert(ChannelKeyMap::value_type(makeChannelKey(*walker), *walker));
+    }
+    samples.clear();
+    if (isActive() && (! keys.empty()))
+    {
+        const ScopedLock lock(_lock);
+
+        for (size_t tier = 0; kTierCount > tier; ++tier)
+        {
+            const MetricsSegmentMap & ranges = _segmentRanges[tier];
+
+            for (MetricsSegmentMap::const_iterator walker(ranges.begin()); ranges.end() != walker;
+                 ++walker)
+            {
+                const MetricsSegmentRange & range = walker->second;
+
+                // Only the segments that overlap the query are read.
+                if ((0 < range._recordCount) && (range._firstTime <= endTime) &&
+                    (range._lastTime >= startTime))
+                {
+                    ScopedPointer<MemoryMappedFile> segment(mapSegment(File(walker->first),
+                                                                   MemoryMappedFile::readOnly));
+
+                    if (segment)
+                    {
+                        const SegmentHeader *      header =
+                                        static_cast<const SegmentHeader *>(segment->getData());
+                        const MetricsStoreRecord * slots =
+                                        reinterpret_cast<const MetricsStoreRecord *>(header + 1);
+
+                        for (uint32 jj = 0; header->_recordCount > jj; ++jj)
+                        {
+                            const MetricsStoreRecord &    aRecord = slots[jj];
+                            ChannelKeyMap::const_iterator match(keys.find(aRecord._channelKey));
+
+                            if ((keys.end() != match) && (aRecord._counters._time >= startTime) &&
+                                (aRecord._counters._time <= endTime))
+                            {
+                                samples[match->second].push_back(aRecord._counters);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    for (MetricsSampleMap::iterator walker(samples.begin()); samples.end() != walker; ++walker)
+    {
+        std::stable_sort(walker->second.begin(), walker->second.end(), compareSampleTimes);
+    }
+    bool result = (! samples.empty());
+
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // MetricsStore::getSamples
+
+void
+MetricsStore::loadSegmentRanges(void)
+{
+    ODL_OBJENTER(); //####
+    const ScopedLock lock(_lock);
+
+    for (size_t tier = 0; kTierCount > tier; ++tier)
+    {
+        MetricsSegmentMap & ranges = _segmentRanges[tier];
+        StringArray         paths;
+
+        ranges.clear();
+        getSegmentPaths(_directory.getChildFile(kTierNames[tier]), paths);
+        for (int ii = 0, mm = paths.size(); mm > ii; ++ii)
+        {
+            ScopedPointer<MemoryMappedFile> segment(mapSegment(File(paths[ii]),
+                                                               MemoryMappedFile::readOnly));
+
+            if (segment)
+            {
+                const SegmentHeader * header =
+                                        static_cast<const SegmentHeader *>(segment->getData());
+                MetricsSegmentRange & range = ranges[paths[ii]];
+
+                range._firstTime = header->_firstTime;
+                range._lastTime = header->_lastTime;
+                range._recordCount = header->_recordCount;
+            }
+            else
+            {
+                reportProblem("Could not read", File(paths[ii]));
+            }
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // MetricsStore::loadSegmentRanges
+
+void
+MetricsStore::performMaintenance(void)
+{
+    ODL_OBJENTER(); //####
+    const ScopedLock lock(_lock);
+    int64            now = Time::currentTimeMillis();
+
+    for (size_t tier = 0; (kTierCount - 1) > tier; ++tier)
+    {
+        const MetricsSegmentMap & ranges = _segmentRanges[tier];
+        StringArray               agedPaths;
+
+        // The aged segments are gathered first, as reducing a segment removes it from the index.
+        for (MetricsSegmentMap::const_iterator walker(ranges.begin()); ranges.end() != walker;
+             ++walker)
+        {
+            if ((_rawSegmentFile != File(walker->first)) &&
+                ((now - walker->second._lastTime) > kTierAges[tier]))
+            {
+                agedPaths.add(walker->first);
+            }
+        }
+        for (int ii = 0, mm = agedPaths.size(); mm > ii; ++ii)
+        {
+            File segmentFile(agedPaths[ii]);
+
+            if (! reduceSegment(tier, segmentFile))
+            {
+                reportProblem("Could not reduce", segmentFile);
+            }
+        }
+    }
+    removeExcessSegments();
+    ODL_OBJEXIT(); //####
+} // MetricsStore::performMaintenance
+
+bool
+MetricsStore::reduceSegment(const size_t tier,
+                            const File & segmentFile)
+{
+    ODL_OBJENTER(); //####
+    ODL_LL1("tier = ", tier); //####
+    MetricsStoreRecordList          reduced;
+    ScopedPointer<MemoryMappedFile> segment(mapSegment(segmentFile, MemoryMappedFile::readOnly));
+    bool                            result = (NULL != segment);
+
+    if (result)
+    {
+        int64                      interval = kTierIntervals[tier + 1];
+        ReducedRecordMap           latest;
+        const SegmentHeader *      header = static_cast<const SegmentHeader *>(segment->getData());
+        const MetricsStoreRecord * slots = reinterpret_cast<const MetricsStoreRecord *>(header + 1);
+
+        // The counters only grow, so the last sample in each interval stands for the interval.
+        for (uint32 ii = 0; header->_recordCount > ii; ++ii)
+        {
+            const MetricsStoreRecord & aRecord = slots[ii];
+            std::pair<int64, int64>    key(aRecord._channelKey,
+                                           aRecord._counters._time / interval);
+            ReducedRecordMap::iterator match(latest.find(key));
+
+            if (latest.end() == match)
+            {
+                latest.insert(ReducedRecordMap::value_type(key, aRecord));
+            }
+            else if (match->second._counters._time < aRecord._counters._time)
+            {
+                match->second = aRecord;
+            }
+        }
+        for (ReducedRecordMap::const_iterator walker(latest.begin()); latest.end() != walker;
+             ++walker)
+        {
+            reduced.push_back(walker->second);
+        }
+        std::stable_sort(reduced.begin(), reduced.end(), compareRecordTimes);
+    }
+    segment = NULL;
+    if (result)
+    {
+        result = (appendToTier(tier + 1, reduced) && segmentFile.deleteFile());
+    }
+    if (result)
+    {
+        _segmentRanges[tier].erase(segmentFile.getFullPathName());
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // MetricsStore::reduceSegment
+
+void
+MetricsStore::removeExcessSegments(void)
+{
+    ODL_OBJENTER(); //####
+    StringArray         paths;
+    std::vector<size_t> pathTiers;
+    int64               segmentSize = getSegmentSize();
+    int64               totalSize;
+
+    // The segments are gathered with the coarsest tier first, so that the oldest data goes
+    // first.
+    for (size_t tier = kTierCount; 0 < tier; --tier)
+    {
+        const MetricsSegmentMap & ranges = _segmentRanges[tier - 1];
+
+        for (MetricsSegmentMap::const_iterator walker(ranges.begin()); ranges.end() != walker;
+             ++walker)
+        {
+            paths.add(walker->first);
+            pathTiers.push_back(tier - 1);
+        }
+    }
+    // Segments are created at their full size, so the total follows from the count.
+    totalSize = paths.size() * segmentSize;
+    for (int ii = 0, mm = paths.size(); (mm > ii) && (_sizeLimit < totalSize); ++ii)
+    {
+        File segmentFile(paths[ii]);
+
+        if (_rawSegmentFile != segmentFile)
+        {
+            if (segmentFile.deleteFile())
+            {
+                totalSize -= segmentSize;
+                _segmentRanges[pathTiers[ii]].erase(paths[ii]);
+            }
+            else
+            {
+                reportProblem("Could not remove", segmentFile);
+            }
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // MetricsStore::removeExcessSegments
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
@@ -0,0 +1,184 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mMetricsStore.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for the long-term storage of the collected metrics.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-18
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmMetricsStore_HPP_))
+# define mpmMetricsStore_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for the long-term storage of the collected metrics. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    /*! @brief Keeps the collected metrics of the channels on disk, so that they outlive the
+     process.
+     The samples are held in segment files of fixed-size records, which are only ever appended to
+     and which are accessed through memory mapping. Each segment belongs to a tier: new samples go
+     into the 'raw' tier, and segments that have aged are reduced to one sample per channel per
+     minute, and then to one sample per channel per hour. The oldest segments are removed when the
+     files take up more than the configured amount of disk space. The range of times of each
+     segment is kept in memory, so that only the segments that hold a requested range are mapped.
+     Nothing is written if the directory for the segments is not set by the environment. */
+    class MetricsStore
+    {
+    public :
+
+    protected :
+
+    private :
+
+    public :
+
+        /*! @brief The constructor. */
+        MetricsStore(void);
+
+        /*! @brief The destructor. */
+        virtual
+        ~MetricsStore(void);
+
+        /*! @brief Add the newly-collected counters of the channels to the store.
+         @param[in] records The newly-collected counters. */
+        void
+        addRecords(const MetricsRecordList & records);
+
+        /*! @brief Work out the average rates of traffic over a sequence of samples.
+         A counter that goes backwards is taken to have restarted from zero.
+         @param[in] samples The samples to use, with the oldest first.
+         @param[out] rates The rates of traffic.
+         @returns @c true if the rates could be worked out and @c false otherwise. */
+        static bool
+        getAverageRates(const MetricsSampleList & samples,
+                        MetricsRates &            rates);
+
+        /*! @brief Return the stored samples of a set of channels that were collected in a range of
+         time.
+         @param[in] channelNames The names of the channels.
+         @param[in] startTime The start of the range, in milliseconds since the epoch.
+         @param[in] endTime The end of the range, in milliseconds since the epoch.
+         @param[out] samples The samples of each channel that has any, with the oldest first.
+         @returns @c true if any samples were found and @c false otherwise. */
+        bool
+        getSamples(const PortSet &    channelNames,
+                   const int64        startTime,
+                   const int64        endTime,
+                   MetricsSampleMap & samples);
+
+        /*! @brief Return @c true if the samples are being stored.
+         @returns @c true if the samples are being stored and @c false otherwise. */
+        inline bool
+        isActive(void)
+        const
+        {
+            return (File::nonexistent != _directory);
+        } // isActive
+
+        /*! @brief Reduce the segments that have aged into the next tier, and remove the oldest
+         segments if the store has become too large. */
+        void
+        performMaintenance(void);
+
+    protected :
+
+    private :
+
+        /*! @brief Add records to the newest segment of a tier, starting new segments as needed.
+         @param[in] tier The tier to be added to.
+         @param[in] records The records to be added, with the oldest first.
+         @returns @c true if the records were added and @c false otherwise. */
+        bool
+        appendToTier(const size_t                   tier,
+                     const MetricsStoreRecordList & records);
+
+        /*! @brief Read the ranges of times of the segments of every tier. */
+        void
+        loadSegmentRanges(void);
+
+        /*! @brief Reduce a segment to one sample per channel for each interval of the next tier,
+         and then remove it.
+         @param[in] tier The tier of the segment.
+         @param[in] segmentFile The segment to be reduced.
+         @returns @c true if the segment was reduced and @c false otherwise. */
+        bool
+        reduceSegment(const size_t tier,
+                      const File & segmentFile);
+
+        /*! @brief Remove the oldest segments until the store is no larger than its limit. */
+        void
+        removeExcessSegments(void);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The directory that holds the tiers of segments. */
+        File _directory;
+
+        /*! @brief The segment that new samples are added to. */
+        ScopedPointer<MemoryMappedFile> _rawSegment;
+
+        /*! @brief A lock to manage access to the segments. */
+        CriticalSection _lock;
+
+        /*! @brief The file for the segment that new samples are added to. */
+        File _rawSegmentFile;
+
+        /*! @brief The ranges of times of the segments of each tier. */
+        std::vector<MetricsSegmentMap> _segmentRanges;
+
+        /*! @brief The maximum space taken by the segments, in bytes. */
+        int64 _sizeLimit;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MetricsStore)
+
+    }; // MetricsStore
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmMetricsStore_HPP_)
@@ -0,0 +1,933 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mMetricsThread.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for the background collection of service metrics.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-18
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mMetricsThread.hpp"
+#include "m+mContentPanel.hpp"
+#include "m+mMetricsAlerts.hpp"
+#include "m+mMetricsExporter.hpp"
+#include "m+mMetricsStore.hpp"
+
+#include <m+m/m+mSendReceiveCounters.hpp>
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for the background collection of service metrics. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+using namespace std;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The time between collections of the metrics, in milliseconds. */
+static const int kPollInterval = 2000;
+
+/*! @brief The number of collection intervals that the traffic weights are averaged over. */
+static const size_t kSmoothingIntervals = 5;
+
+/*! @brief The number of milliseconds in a day. */
+static const int64 kMillisecondsPerDay = (24 * 60 * 60 * 1000LL);
+
+/*! @brief The number of milliseconds in an hour. */
+static const int64 kMillisecondsPerHour = (60 * 60 * 1000LL);
+
+/*! @brief The time between updates of the average rates from the stored samples, in
+ milliseconds. */
+static const int64 kStoredRatesInterval = (60 * 1000LL);
+
+/*! @brief The time between routine maintenance of the stored samples, in milliseconds. */
+static const int64 kStoreMaintenanceInterval = kMillisecondsPerHour;
+
+/*! @brief The key for the channel name in the metrics for a channel. */
+static const char * kMetricsChannelKey = MpM_SENDRECEIVE_CHANNEL_;
+
+/*! @brief The key for the number of bytes received in the metrics for a channel. */
+static const char * kMetricsInBytesKey = MpM_SENDRECEIVE_INBYTES_;
+
+/*! @brief The key for the number of messages received in the metrics for a channel. */
+static const char * kMetricsInMessagesKey = MpM_SENDRECEIVE_INMESSAGES_;
+
+/*! @brief The key for the number of bytes sent in the metrics for a channel. */
+static const char * kMetricsOutBytesKey = MpM_SENDRECEIVE_OUTBYTES_;
+
+/*! @brief The key for the number of messages sent in the metrics for a channel. */
+static const char * kMetricsOutMessagesKey = MpM_SENDRECEIVE_OUTMESSAGES_;
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Add a sample to a metrics history, replacing the oldest sample if the ring is full.
+ @param[in,out] history The history to be updated.
+ @param[in] sample The sample to be added. */
+static void
+addSample(MetricsHistory &      history,
+          const MetricsSample & sample)
+{
+    ODL_ENTER(); //####
+    ODL_P2("history = ", &history, "sample = ", &sample); //####
+    if (0 < history._count)
+    {
+        size_t                previous = ((history._next + METRICS_HISTORY_SIZE_ - 1) %
+                                          METRICS_HISTORY_SIZE_);
+        const MetricsSample & lastSample = history._samples[previous];
+
+        // If the counters have gone backwards, the service was restarted and the older samples
+        // can't be used to work out rates.
+        if ((lastSample._inBytes > sample._inBytes) || (lastSample._outBytes > sample._outBytes) ||
+            (lastSample._inMessages > sample._inMessages) ||
+            (lastSample._outMessages > sample._outMessages))
+        {
+            history._count = history._next = 0;
+        }
+    }
+    history._samples[history._next] = sample;
+    history._next = ((history._next + 1) % METRICS_HISTORY_SIZE_);
+    if (METRICS_HISTORY_SIZE_ > history._count)
+    {
+        ++history._count;
+    }
+    ODL_EXIT(); //####
+} // addSample
+
+/*! @brief Return a sample from a metrics history.
+ @param[in] history The history to be examined.
+ @param[in] index The position of the sample, with zero being the oldest sample.
+ @returns The requested sample. */
+static const MetricsSample &
+getSample(const MetricsHistory & history,
+          const size_t           index)
+{
+    ODL_ENTER(); //####
+    ODL_P1("history = ", &history); //####
+    ODL_LL1("index = ", index); //####
+    size_t                oldest = ((history._next + METRICS_HISTORY_SIZE_ - history._count) %
+                                    METRICS_HISTORY_SIZE_);
+    const MetricsSample & result = history._samples[(oldest + index) % METRICS_HISTORY_SIZE_];
+
+    ODL_EXIT_P(&result); //####
+    return result;
+} // getSample
+
+/*! @brief Work out the rates of traffic between two samples of a history.
+ @param[in] history The samples to use.
+ @param[in] earlierIndex The position of the earlier sample, with zero being the oldest sample.
+ @param[in] laterIndex The position of the later sample.
+ @param[out] rates The rates of traffic.
+ @returns @c true if the rates could be worked out and @c false otherwise. */
+static bool
+computeRatesBetween(const MetricsHistory & history,
+                    const size_t           earlierIndex,
+                    const size_t           laterIndex,
+                    MetricsRates &         rates)
+{
+    ODL_ENTER(); //####
+    ODL_P2("history = ", &history, "rates = ", &rates); //####
+    ODL_LL2("earlierIndex = ", earlierIndex, "laterIndex = ", laterIndex); //####
+    bool result = ((earlierIndex < laterIndex) && (history._count > laterIndex));
+
+    if (result)
+    {
+        const MetricsSample & earlier = getSample(history, earlierIndex);
+        const MetricsSample & later = getSample(history, laterIndex);
+        double                seconds = ((later._time - earlier._time) / 1000.0);
+
+        result = (0 < seconds);
+        if (result)
+        {
+            rates._inBytesPerSecond = ((later._inBytes - earlier._inBytes) / seconds);
+            rates._inMessagesPerSecond = ((later._inMessages - earlier._inMessages) / seconds);
+            rates._outBytesPerSecond = ((later._outBytes - earlier._outBytes) / seconds);
+            rates._outMessagesPerSecond = ((later._outMessages - earlier._outMessages) /
+                                           seconds);
+        }
+    }
+    ODL_EXIT_B(result); //####
+    return result;
+} // computeRatesBetween
+
+/*! @brief Extract a counter from the metrics for a channel.
+ The services report the counters as strings, as they can exceed the range of the integers in
+ a bottle, but numeric values are accepted as well.
+ @param[in] anEntry The metrics for the channel.
+ @param[in] key The name of the counter.
+ @param[out] value The value of the counter.
+ @returns @c true if the counter was present and @c false otherwise. */
+static bool
+getCounter(const yarp::os::Searchable & anEntry,
+           const char *                 key,
+           int64 &                      value)
+{
+    ODL_ENTER(); //####
+    ODL_P2("anEntry = ", &anEntry, "value = ", &value); //####
+    ODL_S1("key = ", key); //####
+    bool result = anEntry.check(key);
+
+    if (result)
+    {
+        yarp::os::Value & aValue = anEntry.find(key);
+
+        if (aValue.isString())
+        {
+            value = String(aValue.asString().c_str()).getLargeIntValue();
+        }
+        else if (aValue.isInt())
+        {
+            value = aValue.asInt();
+        }
+        else if (aValue.isDouble())
+        {
+            value = static_cast<int64>(aValue.asDouble());
+        }
+        else
+        {
+            result = false;
+        }
+    }
+    ODL_EXIT_B(result); //####
+    return result;
+} // getCounter
+
+/*! @brief Remove the histories whose names were not seen.
+ @param[in,out] histories The histories to be examined.
+ @param[in] seen The names that were seen.
+ @param[out] removed If non-@c NULL, the names of the histories that were removed. */
+static void
+removeUnseenHistories(MetricsHistoryMap & histories,
+                      const PortSet &     seen,
+                      PortSet *           removed)
+{
+    ODL_ENTER(); //####
+    ODL_P3("histories = ", &histories, "seen = ", &seen, "removed = ", removed); //####
+    for (MetricsHistoryMap::iterator walker(histories.begin()); histories.end() != walker; )
+    {
+        if (seen.end() == seen.find(walker->first))
+        {
+            if (removed)
+            {
+                removed->insert(walker->first);
+            }
+            histories.erase(walker++);
+        }
+        else
+        {
+            ++walker;
+        }
+    }
+    ODL_EXIT(); //####
+} // removeUnseenHistories
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+bool
+MetricsThread::computeRates(const MetricsHistory & history,
+                            const size_t           index,
+                            MetricsRates &         rates)
+{
+    ODL_ENTER(); //####
+    ODL_P2("history = ", &history, "rates = ", &rates); //####
+    ODL_LL1("index = ", index); //####
+    bool result = ((0 < index) && (history._count > index) &&
+                   computeRatesBetween(history, index - 1, index, rates));
+
+    ODL_EXIT_B(result); //####
+    return result;
+} // MetricsThread::computeRates
+
+bool
+MetricsThread::getLatestCounters(const MetricsHistory & history,
+                                 MetricsSample &        counters)
+{
+    ODL_ENTER(); //####
+    ODL_P2("history = ", &history, "counters = ", &counters); //####
+    bool result = (0 < history._count);
+
+    if (result)
+    {
+        counters = getSample(history, history._count - 1);
+    }
+    ODL_EXIT_B(result); //####
+    return result;
+} // MetricsThread::getLatestCounters
+
+bool
+MetricsThread::getLatestRates(const MetricsHistory & history,
+                              MetricsRates &         rates)
+{
+    ODL_ENTER(); //####
+    ODL_P2("history = ", &history, "rates = ", &rates); //####
+    bool result = ((1 < history._count) && computeRates(history, history._count - 1, rates));
+
+    ODL_EXIT_B(result); //####
+    return result;
+} // MetricsThread::getLatestRates
+
+bool
+MetricsThread::getMetricsForService(const YarpString &  servicePortName,
+                                    MetricsRecordList & records)
+{
+    ODL_ENTER(); //####
+    ODL_S1s("servicePortName = ", servicePortName); //####
+    ODL_P1("records = ", &records); //####
+    yarp::os::Bottle metrics;
+    bool             result = Utilities::GetMetricsForService(servicePortName, metrics,
+                                                              STANDARD_WAIT_TIME_);
+
+    if (result)
+    {
+        parseMetrics(metrics, Time::currentTimeMillis(), records);
+    }
+    ODL_EXIT_B(result); //####
+    return result;
+} // MetricsThread::getMetricsForService
+
+void
+MetricsThread::getRateHistory(const MetricsHistory & history,
+                              MetricsRateList &      rates)
+{
+    ODL_ENTER(); //####
+    ODL_P2("history = ", &history, "rates = ", &rates); //####
+    rates.clear();
+    for (size_t ii = 1; history._count > ii; ++ii)
+    {
+        MetricsRates aRate;
+
+        if (computeRates(history, ii, aRate))
+        {
+            rates.push_back(aRate._inBytesPerSecond + aRate._outBytesPerSecond);
+        }
+    }
+    ODL_EXIT(); //####
+} // MetricsThread::getRateHistory
+
+bool
+MetricsThread::getSmoothedRates(const MetricsHistory & history,
+                                const size_t           intervals,
+                                MetricsRates &         rates)
+{
+    ODL_ENTER(); //####
+    ODL_P2("history = ", &history, "rates = ", &rates); //####
+    ODL_LL1("intervals = ", intervals); //####
+    bool result = (1 < history._count);
+
+    if (result)
+    {
+        size_t laterIndex = history._count - 1;
+        size_t earlierIndex = ((laterIndex > intervals) ? (laterIndex - intervals) : 0);
+
+        result = computeRatesBetween(history, earlierIndex, laterIndex, rates);
+    }
+    ODL_EXIT_B(result); //####
+    return result;
+} // MetricsThread::getSmoothedRates
+
+void
+MetricsThread::parseMetrics(const yarp::os::Bottle & metrics,
+                            const int64              collectionTime,
+                            MetricsRecordList &      records)
+{
+    ODL_ENTER(); //####
+    ODL_P2("metrics = ", &metrics, "records = ", &records); //####
+    ODL_LL1("collectionTime = ", collectionTime); //####
+    records.clear();
+    for (int ii = 0, mm = metrics.size(); mm > ii; ++ii)
+    {
+        yarp::os::Value &      anEntry(metrics.get(ii));
+        yarp::os::Searchable * asSearchable;
+
+        if (anEntry.isDict())
+        {
+            asSearchable = anEntry.asDict();
+        }
+        else if (anEntry.isList())
+        {
+            asSearchable = anEntry.asList();
+        }
+        else
+        {
+            asSearchable = NULL;
+        }
+        if (asSearchable && asSearchable->check(kMetricsChannelKey))
+        {
+            MetricsRecord aRecord;
+
+            // The date and time that the service reports are ignored, as the records are all
+            // stamped with the time at which they were collected.
+            aRecord._channelName = asSearchable->find(kMetricsChannelKey).asString();
+            aRecord._counters._time = collectionTime;
+            if (getCounter(*asSearchable, kMetricsInBytesKey, aRecord._counters._inBytes) &&
+                getCounter(*asSearchable, kMetricsInMessagesKey,
+                           aRecord._counters._inMessages) &&
+                getCounter(*asSearchable, kMetricsOutBytesKey, aRecord._counters._outBytes) &&
+                getCounter(*asSearchable, kMetricsOutMessagesKey,
+                           aRecord._counters._outMessages))
+            {
+                records.push_back(aRecord);
+            }
+        }
+    }
+    ODL_EXIT(); //####
+} // MetricsThread::parseMetrics
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+MetricsThread::MetricsThread(ContentPanel & owner) :
+    inherited("metrics collector"), _channelHistories(), _serviceHistories(), _metricsStates(),
+    _pendingRequests(), _storedRates(), _owner(owner),
+    _alerts(new MetricsAlerts), _exporter(new MetricsExporter), _store(new MetricsStore)
+{
+    ODL_ENTER(); //####
+    ODL_P1("owner = ", &owner); //####
+    ODL_EXIT_P(this); //####
+} // MetricsThread::MetricsThread
+
+MetricsThread::~MetricsThread(void)
+{
+    ODL_OBJENTER(); //####
+    stopThread(3000); // Give thread 3 seconds to shut down.
+    _alerts = NULL;
+    _exporter = NULL;
+    _store = NULL;
+    ODL_OBJEXIT(); //####
+} // MetricsThread::~MetricsThread
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+MetricsThread::applyRequests(void)
+{
+    ODL_OBJENTER(); //####
+    ActivityStateMap requests;
+
+    {
+        const ScopedLock lock(_lock);
+
+        requests.swap(_pendingRequests);
+    }
+    for (ActivityStateMap::const_iterator walker(requests.begin());
+         (requests.end() != walker) && (! threadShouldExit()); ++walker)
+    {
+        if (! Utilities::SetMetricsStateForService(walker->first, walker->second,
+                                                   STANDARD_WAIT_TIME_))
+        {
+            char buffer1[DATE_TIME_BUFFER_SIZE_];
+            char buffer2[DATE_TIME_BUFFER_SIZE_];
+
+            Utilities::GetDateAndTime(buffer1, sizeof(buffer1), buffer2, sizeof(buffer2));
+            std::cerr << buffer1 << " " << buffer2 << " Unable to change the metrics state of " <<
+                        walker->first << std::endl;
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // MetricsThread::applyRequests
+
+bool
+MetricsThread::collectFromPanel(PortSet &        servicePorts,
+                                ServiceKindMap & serviceKinds,
+                                PortSet &        ruledServices,
+                                ScannerHealth &  health)
+{
+    ODL_OBJENTER(); //####
+    ODL_P4("servicePorts = ", &servicePorts, "serviceKinds = ", &serviceKinds, //####
+           "ruledServices = ", &ruledServices, "health = ", &health); //####
+    // Because this is a background thread, we mustn't do any UI work without first grabbing a
+    // MessageManagerLock.
+    const MessageManagerLock mml(Thread::getCurrentThread());
+    bool                     result = mml.lockWasGained();
+
+    // If something is trying to kill this job, the lock will fail, in which case we'd better
+    // return.
+    if (result)
+    {
+        ServiceChannelMap serviceChannels;
+
+        _owner.getServicePorts(servicePorts, serviceKinds, serviceChannels);
+        _owner.getScannerHealth(health);
+        if (_alerts->isActive())
+        {
+            for (ServiceChannelMap::const_iterator walker(serviceChannels.begin());
+                 serviceChannels.end() != walker; ++walker)
+            {
+                if (_alerts->appliesToService(serviceKinds[walker->first], walker->second))
+                {
+                    ruledServices.insert(walker->first);
+                }
+            }
+        }
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // MetricsThread::collectFromPanel
+
+void
+MetricsThread::computeTrafficWeights(TrafficWeightMap & weights)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("weights = ", &weights); //####
+    const ScopedLock lock(_lock);
+    double           maxBytes = 0;
+    double           maxMessages = 0;
+
+    weights.clear();
+    for (MetricsHistoryMap::const_iterator walker(_channelHistories.begin());
+         _channelHistories.end() != walker; ++walker)
+    {
+        MetricsRates rates;
+
+        if (getSmoothedRates(walker->second, kSmoothingIntervals, rates))
+        {
+            TrafficWeight & aWeight = weights[walker->first];
+
+            // The rates are held temporarily, until the busiest channel is known.
+            aWeight._bytes = static_cast<float>(jmax(rates._inBytesPerSecond,
+                                                     rates._outBytesPerSecond));
+            aWeight._messages = static_cast<float>(jmax(rates._inMessagesPerSecond,
+                                                        rates._outMessagesPerSecond));
+            maxBytes = jmax(maxBytes, static_cast<double>(aWeight._bytes));
+            maxMessages = jmax(maxMessages, static_cast<double>(aWeight._messages));
+        }
+    }
+    // A logarithmic scale keeps the quieter channels distinguishable from idle ones when a few
+    // channels are very busy.
+    for (TrafficWeightMap::iterator walker(weights.begin()); weights.end() != walker; ++walker)
+    {
+        TrafficWeight & aWeight = walker->second;
+
+        aWeight._bytes = ((0 < maxBytes) ? static_cast<float>(log1p(aWeight._bytes) /
+                                                              log1p(maxBytes)) : 0);
+        aWeight._messages = ((0 < maxMessages) ? static_cast<float>(log1p(aWeight._messages) /
+                                                                    log1p(maxMessages)) : 0);
+    }
+    ODL_OBJEXIT(); //####
+} // MetricsThread::computeTrafficWeights
+
+void
+MetricsThread::exportMetrics(const ScannerHealth & health)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("health = ", &health); //####
+    MetricsHistoryMap channelHistories;
+    MetricsHistoryMap serviceHistories;
+
+    // The histories are copied, so that the files are written without holding the lock.
+    {
+        const ScopedLock lock(_lock);
+
+        channelHistories = _channelHistories;
+        serviceHistories = _serviceHistories;
+    }
+    _exporter->exportMetrics(channelHistories, serviceHistories, health);
+    ODL_OBJEXIT(); //####
+} // MetricsThread::exportMetrics
+
+bool
+MetricsThread::getChannelHistory(const YarpString & channelName,
+                                 MetricsHistory &   history)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("channelName = ", channelName); //####
+    ODL_P1("history = ", &history); //####
+    const ScopedLock                  lock(_lock);
+    MetricsHistoryMap::const_iterator match(_channelHistories.find(channelName));
+    bool                              result = (_channelHistories.end() != match);
+
+    if (result)
+    {
+        history = match->second;
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // MetricsThread::getChannelHistory
+
+bool
+MetricsThread::getMetricsState(const YarpString & servicePortName,
+                               bool &             state)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("servicePortName = ", servicePortName); //####
+    ODL_P1("state = ", &state); //####
+    const ScopedLock                 lock(_lock);
+    ActivityStateMap::const_iterator match(_metricsStates.find(servicePortName));
+    bool                             result = (_metricsStates.end() != match);
+
+    if (result)
+    {
+        state = match->second;
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // MetricsThread::getMetricsState
+
+bool
+MetricsThread::getServiceHistory(const YarpString & servicePortName,
+                                 MetricsHistory &   history)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("servicePortName = ", servicePortName); //####
+    ODL_P1("history = ", &history); //####
+    const ScopedLock                  lock(_lock);
+    MetricsHistoryMap::const_iterator match(_serviceHistories.find(servicePortName));
+    bool                              result = (_serviceHistories.end() != match);
+
+    if (result)
+    {
+        history = match->second;
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // MetricsThread::getServiceHistory
+
+bool
+MetricsThread::getStoredRates(const YarpString & channelName,
+                              StoredRates &      rates)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("channelName = ", channelName); //####
+    ODL_P1("rates = ", &rates); //####
+    const ScopedLock               lock(_lock);
+    StoredRatesMap::const_iterator match(_storedRates.find(channelName));
+    bool                           result = (_storedRates.end() != match);
+
+    if (result)
+    {
+        rates = match->second;
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // MetricsThread::getStoredRates
+
+bool
+MetricsThread::pollServices(const PortSet &        servicePorts,
+                            const ServiceKindMap & serviceKinds,
+                            const PortSet &        ruledServices,
+                            PortSet &              changedServices)
+{
+    ODL_OBJENTER(); //####
+    ODL_P4("servicePorts = ", &servicePorts, "serviceKinds = ", &serviceKinds, //####
+           "ruledServices = ", &ruledServices, "changedServices = ", &changedServices); //####
+    bool              result = false;
+    ActivityStateMap  states;
+    MetricsRecordList collected;
+    PortSet           disabledServices;
+    PortSet           seenChannels;
+    PortSet           seenServices;
+    PortSet           silentServices;
+
+    for (PortSet::const_iterator walker(servicePorts.begin());
+         (servicePorts.end() != walker) && (! threadShouldExit()); ++walker)
+    {
+        const YarpString & servicePortName = *walker;
+        bool               enabled = false;
+        MetricsRecordList  records;
+
+        if (Utilities::GetMetricsStateForService(servicePortName, enabled, STANDARD_WAIT_TIME_))
+        {
+            // The state of a service is shared with other clients, so it's left alone; a service
+            // that an alert rule applies to but that isn't collecting metrics is flagged instead.
+            if ((! enabled) && (ruledServices.end() != ruledServices.find(servicePortName)))
+            {
+                disabledServices.insert(servicePortName);
+            }
+            states[servicePortName] = enabled;
+        }
+        else
+        {
+            // A service that doesn't respond keeps its last known state, so that the menus
+            // don't change while it's busy.
+            bool knownState;
+
+            if (getMetricsState(servicePortName, knownState))
+            {
+                states[servicePortName] = knownState;
+            }
+            silentServices.insert(servicePortName);
+        }
+        bool gotMetrics = (enabled && getMetricsForService(servicePortName, records));
+
+        if (enabled && (! gotMetrics))
+        {
+            silentServices.insert(servicePortName);
+        }
+        if (gotMetrics)
+        {
+            const ScopedLock               lock(_lock);
+            MetricsSample                  total;
+            ServiceKindMap::const_iterator kindMatch(serviceKinds.find(servicePortName));
+            YarpString                     serviceKind;
+
+            if (serviceKinds.end() != kindMatch)
+            {
+                serviceKind = kindMatch->second;
+            }
+            total._inBytes = total._inMessages = total._outBytes = total._outMessages = 0;
+            for (MetricsRecordList::const_iterator walker2(records.begin());
+                 records.end() != walker2; ++walker2)
+            {
+                const MetricsSample & counters = walker2->_counters;
+                MetricsHistory &      history = _channelHistories[walker2->_channelName];
+
+                addSample(history, counters);
+                if (_alerts->isActive() &&
+                    _alerts->evaluateSample(walker2->_channelName, servicePortName, serviceKind,
+                                            history))
+                {
+                    result = true;
+                }
+                total._inBytes += counters._inBytes;
+                total._inMessages += counters._inMessages;
+                total._outBytes += counters._outBytes;
+                total._outMessages += counters._outMessages;
+                total._time = counters._time;
+                seenChannels.insert(walker2->_channelName);
+            }
+            collected.insert(collected.end(), records.begin(), records.end());
+            if (! records.empty())
+            {
+                addSample(_serviceHistories[servicePortName], total);
+                seenServices.insert(servicePortName);
+                changedServices.insert(servicePortName);
+            }
+        }
+    }
+    // Services that have gone away, have had metrics collection turned off or didn't respond
+    // lose their histories, so that stale rates aren't shown.
+    {
+        const ScopedLock lock(_lock);
+
+        removeUnseenHistories(_channelHistories, seenChannels, NULL);
+        if (_alerts->removeUnseenChannels(seenChannels, silentServices))
+        {
+            result = true;
+        }
+        if (_alerts->setDisabledServices(disabledServices))
+        {
+            result = true;
+        }
+        removeUnseenHistories(_serviceHistories, seenServices, &changedServices);
+        // A request that arrived during the collection wins over what the service reported.
+        for (ActivityStateMap::const_iterator walker(_pendingRequests.begin());
+             _pendingRequests.end() != walker; ++walker)
+        {
+            states[walker->first] = walker->second;
+        }
+        _metricsStates.swap(states);
+    }
+    // The store is written outside the lock, so that the display isn't held up by the disk.
+    _store->addRecords(collected);
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // MetricsThread::pollServices
+
+void
+MetricsThread::refreshStoredRates(void)
+{
+    ODL_OBJENTER(); //####
+    int64            now = Time::currentTimeMillis();
+    MetricsSampleMap samples;
+    PortSet          channelNames;
+    StoredRatesMap   storedRates;
+
+    {
+        const ScopedLock lock(_lock);
+
+        for (MetricsHistoryMap::const_iterator walker(_channelHistories.begin());
+             _channelHistories.end() != walker; ++walker)
+        {
+            channelNames.insert(walker->first);
+        }
+    }
+    // The store has its own lock, so the segments are read without holding ours. The samples of
+    // the last hour are the tail of those of the last day, so a single query covers both.
+    _store->getSamples(channelNames, now - kMillisecondsPerDay, now, samples);
+    for (MetricsSampleMap::const_iterator walker(samples.begin()); samples.end() != walker;
+         ++walker)
+    {
+        const MetricsSampleList & daySamples = walker->second;
+        MetricsSampleList         hourSamples;
+        StoredRates               rates;
+
+        for (MetricsSampleList::const_iterator walker2(daySamples.begin());
+             daySamples.end() != walker2; ++walker2)
+        {
+            if ((now - kMillisecondsPerHour) <= walker2->_time)
+            {
+                hourSamples.push_back(*walker2);
+            }
+        }
+        rates._hasDay = MetricsStore::getAverageRates(daySamples, rates._day);
+        rates._hasHour = MetricsStore::getAverageRates(hourSamples, rates._hour);
+        if (rates._hasDay || rates._hasHour)
+        {
+            storedRates[walker->first] = rates;
+        }
+    }
+    {
+        const ScopedLock lock(_lock);
+
+        _storedRates.swap(storedRates);
+    }
+    ODL_OBJEXIT(); //####
+} // MetricsThread::refreshStoredRates
+
+void
+MetricsThread::requestMetricsState(const YarpString & servicePortName,
+                                   const bool         newState)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("servicePortName = ", servicePortName); //####
+    ODL_B1("newState = ", newState); //####
+    {
+        const ScopedLock lock(_lock);
+
+        _metricsStates[servicePortName] = newState;
+        _pendingRequests[servicePortName] = newState;
+    }
+    notify();
+    ODL_OBJEXIT(); //####
+} // MetricsThread::requestMetricsState
+
+void
+MetricsThread::run(void)
+{
+    ODL_OBJENTER(); //####
+    int64 lastMaintenanceTime = Time::currentTimeMillis();
+    int64 lastRatesTime = 0;
+
+    for ( ; ! threadShouldExit(); )
+    {
+        PortSet        ruledServices;
+        PortSet        servicePorts;
+        ServiceKindMap serviceKinds;
+        ScannerHealth  health;
+
+        applyRequests();
+        if (collectFromPanel(servicePorts, serviceKinds, ruledServices, health) &&
+            (! threadShouldExit()))
+        {
+            PortSet changedServices;
+            bool    alertsChanged = pollServices(servicePorts, serviceKinds, ruledServices,
+                                                 changedServices);
+
+            if (_exporter->isActive() && (! threadShouldExit()))
+            {
+                exportMetrics(health);
+            }
+            if (_store->isActive() && (! threadShouldExit()))
+            {
+                int64 now = Time::currentTimeMillis();
+
+                // Segments age even when little is collected, so they aren't left to wait for the
+                // current raw segment to fill.
+                if (kStoreMaintenanceInterval <= (now - lastMaintenanceTime))
+                {
+                    _store->performMaintenance();
+                    lastMaintenanceTime = now;
+                }
+                if (kStoredRatesInterval <= (now - lastRatesTime))
+                {
+                    refreshStoredRates();
+                    lastRatesTime = now;
+                }
+            }
+            if (((! changedServices.empty()) || alertsChanged) && (! threadShouldExit()))
+            {
+                MetricsAlertList alerts;
+                TrafficWeightMap weights;
+
+                computeTrafficWeights(weights);
+                _alerts->getAlerts(alerts);
+                triggerDisplayUpdate(changedServices, weights, alerts);
+            }
+        }
+        wait(kPollInterval);
+    }
+    ODL_OBJEXIT(); //####
+} // MetricsThread::run
+
+void
+MetricsThread::triggerDisplayUpdate(const PortSet &          changedServices,
+                                    const TrafficWeightMap & weights,
+                                    const MetricsAlertList & alerts)
+{
+    ODL_OBJENTER(); //####
+    ODL_P3("changedServices = ", &changedServices, "weights = ", &weights, "alerts = ", //####
+           &alerts); //####
+    // Because this is a background thread, we mustn't do any UI work without first grabbing a
+    // MessageManagerLock.
+    const MessageManagerLock mml(Thread::getCurrentThread());
+
+    // If something is trying to kill this job, the lock will fail, in which case we'd better
+    // return.
+    if (mml.lockWasGained())
+    {
+        _owner.updateMetricsDisplay(changedServices, weights);
+        _owner.updateAlerts(alerts);
+    }
+    ODL_OBJEXIT(); //####
+} // MetricsThread::triggerDisplayUpdate
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
@@ -0,0 +1,305 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mMetricsThread.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for the background collection of service metrics.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-18
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmMetricsThread_HPP_))
+# define mpmMetricsThread_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for the background collection of service metrics. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    class ContentPanel;
+    class MetricsAlerts;
+    class MetricsExporter;
+    class MetricsStore;
+
+    /*! @brief A background thread that periodically collects the metrics of the services that
+     have metrics collection enabled.
+     The counters for each channel, and the totals for each service, are kept in rings of fixed
+     size, from which the rates of traffic can be worked out without asking the services again.
+     The state of metrics collection of each service is also kept, so that it can be shown without
+     waiting for the service to respond, and changes to the state are made in the background. */
+    class MetricsThread : public Thread
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The class that this class is derived from. */
+        typedef Thread inherited;
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in] owner The panel that displays the entities. */
+        explicit
+        MetricsThread(ContentPanel & owner);
+
+        /*! @brief The destructor. */
+        virtual
+        ~MetricsThread(void);
+
+        /*! @brief Work out the rates of traffic between two successive samples of a history.
+         @param[in] history The samples to use.
+         @param[in] index The position of the later sample, with zero being the oldest sample.
+         @param[out] rates The rates of traffic.
+         @returns @c true if the rates could be worked out and @c false otherwise. */
+        static bool
+        computeRates(const MetricsHistory & history,
+                     const size_t           index,
+                     MetricsRates &         rates);
+
+        /*! @brief Return the metrics history of a channel.
+         @param[in] channelName The name of the channel.
+         @param[out] history The metrics history of the channel.
+         @returns @c true if the channel has a metrics history and @c false otherwise. */
+        bool
+        getChannelHistory(const YarpString & channelName,
+                          MetricsHistory &   history);
+
+        /*! @brief Return the most recently seen state of metrics collection of a service.
+         @param[in] servicePortName The name of the primary port of the service.
+         @param[out] state @c true if the service is collecting metrics and @c false otherwise.
+         @returns @c true if the state of the service is known and @c false otherwise. */
+        bool
+        getMetricsState(const YarpString & servicePortName,
+                        bool &             state);
+
+        /*! @brief Ask a service for the metrics of its channels.
+         @param[in] servicePortName The name of the primary port of the service.
+         @param[out] records The metrics of the channels of the service.
+         @returns @c true if the service provided its metrics and @c false otherwise. */
+        static bool
+        getMetricsForService(const YarpString &  servicePortName,
+                             MetricsRecordList & records);
+
+        /*! @brief Return the most recent counters of a history.
+         @param[in] history The samples to use.
+         @param[out] counters The most recent counters.
+         @returns @c true if the history has any samples and @c false otherwise. */
+        static bool
+        getLatestCounters(const MetricsHistory & history,
+                          MetricsSample &        counters);
+
+        /*! @brief Work out the most recent rates of traffic of a history.
+         @param[in] history The samples to use.
+         @param[out] rates The rates of traffic.
+         @returns @c true if the rates could be worked out and @c false otherwise. */
+        static bool
+        getLatestRates(const MetricsHistory & history,
+                       MetricsRates &         rates);
+
+        /*! @brief Work out the combined rate of traffic, in bytes per second, for each pair of
+         successive samples of a history.
+         @param[in] history The samples to use.
+         @param[out] rates The combined rates of traffic, with the oldest first. */
+        static void
+        getRateHistory(const MetricsHistory & history,
+                       MetricsRateList &      rates);
+
+        /*! @brief Work out the average rates of traffic over the most recent samples of a history.
+         @param[in] history The samples to use.
+         @param[in] intervals The number of intervals between samples to average over. Fewer are
+         used if the history is shorter.
+         @param[out] rates The rates of traffic.
+         @returns @c true if the rates could be worked out and @c false otherwise. */
+        static bool
+        getSmoothedRates(const MetricsHistory & history,
+                         const size_t           intervals,
+                         MetricsRates &         rates);
+
+        /*! @brief Return the metrics history for all the channels of a service.
+         @param[in] servicePortName The name of the primary port of the service.
+         @param[out] history The metrics history of the service.
+         @returns @c true if the service has a metrics history and @c false otherwise. */
+        bool
+        getServiceHistory(const YarpString & servicePortName,
+                          MetricsHistory &   history);
+
+        /*! @brief Return the average rates of traffic of a channel over the last hour and the last
+         day, as most recently worked out from the stored samples.
+         @param[in] channelName The name of the channel.
+         @param[out] rates The average rates of traffic of the channel.
+         @returns @c true if the channel has stored rates and @c false otherwise. */
+        bool
+        getStoredRates(const YarpString & channelName,
+                       StoredRates &      rates);
+
+        /*! @brief Extract the metrics of the channels of a service from the response to a metrics
+         request. Entries that don't have the expected form are skipped.
+         @param[in] metrics The response to the metrics request.
+         @param[in] collectionTime The time at which the metrics were collected, in milliseconds
+         since the epoch.
+         @param[out] records The metrics of the channels of the service. */
+        static void
+        parseMetrics(const yarp::os::Bottle & metrics,
+                     const int64              collectionTime,
+                     MetricsRecordList &      records);
+
+        /*! @brief Request that metrics collection be turned on or off for a service.
+         The cached state is changed immediately, and the service is told in the background.
+         @param[in] servicePortName The name of the primary port of the service.
+         @param[in] newState @c true if the service is to collect metrics and @c false
+         otherwise. */
+        void
+        requestMetricsState(const YarpString & servicePortName,
+                            const bool         newState);
+
+    protected :
+
+    private :
+
+        /*! @brief Tell the services about the changes to their state of metrics collection that
+         have been requested. */
+        void
+        applyRequests(void);
+
+        /*! @brief Ask the displayed panel for the services that might have metrics, and for the
+         figures for the scanner.
+         @param[out] servicePorts The primary ports of the services.
+         @param[out] serviceKinds The kinds of the services.
+         @param[out] ruledServices The primary ports of the services that an alert rule applies
+         to.
+         @param[out] health The figures for the scanner.
+         @returns @c true if the panel could be asked and @c false otherwise. */
+        bool
+        collectFromPanel(PortSet &        servicePorts,
+                         ServiceKindMap & serviceKinds,
+                         PortSet &        ruledServices,
+                         ScannerHealth &  health);
+
+        /*! @brief Work out the recent traffic on each channel, relative to the busiest channel.
+         @param[out] weights The recent traffic on the channels. */
+        void
+        computeTrafficWeights(TrafficWeightMap & weights);
+
+        /*! @brief Write the collected metrics to the export files.
+         @param[in] health The figures for the scanner. */
+        void
+        exportMetrics(const ScannerHealth & health);
+
+        /*! @brief Collect the metrics of the services that have metrics collection enabled, and
+         apply the alert rules to them. The services that an alert rule applies to but that have
+         metrics collection disabled are flagged with the alerts.
+         @param[in] servicePorts The primary ports of the services.
+         @param[in] serviceKinds The kinds of the services.
+         @param[in] ruledServices The primary ports of the services that an alert rule applies to.
+         @param[out] changedServices The services whose metrics histories have changed.
+         @returns @c true if an alert was raised or cleared and @c false otherwise. */
+        bool
+        pollServices(const PortSet &        servicePorts,
+                     const ServiceKindMap & serviceKinds,
+                     const PortSet &        ruledServices,
+                     PortSet &              changedServices);
+
+        /*! @brief Work out the average rates of traffic of the channels over the last hour and the
+         last day from the stored samples. */
+        void
+        refreshStoredRates(void);
+
+        /*! @brief Perform the background collection. */
+        virtual void
+        run(void);
+
+        /*! @brief Tell the displayed panel to update the display of the metrics.
+         @param[in] changedServices The services whose metrics histories have changed.
+         @param[in] weights The recent traffic on the channels.
+         @param[in] alerts The alerts that have been raised. */
+        void
+        triggerDisplayUpdate(const PortSet &          changedServices,
+                             const TrafficWeightMap & weights,
+                             const MetricsAlertList & alerts);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The metrics histories of the channels. */
+        MetricsHistoryMap _channelHistories;
+
+        /*! @brief The metrics histories of the services, as the totals of their channels. */
+        MetricsHistoryMap _serviceHistories;
+
+        /*! @brief The most recently seen state of metrics collection of the services. */
+        ActivityStateMap _metricsStates;
+
+        /*! @brief The changes to the state of metrics collection that have not yet been applied.
+         */
+        ActivityStateMap _pendingRequests;
+
+        /*! @brief The average rates of traffic of the channels, from the stored samples. */
+        StoredRatesMap _storedRates;
+
+        /*! @brief A lock to manage access to shared resources. */
+        CriticalSection _lock;
+
+        /*! @brief The panel that displays the entities. */
+        ContentPanel & _owner;
+
+        /*! @brief The evaluation of the alert rules. */
+        ScopedPointer<MetricsAlerts> _alerts;
+
+        /*! @brief The writer for the export files. */
+        ScopedPointer<MetricsExporter> _exporter;
+
+        /*! @brief The long-term storage of the counters of the channels. */
+        ScopedPointer<MetricsStore> _store;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MetricsThread)
+
+    }; // MetricsThread
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmMetricsThread_HPP_)
@@ -0,0 +1,175 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mMonitorInputHandler.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for the input handler used by scrolling monitors.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-18
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mMonitorInputHandler.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for the input handler used by scrolling monitors. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The largest number of characters of a message that are kept. */
+static const size_t kMaximumTextLength = 200;
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+MonitorInputHandler::MonitorInputHandler(const int capacity) :
+    inherited(), _records(static_cast<size_t>(capacity)), _fifo(capacity), _dropped(0)
+{
+    ODL_ENTER(); //####
+    ODL_LL1("capacity = ", capacity); //####
+    ODL_EXIT_P(this); //####
+} // MonitorInputHandler::MonitorInputHandler
+
+MonitorInputHandler::~MonitorInputHandler(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // MonitorInputHandler::~MonitorInputHandler
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+#if (! MAC_OR_LINUX_)
+# pragma warning(push)
+# pragma warning(disable: 4100)
+#endif // ! MAC_OR_LINUX_
+bool
+MonitorInputHandler::handleInput(const yarp::os::Bottle &     input,
+                                 const YarpString &           senderChannel,
+                                 yarp::os::ConnectionWriter * replyMechanism,
+                                 const size_t                 numBytes)
+{
+#if (! defined(ODL_ENABLE_LOGGING_))
+# if MAC_OR_LINUX_
+#  pragma unused(senderChannel,replyMechanism)
+# endif // MAC_OR_LINUX_
+#endif // ! defined(ODL_ENABLE_LOGGING_)
+    ODL_OBJENTER(); //####
+    ODL_S2s("senderChannel = ", senderChannel, "got ", input.toString()); //####
+    ODL_P1("replyMechanism = ", replyMechanism); //####
+    ODL_LL1("numBytes = ", numBytes); //####
+    bool result = true;
+    int  start1;
+    int  size1;
+    int  start2;
+    int  size2;
+
+    _fifo.prepareToWrite(1, start1, size1, start2, size2);
+    if (0 < size1)
+    {
+        MonitorRecord & aRecord = _records[static_cast<size_t>(start1)];
+        YarpString      asText(input.toString());
+
+        if (kMaximumTextLength < asText.length())
+        {
+            asText = asText.substr(0, kMaximumTextLength) + "...";
+        }
+        aRecord._text = asText.c_str();
+        aRecord._receivedTime = Time::currentTimeMillis();
+        aRecord._size = numBytes;
+        _fifo.finishedWrite(1);
+    }
+    else
+    {
+        ++_dropped;
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // MonitorInputHandler::handleInput
+#if (! MAC_OR_LINUX_)
+# pragma warning(pop)
+#endif // ! MAC_OR_LINUX_
+
+void
+MonitorInputHandler::readRecords(MonitorRecordList & records)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("records = ", &records); //####
+    int start1;
+    int size1;
+    int start2;
+    int size2;
+
+    records.clear();
+    _fifo.prepareToRead(_fifo.getNumReady(), start1, size1, start2, size2);
+    records.insert(records.end(), _records.begin() + start1, _records.begin() + start1 + size1);
+    records.insert(records.end(), _records.begin() + start2, _records.begin() + start2 + size2);
+    _fifo.finishedRead(size1 + size2);
+    ODL_OBJEXIT(); //####
+} // MonitorInputHandler::readRecords
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
@@ -0,0 +1,148 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mMonitorInputHandler.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for the input handler used by scrolling monitors.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-18
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmMonitorInputHandler_HPP_))
+# define mpmMonitorInputHandler_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# include <m+m/m+mBaseInputHandler.hpp>
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for the input handler used by scrolling monitors. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    /*! @brief A handler that passes the messages received from a port to a scrolling monitor.
+
+     The messages are kept in a fixed-size ring buffer that is written by the thread that receives
+     the messages and read by the message thread, without locking. When the buffer is full, new
+     messages are counted and discarded rather than waited for, so a busy port can neither use up
+     memory nor hold up the display. */
+    class MonitorInputHandler : public MplusM::Common::BaseInputHandler
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The class that this class is derived from. */
+        typedef BaseInputHandler inherited;
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in] capacity The number of messages that can be held at once. */
+        explicit
+        MonitorInputHandler(const int capacity);
+
+        /*! @brief The destructor. */
+        virtual
+        ~MonitorInputHandler(void);
+
+        /*! @brief Return the number of messages that were discarded because the buffer was full.
+         @returns The number of messages that were discarded. */
+        inline int64
+        getDroppedCount(void)
+        const
+        {
+            return _dropped.get();
+        } // getDroppedCount
+
+        /*! @brief Remove the waiting messages from the buffer. This must only be called from a
+         single thread.
+         @param[out] records The messages that were waiting. */
+        void
+        readRecords(MonitorRecordList & records);
+
+    protected :
+
+    private :
+
+        /*! @brief The copy constructor.
+         @param[in] other The object to be copied. */
+        MonitorInputHandler(const MonitorInputHandler & other);
+
+        /*! @brief Process partially-structured input data.
+         @param[in] input The partially-structured input data.
+         @param[in] senderChannel The name of the channel used to send the input data.
+         @param[in] replyMechanism @c NULL if no reply is expected and non-@c NULL otherwise.
+         @param[in] numBytes The number of bytes available on the connection.
+         @returns @c true if the input was correctly structured and successfully processed. */
+        virtual bool
+        handleInput(const yarp::os::Bottle &     input,
+                    const YarpString &           senderChannel,
+                    yarp::os::ConnectionWriter * replyMechanism,
+                    const size_t                 numBytes);
+
+        /*! @brief The assignment operator.
+         @param[in] other The object to be copied.
+         @returns The updated object. */
+        MonitorInputHandler &
+        operator =(const MonitorInputHandler & other);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The storage for the ring buffer. */
+        MonitorRecordList _records;
+
+        /*! @brief The positions of the waiting messages in the ring buffer. */
+        AbstractFifo _fifo;
+
+        /*! @brief The number of messages that were discarded because the buffer was full. */
+        Atomic<int64> _dropped;
+
+    }; // MonitorInputHandler
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmMonitorInputHandler_HPP_)
@@ -164,7 +164,7 @@ ScannerThread::ScannerThread(ManagerWindow & window,
 #if (defined(CHECK_FOR_STALE_PORTS_) && (! defined(DO_SINGLE_CHECK_FOR_STALE_PORTS_)))
     _lastStaleTime(- (2 * kMinStaleInterval)),
 #endif // efined(CHECK_FOR_STALE_PORTS_) && (! defined(DO_SINGLE_CHECK_FOR_STALE_PORTS_))
-    _inputOnlyPort(NULL), _outputOnlyPort(NULL), _cleanupSoon(false),
+    _scanStartTime(0), _inputOnlyPort(NULL), _outputOnlyPort(NULL), _cleanupSoon(false),
     _delayScan(delayFirstScan),
 #if (defined(CHECK_FOR_STALE_PORTS_) && defined(DO_SINGLE_CHECK_FOR_STALE_PORTS_))
     _initialStaleCheckDone(false),
@@ -174,6 +174,8 @@ ScannerThread::ScannerThread(ManagerWindow & window,
     ODL_ENTER(); //####
     ODL_S1s("name = ", name); //####
     ODL_P1("window = ", &window); //####
+    _health._lastScanDuration = 0;
+    _health._lastScanTime = _health._scansCompleted = _health._scansFailed = 0;
     _inputOnlyPortName = Common::GetRandomChannelName(HIDDEN_CHANNEL_PREFIX_
                                                       "checkdirection/channel_");
     _outputOnlyPortName = Common::GetRandomChannelName(HIDDEN_CHANNEL_PREFIX_
@@ -645,6 +647,17 @@ ScannerThread::doScanSoon(void)
     ODL_OBJEXIT(); //####
 } // ScannerThread::doScanSoon
 
+void
+ScannerThread::getHealth(ScannerHealth & health)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("health = ", &health); //####
+    const ScopedLock lock(_healthLock);
+
+    health = _health;
+    ODL_OBJEXIT(); //####
+} // ScannerThread::getHealth
+
 bool
 ScannerThread::gatherEntities(Utilities::PortVector & detectedPorts,
                               Common::CheckFunction   checker,
@@ -653,6 +666,8 @@ ScannerThread::gatherEntities(Utilities::PortVector & detectedPorts,
     ODL_OBJENTER(); //####
     ODL_P2("detectedPorts = ", &detectedPorts, "checkStuff = ", checkStuff); //####
     bool  okSoFar;
+
+    _scanStartTime = Time::getMillisecondCounterHiRes();
 #if (defined(CHECK_FOR_STALE_PORTS_) && (! defined(DO_SINGLE_CHECK_FOR_STALE_PORTS_)))
     int64 now = Time::currentTimeMillis();
 #endif //defined(CHECK_FOR_STALE_PORTS_) && (! defined(DO_SINGLE_CHECK_FOR_STALE_PORTS_))
@@ -720,6 +735,26 @@ ScannerThread::gatherEntities(Utilities::PortVector & detectedPorts,
     return okSoFar;
 } // ScannerThread::gatherEntities
 
+void
+ScannerThread::recordScan(const bool succeeded)
+{
+    ODL_OBJENTER(); //####
+    ODL_B1("succeeded = ", succeeded); //####
+    const ScopedLock lock(_healthLock);
+
+    _health._lastScanDuration = (Time::getMillisecondCounterHiRes() - _scanStartTime);
+    if (succeeded)
+    {
+        _health._lastScanTime = Time::currentTimeMillis();
+        ++_health._scansCompleted;
+    }
+    else
+    {
+        ++_health._scansFailed;
+    }
+    ODL_OBJEXIT(); //####
+} // ScannerThread::recordScan
+
 void
 ScannerThread::relinquishFromRead(void)
 {
@@ -809,6 +844,7 @@ ScannerThread::run(void)
             int64 loopStartTime = Time::currentTimeMillis();
 
             addEntities(detectedPorts);
+            recordScan(true);
             // Indicate that the scan data is available.
             unconditionallyAcquireForWrite();
             _scanIsComplete = true;
@@ -966,6 +1002,8 @@ ScannerThread::run(void)
             bool shouldScanSoon = false;
             int  kk = (LONG_SLEEP_ / VERY_SHORT_SLEEP_);
 
+            recordScan(false);
+
             do
             {
                 bool locked = conditionallyAcquireForRead();
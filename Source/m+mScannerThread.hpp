@@ -106,6 +106,11 @@ namespace MPlusM_Manager
             return _workingData;
         } // getEntitiesData
 
+        /*! @brief Return the figures that show how well the scanner is keeping up.
+         @param[out] health The figures for the scanner. */
+        void
+        getHealth(ScannerHealth & health);
+
         /*! @brief Indicate that the scan data has been processed and the scan can proceed. */
         void
         scanCanProceed(void);
@@ -178,6 +183,11 @@ namespace MPlusM_Manager
                        MplusM::Common::CheckFunction   checker = NULL,
                        void *                          checkStuff = NULL);
 
+        /*! @brief Record the outcome of a scan.
+         @param[in] succeeded @c true if the scan gathered the ports and @c false otherwise. */
+        void
+        recordScan(const bool succeeded);
+
         /*! @brief Release access from reading from the shared resources. */
         void
         relinquishFromRead(void);
@@ -226,6 +236,12 @@ namespace MPlusM_Manager
         /*! @brief A lock to manage access to shared resources. */
         ReadWriteLock _lock;
 
+        /*! @brief A lock to manage access to the figures for the scanner. */
+        CriticalSection _healthLock;
+
+        /*! @brief The figures that show how well the scanner is keeping up. */
+        ScannerHealth _health;
+
         /*! @brief The name of the port used to determine if a port being checked can be used as an
          output. */
         YarpString _inputOnlyPortName;
@@ -239,6 +255,9 @@ namespace MPlusM_Manager
         int64 _lastStaleTime;
 # endif // defined(CHECK_FOR_STALE_PORTS_) && (! defined(DO_SINGLE_CHECK_FOR_STALE_PORTS_))
 
+        /*! @brief The time at which the current scan started, in milliseconds. */
+        double _scanStartTime;
+
         /*! @brief The port used to determine if a port being checked can be used as an output. */
         MplusM::Common::GeneralChannel * _inputOnlyPort;
 
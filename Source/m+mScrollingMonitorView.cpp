@@ -0,0 +1,313 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mScrollingMonitorView.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for the display of the messages received by a
+//              scrolling monitor.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-18
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mScrollingMonitorView.hpp"
+#include "m+mMonitorInputHandler.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for the display of the messages received by a scrolling monitor. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+using namespace std;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The colour to be used for the background of the display. */
+static const Colour & kBackgroundColour(Colours::black);
+
+/*! @brief The colour to be used for the summary line of the display. */
+static const Colour & kHeaderColour(Colours::yellow);
+
+/*! @brief The number of lines that are kept. */
+static const size_t kHistorySize = 2000;
+
+/*! @brief The time between refreshes of the display, in milliseconds. */
+static const int kRefreshInterval = 50;
+
+/*! @brief The time between measurements of the rate of the messages, in milliseconds. */
+static const int64 kRateInterval = 1000;
+
+/*! @brief The colour to be used for the lines of the display. */
+static const Colour & kTextColour(Colours::lightgreen);
+
+/*! @brief The height of the text of the display. */
+static const float kTextHeight = 13;
+
+/*! @brief The amount of space around the text of the display. */
+static const int kTextInset = 4;
+
+/*! @brief The number of lines moved for each step of the mouse wheel. */
+static const float kWheelLines = 10;
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Return the text for a line of the display.
+ @param[in] aRow The line of the display.
+ @returns The text for the line. */
+static String
+getRowText(const MonitorRow & aRow)
+{
+    ODL_ENTER(); //####
+    ODL_P1("aRow = ", &aRow); //####
+    Time   receivedTime(aRow._record._receivedTime);
+    String result(receivedTime.formatted("%H:%M:%S") + "." +
+                  String(receivedTime.getMilliseconds()).paddedLeft('0', 3) + " " +
+                  String(static_cast<int64>(aRow._record._size)).paddedLeft(' ', 8) + "  " +
+                  aRow._record._text);
+
+    if (0 < aRow._skipped)
+    {
+        result += String("  (+") + String(aRow._skipped) + " more)";
+    }
+    ODL_EXIT_s(result.toStdString()); //####
+    return result;
+} // getRowText
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+ScrollingMonitorView::ScrollingMonitorView(MonitorInputHandler & source) :
+    inherited1(), inherited2(), _incoming(), _rows(kHistorySize), _source(source), _bytesRate(0),
+    _messagesRate(0), _windowBytes(0), _windowMessages(0),
+    _windowStart(Time::currentTimeMillis()), _firstRow(0), _numRows(0), _scrollOffset(0)
+{
+    ODL_ENTER(); //####
+    ODL_P1("source = ", &source); //####
+    setOpaque(true);
+    startTimer(kRefreshInterval);
+    ODL_EXIT_P(this); //####
+} // ScrollingMonitorView::ScrollingMonitorView
+
+ScrollingMonitorView::~ScrollingMonitorView(void)
+{
+    ODL_OBJENTER(); //####
+    stopTimer();
+    ODL_OBJEXIT(); //####
+} // ScrollingMonitorView::~ScrollingMonitorView
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+ScrollingMonitorView::addRecords(const MonitorRecordList & records)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("records = ", &records); //####
+    size_t count = records.size();
+    size_t visibleRows = static_cast<size_t>(jmax(1, getVisibleRowCount()));
+    // When more messages arrive between refreshes than can be shown at once, only every n'th one
+    // gets its own line, and the line records how many were passed over.
+    size_t stride = jmax(static_cast<size_t>(1), (count + visibleRows - 1) / visibleRows);
+
+    for (size_t ii = 0; count > ii; ++ii)
+    {
+        const MonitorRecord & aRecord = records[ii];
+
+        _windowBytes += static_cast<int64>(aRecord._size);
+        ++_windowMessages;
+        if ((0 == (ii % stride)) || (0 == _numRows))
+        {
+            if (_rows.size() == _numRows)
+            {
+                // The oldest line is replaced.
+                _firstRow = ((_firstRow + 1) % _rows.size());
+            }
+            else
+            {
+                ++_numRows;
+            }
+            MonitorRow & aRow = getRow(_numRows - 1);
+
+            aRow._record = aRecord;
+            aRow._skipped = 0;
+            if (0 < _scrollOffset)
+            {
+                // Keep the lines that are being looked at in place.
+                _scrollOffset = jmin(_scrollOffset + 1, static_cast<int>(_numRows));
+            }
+        }
+        else
+        {
+            ++(getRow(_numRows - 1)._skipped);
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // ScrollingMonitorView::addRecords
+
+int
+ScrollingMonitorView::getVisibleRowCount(void)
+const
+{
+    ODL_OBJENTER(); //####
+    int lineHeight = static_cast<int>(kTextHeight);
+    // The top line of the display is used for the summary.
+    int result = jmax(0, ((getHeight() - (2 * kTextInset)) / lineHeight) - 1);
+
+    ODL_OBJEXIT_LL(result); //####
+    return result;
+} // ScrollingMonitorView::getVisibleRowCount
+
+#if (! MAC_OR_LINUX_)
+# pragma warning(push)
+# pragma warning(disable: 4100)
+#endif // ! MAC_OR_LINUX_
+void
+ScrollingMonitorView::mouseWheelMove(const MouseEvent &        ee,
+                                     const MouseWheelDetails & wheel)
+{
+#if (! defined(ODL_ENABLE_LOGGING_))
+# if MAC_OR_LINUX_
+#  pragma unused(ee)
+# endif // MAC_OR_LINUX_
+#endif // ! defined(ODL_ENABLE_LOGGING_)
+    ODL_OBJENTER(); //####
+    ODL_P2("ee = ", &ee, "wheel = ", &wheel); //####
+    int limit = jmax(0, static_cast<int>(_numRows) - getVisibleRowCount());
+
+    // Moving the wheel away from the user shows older lines.
+    _scrollOffset = jlimit(0, limit, _scrollOffset + roundToInt(wheel.deltaY * kWheelLines));
+    repaint();
+    ODL_OBJEXIT(); //####
+} // ScrollingMonitorView::mouseWheelMove
+#if (! MAC_OR_LINUX_)
+# pragma warning(pop)
+#endif // ! MAC_OR_LINUX_
+
+void
+ScrollingMonitorView::paint(Graphics & gg)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("gg = ", &gg); //####
+    juce::Rectangle<int> textArea(getLocalBounds().reduced(kTextInset));
+    int                  lineHeight = static_cast<int>(kTextHeight);
+    int                  visibleRows = getVisibleRowCount();
+    int                  lastRow = static_cast<int>(_numRows) - _scrollOffset;
+    int                  firstRow = jmax(0, lastRow - visibleRows);
+    String               summary(String(_messagesRate, 1) + " messages and " +
+                                 String(_bytesRate, 0) + " bytes per second, " +
+                                 String(_source.getDroppedCount()) + " discarded");
+
+    if (0 < _scrollOffset)
+    {
+        summary += String(", ") + String(_scrollOffset) + " newer lines hidden";
+    }
+    gg.fillAll(kBackgroundColour);
+    gg.setFont(Font(Font::getDefaultMonospacedFontName(), kTextHeight, Font::plain));
+    gg.setColour(kHeaderColour);
+    gg.drawText(summary, textArea.removeFromTop(lineHeight), Justification::centredLeft, true);
+    gg.setColour(kTextColour);
+    // The newest lines are at the bottom, and only the lines that need redrawing are formatted.
+    textArea.removeFromTop(textArea.getHeight() - (lineHeight * (lastRow - firstRow)));
+    for (int ii = firstRow; lastRow > ii; ++ii)
+    {
+        juce::Rectangle<int> lineArea(textArea.removeFromTop(lineHeight));
+
+        if (gg.clipRegionIntersects(lineArea))
+        {
+            gg.drawText(getRowText(getRow(static_cast<size_t>(ii))), lineArea,
+                        Justification::centredLeft, true);
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // ScrollingMonitorView::paint
+
+void
+ScrollingMonitorView::timerCallback(void)
+{
+    ODL_OBJENTER(); //####
+    int64 now = Time::currentTimeMillis();
+    bool  changed = false;
+
+    _source.readRecords(_incoming);
+    if (! _incoming.empty())
+    {
+        addRecords(_incoming);
+        changed = true;
+    }
+    if (kRateInterval <= (now - _windowStart))
+    {
+        double scale = (1000.0 / (now - _windowStart));
+
+        _bytesRate = (_windowBytes * scale);
+        _messagesRate = (_windowMessages * scale);
+        _windowBytes = _windowMessages = 0;
+        _windowStart = now;
+        changed = true;
+    }
+    if (changed)
+    {
+        repaint();
+    }
+    ODL_OBJEXIT(); //####
+} // ScrollingMonitorView::timerCallback
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
@@ -0,0 +1,176 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mScrollingMonitorView.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for the display of the messages received by a
+//              scrolling monitor.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-18
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmScrollingMonitorView_HPP_))
+# define mpmScrollingMonitorView_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for the display of the messages received by a scrolling monitor. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    class MonitorInputHandler;
+
+    /*! @brief A display of the messages received by a scrolling monitor.
+     The waiting messages are collected at a fixed rate. When more arrive between refreshes than
+     can be shown at once, they are combined into fewer lines, and a fixed number of lines is kept,
+     so that the cost of the display doesn't depend on the rate of the messages. */
+    class ScrollingMonitorView : public Component,
+                                 private Timer
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The first class that this class is derived from. */
+        typedef Component inherited1;
+
+        /*! @brief The second class that this class is derived from. */
+        typedef Timer inherited2;
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in] source The handler that receives the messages. */
+        explicit
+        ScrollingMonitorView(MonitorInputHandler & source);
+
+        /*! @brief The destructor. */
+        virtual
+        ~ScrollingMonitorView(void);
+
+    protected :
+
+    private :
+
+        /*! @brief Add newly-received messages to the lines of the display.
+         @param[in] records The messages to be added. */
+        void
+        addRecords(const MonitorRecordList & records);
+
+        /*! @brief Return a line of the display.
+         @param[in] index The position of the line, counting from the oldest line that is kept.
+         @returns The line of the display. */
+        inline MonitorRow &
+        getRow(const size_t index)
+        {
+            return _rows[(_firstRow + index) % _rows.size()];
+        } // getRow
+
+        /*! @brief Return the number of lines of messages that fit in the display.
+         @returns The number of lines of messages that fit in the display. */
+        int
+        getVisibleRowCount(void)
+        const;
+
+        /*! @brief Called when the mouse wheel is moved while over the display.
+         @param[in] ee Details about the position and status of the mouse event.
+         @param[in] wheel Details about the mouse wheel movement. */
+        virtual void
+        mouseWheelMove(const MouseEvent &        ee,
+                       const MouseWheelDetails & wheel);
+
+        /*! @brief Draw the content of the component.
+         @param[in] gg The graphics context in which to draw. */
+        virtual void
+        paint(Graphics & gg);
+
+        /*! @brief Called when the timer fires. */
+        virtual void
+        timerCallback(void);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The messages collected from the handler, kept to avoid reallocating it. */
+        MonitorRecordList _incoming;
+
+        /*! @brief The lines of the display, as a ring buffer. */
+        MonitorRowList _rows;
+
+        /*! @brief The handler that receives the messages. */
+        MonitorInputHandler & _source;
+
+        /*! @brief The number of bytes received per second, as of the last measurement. */
+        double _bytesRate;
+
+        /*! @brief The number of messages received per second, as of the last measurement. */
+        double _messagesRate;
+
+        /*! @brief The number of bytes received since the last measurement. */
+        int64 _windowBytes;
+
+        /*! @brief The number of messages received since the last measurement. */
+        int64 _windowMessages;
+
+        /*! @brief The time of the last measurement, in milliseconds. */
+        int64 _windowStart;
+
+        /*! @brief The position in the ring buffer of the oldest line. */
+        size_t _firstRow;
+
+        /*! @brief The number of lines in the ring buffer. */
+        size_t _numRows;
+
+        /*! @brief The number of lines between the newest line and the bottom of the display. */
+        int _scrollOffset;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ScrollingMonitorView)
+
+    }; // ScrollingMonitorView
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmScrollingMonitorView_HPP_)
@@ -0,0 +1,193 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mScrollingMonitorWindow.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for the window that shows the messages sent by a port.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-18
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mScrollingMonitorWindow.hpp"
+#include "m+mContentPanel.hpp"
+#include "m+mMonitorInputHandler.hpp"
+#include "m+mScrollingMonitorView.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for the window that shows the messages sent by a port. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+using namespace std;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The number of messages that can be waiting to be displayed. */
+static const int kBufferCapacity = 4096;
+
+/*! @brief The initial height of the window. */
+static const int kInitialHeight = 400;
+
+/*! @brief The initial width of the window. */
+static const int kInitialWidth = 720;
+
+/*! @brief The text added to the title of the window while the port is being connected. */
+static const char * kConnectingSuffix = " (connecting)";
+
+/*! @brief The text added to the title of the window if the port could not be connected. */
+static const char * kNotConnectedSuffix = " (not connected)";
+
+/*! @brief The colour to be used for the window background. */
+static const Colour & kWindowBackgroundColour(Colours::black);
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+ScrollingMonitorWindow::ScrollingMonitorWindow(ContentPanel &     owner,
+                                               const YarpString & portName) :
+    inherited1(String("Monitor ") + portName.c_str() + kConnectingSuffix, kWindowBackgroundColour,
+               inherited1::closeButton), inherited2("monitor connector"), _channelName(),
+    _portName(portName), _owner(owner), _handler(new MonitorInputHandler(kBufferCapacity)),
+    _channel(NULL)
+{
+    ODL_ENTER(); //####
+    ODL_P1("owner = ", &owner); //####
+    ODL_S1s("portName = ", portName); //####
+    setUsingNativeTitleBar(true);
+    setResizable(true, false);
+    setContentOwned(new ScrollingMonitorView(*_handler), false);
+    centreWithSize(kInitialWidth, kInitialHeight);
+    setVisible(true);
+    startThread();
+    ODL_EXIT_P(this); //####
+} // ScrollingMonitorWindow::ScrollingMonitorWindow
+
+ScrollingMonitorWindow::~ScrollingMonitorWindow(void)
+{
+    ODL_OBJENTER(); //####
+    // The connection can't be interrupted, and the channel mustn't be released while it's being
+    // used, so the background work is allowed to finish.
+    stopThread(-1);
+    // The channel is closed first, so that no messages arrive while the handler and the display
+    // are going away.
+    if (_channel)
+    {
+#if defined(MpM_DoExplicitClose)
+        _channel->close();
+#endif // defined(MpM_DoExplicitClose)
+        Common::GeneralChannel::RelinquishChannel(_channel);
+    }
+    clearContentComponent();
+    ODL_OBJEXIT(); //####
+} // ScrollingMonitorWindow::~ScrollingMonitorWindow
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+ScrollingMonitorWindow::closeButtonPressed(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+    // This deletes the window, so it must be the last thing that is done.
+    _owner.removeScrollingMonitor(this);
+} // ScrollingMonitorWindow::closeButtonPressed
+
+void
+ScrollingMonitorWindow::run(void)
+{
+    ODL_OBJENTER(); //####
+    bool connected = false;
+
+    _channel = new Common::GeneralChannel(false);
+    if (_channel)
+    {
+        _channelName = Common::GetRandomChannelName(HIDDEN_CHANNEL_PREFIX_ "monitor_/"
+                                                    DEFAULT_CHANNEL_ROOT_);
+        _channel->setInputMode(true);
+        _channel->setOutputMode(false);
+        if ((! threadShouldExit()) && _channel->openWithRetries(_channelName, STANDARD_WAIT_TIME_))
+        {
+            _channel->setReader(*_handler);
+            connected = ((! threadShouldExit()) &&
+                         Utilities::NetworkConnectWithRetries(_portName, _channelName,
+                                                              STANDARD_WAIT_TIME_, false,
+                                                              CheckForExit, NULL));
+        }
+    }
+    // Because this is a background thread, we mustn't do any UI work without first grabbing a
+    // MessageManagerLock.
+    const MessageManagerLock mml(Thread::getCurrentThread());
+
+    // If something is trying to kill this job, the lock will fail, in which case the window is
+    // going away and its title doesn't matter.
+    if (mml.lockWasGained())
+    {
+        setName(String("Monitor ") + _portName.c_str() + (connected ? "" : kNotConnectedSuffix));
+    }
+    ODL_OBJEXIT(); //####
+} // ScrollingMonitorWindow::run
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
@@ -0,0 +1,140 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mScrollingMonitorWindow.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for the window that shows the messages sent by a port.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-18
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmScrollingMonitorWindow_HPP_))
+# define mpmScrollingMonitorWindow_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for the window that shows the messages sent by a port. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    class ContentPanel;
+    class MonitorInputHandler;
+
+    /*! @brief A window that shows the messages sent by a port.
+     A hidden channel is connected to the port for as long as the window is open. The channel is
+     opened and connected in the background, so that the window appears without waiting for the
+     network. */
+    class ScrollingMonitorWindow : public DocumentWindow,
+                                   private Thread
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The first class that this class is derived from. */
+        typedef DocumentWindow inherited1;
+
+        /*! @brief The second class that this class is derived from. */
+        typedef Thread inherited2;
+
+    public :
+
+        /*! @brief The constructor.
+         @param[in] owner The panel that displays the entities.
+         @param[in] portName The name of the port to be monitored. */
+        ScrollingMonitorWindow(ContentPanel &     owner,
+                               const YarpString & portName);
+
+        /*! @brief The destructor. */
+        virtual
+        ~ScrollingMonitorWindow(void);
+
+        /*! @brief Return the name of the monitored port.
+         @returns The name of the monitored port. */
+        inline const YarpString &
+        getPortName(void)
+        const
+        {
+            return _portName;
+        } // getPortName
+
+    protected :
+
+    private :
+
+        /*! @brief Called when the close button is pressed. */
+        virtual void
+        closeButtonPressed(void);
+
+        /*! @brief Open the hidden channel and connect the monitored port to it. */
+        virtual void
+        run(void);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The name of the hidden channel. */
+        YarpString _channelName;
+
+        /*! @brief The name of the monitored port. */
+        YarpString _portName;
+
+        /*! @brief The panel that displays the entities. */
+        ContentPanel & _owner;
+
+        /*! @brief The handler that receives the messages. */
+        ScopedPointer<MonitorInputHandler> _handler;
+
+        /*! @brief The hidden channel that the monitored port is connected to. */
+        MplusM::Common::GeneralChannel * _channel;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ScrollingMonitorWindow)
+
+    }; // ScrollingMonitorWindow
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmScrollingMonitorWindow_HPP_)
@@ -0,0 +1,363 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mStatisticsOverlay.cpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class definition for the display of drawing and update costs.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-18
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "m+mStatisticsOverlay.hpp"
+#include "m+mManagerApplication.hpp"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#include <algorithm>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class definition for the display of drawing and update costs. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Namespace references
+#endif // defined(__APPLE__)
+
+using namespace MplusM;
+using namespace MPlusM_Manager;
+using namespace std;
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The colour to be used for the background of the display. */
+static const Colour & kBackgroundColour(Colours::black);
+
+/*! @brief The first line of a file of measurements. */
+static const char * kFileHeader = "time,paint ms,paint median ms,paint 95th percentile ms,"
+                                  "update ms,layout ms,entities drawn,entities,ports drawn,ports,"
+                                  "connections drawn,connections,scan age ms";
+
+/*! @brief The number of lines of text in the display. */
+static const int kNumLines = 5;
+
+/*! @brief The number of frame times that are used for the percentiles. */
+static const size_t kPaintHistorySize = 120;
+
+/*! @brief The time between refreshes of the display, in milliseconds. */
+static const int kRefreshInterval = 1000;
+
+/*! @brief The environment variable that names the file that the measurements are written to. */
+static const char * kStatisticsFileVariable = "MPM_MANAGER_STATISTICS_FILE";
+
+/*! @brief The colour to be used for the text of the display. */
+static const Colour & kTextColour(Colours::lightgreen);
+
+/*! @brief The height of the text of the display. */
+static const float kTextHeight = 13;
+
+/*! @brief The amount of space around the text of the display. */
+static const int kTextInset = 4;
+
+/*! @brief The width of the display. */
+static const int kWidth = 330;
+
+#if defined(__APPLE__)
+# pragma mark Global constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+StatisticsOverlay::StatisticsOverlay(void) :
+    inherited1(), inherited2(), _paintTimes(), _sink(), _lastLayoutTime(0), _lastPaintTime(0),
+    _lastUpdateTime(0), _lastScanTime(0), _nextPaintSlot(0)
+{
+    ODL_ENTER(); //####
+    String filePath(ManagerApplication::getEnvironmentVar(kStatisticsFileVariable));
+
+    _lastCounts._connectionsDrawn = _lastCounts._connectionsTotal = 0;
+    _lastCounts._entitiesDrawn = _lastCounts._entitiesTotal = 0;
+    _lastCounts._portsDrawn = _lastCounts._portsTotal = 0;
+    if (0 < filePath.length())
+    {
+        // A relative path is taken from the directory that the application was started in.
+        File statisticsFile(File::getCurrentWorkingDirectory().getChildFile(filePath));
+        bool isNewFile = (! statisticsFile.existsAsFile()) || (0 == statisticsFile.getSize());
+
+        // The measurements are appended, so that several sessions can be compared.
+        _sink = new FileOutputStream(statisticsFile);
+        if (_sink->failedToOpen())
+        {
+            char buffer1[DATE_TIME_BUFFER_SIZE_];
+            char buffer2[DATE_TIME_BUFFER_SIZE_];
+
+            Utilities::GetDateAndTime(buffer1, sizeof(buffer1), buffer2, sizeof(buffer2));
+            std::cerr << buffer1 << " " << buffer2 << " Could not open " <<
+                        statisticsFile.getFullPathName().toStdString() << std::endl;
+            _sink = NULL;
+        }
+        else if (isNewFile)
+        {
+            _sink->writeText(String(kFileHeader) + "\n", false, false);
+        }
+    }
+    setInterceptsMouseClicks(false, false);
+    // An opaque display doesn't cause the entities behind it to be redrawn on each refresh, which
+    // would distort the frame times.
+    setOpaque(true);
+    setSize(kWidth, static_cast<int>(kNumLines * kTextHeight) + (2 * kTextInset));
+    setVisible(false);
+    updateTimer();
+    ODL_EXIT_P(this); //####
+} // StatisticsOverlay::StatisticsOverlay
+
+StatisticsOverlay::~StatisticsOverlay(void)
+{
+    ODL_OBJENTER(); //####
+    stopTimer();
+    _sink = NULL;
+    ODL_OBJEXIT(); //####
+} // StatisticsOverlay::~StatisticsOverlay
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+double
+StatisticsOverlay::getPaintPercentile(const double fraction)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_D1("fraction = ", fraction); //####
+    double result;
+
+    if (_paintTimes.empty())
+    {
+        result = 0;
+    }
+    else
+    {
+        std::vector<double>           sortedTimes(_paintTimes);
+        std::vector<double>::iterator nth(sortedTimes.begin() +
+                                          static_cast<ptrdiff_t>(fraction *
+                                                                 (sortedTimes.size() - 1)));
+
+        std::nth_element(sortedTimes.begin(), nth, sortedTimes.end());
+        result = *nth;
+    }
+    ODL_OBJEXIT_D(result); //####
+    return result;
+} // StatisticsOverlay::getPaintPercentile
+
+bool
+StatisticsOverlay::isCollecting(void)
+const
+{
+    ODL_OBJENTER(); //####
+    bool result = (isVisible() || (NULL != _sink));
+
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // StatisticsOverlay::isCollecting
+
+void
+StatisticsOverlay::paint(Graphics & gg)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("gg = ", &gg); //####
+    StringArray          lines;
+    juce::Rectangle<int> textArea(getLocalBounds().reduced(kTextInset));
+    int                  lineHeight = static_cast<int>(kTextHeight);
+    String               scanAge;
+
+    if (0 < _lastScanTime)
+    {
+        scanAge = String((Time::currentTimeMillis() - _lastScanTime) / 1000.0, 1) + " s";
+    }
+    else
+    {
+        scanAge = "no scan yet";
+    }
+    lines.add(String("Paint: ") + String(_lastPaintTime, 1) + " ms (median " +
+              String(getPaintPercentile(0.5), 1) + ", 95% " + String(getPaintPercentile(0.95), 1) +
+              ")");
+    lines.add(String("Update: ") + String(_lastUpdateTime, 1) + " ms, layout: " +
+              String(_lastLayoutTime, 1) + " ms");
+    lines.add(String("Entities: ") + String(static_cast<int>(_lastCounts._entitiesDrawn)) +
+              " of " + String(static_cast<int>(_lastCounts._entitiesTotal)) + ", ports: " +
+              String(static_cast<int>(_lastCounts._portsDrawn)) + " of " +
+              String(static_cast<int>(_lastCounts._portsTotal)));
+    lines.add(String("Connections: ") + String(static_cast<int>(_lastCounts._connectionsDrawn)) +
+              " of " + String(static_cast<int>(_lastCounts._connectionsTotal)));
+    lines.add(String("Scan age: ") + scanAge);
+    gg.fillAll(kBackgroundColour);
+    gg.setColour(kTextColour);
+    gg.setFont(Font(Font::getDefaultMonospacedFontName(), kTextHeight, Font::plain));
+    for (int ii = 0, mm = lines.size(); mm > ii; ++ii)
+    {
+        gg.drawText(lines[ii], textArea.removeFromTop(lineHeight), Justification::centredLeft,
+                    true);
+    }
+    ODL_OBJEXIT(); //####
+} // StatisticsOverlay::paint
+
+void
+StatisticsOverlay::recordFrame(const double          elapsedTime,
+                               const DrawingCounts & counts)
+{
+    ODL_OBJENTER(); //####
+    ODL_D1("elapsedTime = ", elapsedTime); //####
+    ODL_P1("counts = ", &counts); //####
+    _lastPaintTime = elapsedTime;
+    _lastCounts = counts;
+    // The frame times are kept in a ring, so that the percentiles reflect recent activity.
+    if (kPaintHistorySize > _paintTimes.size())
+    {
+        _paintTimes.push_back(elapsedTime);
+    }
+    else
+    {
+        _paintTimes[_nextPaintSlot] = elapsedTime;
+    }
+    _nextPaintSlot = (_nextPaintSlot + 1) % kPaintHistorySize;
+    ODL_OBJEXIT(); //####
+} // StatisticsOverlay::recordFrame
+
+void
+StatisticsOverlay::recordLayout(const double elapsedTime)
+{
+    ODL_OBJENTER(); //####
+    ODL_D1("elapsedTime = ", elapsedTime); //####
+    _lastLayoutTime = elapsedTime;
+    ODL_OBJEXIT(); //####
+} // StatisticsOverlay::recordLayout
+
+void
+StatisticsOverlay::recordUpdate(const double elapsedTime)
+{
+    ODL_OBJENTER(); //####
+    ODL_D1("elapsedTime = ", elapsedTime); //####
+    _lastUpdateTime = elapsedTime;
+    _lastScanTime = Time::currentTimeMillis();
+    ODL_OBJEXIT(); //####
+} // StatisticsOverlay::recordUpdate
+
+void
+StatisticsOverlay::setShown(const bool showIt)
+{
+    ODL_OBJENTER(); //####
+    ODL_B1("showIt = ", showIt); //####
+    setVisible(showIt);
+    updateTimer();
+    ODL_OBJEXIT(); //####
+} // StatisticsOverlay::setShown
+
+void
+StatisticsOverlay::timerCallback(void)
+{
+    ODL_OBJENTER(); //####
+    if (isVisible())
+    {
+        repaint();
+    }
+    if (_sink)
+    {
+        writeRecord();
+    }
+    ODL_OBJEXIT(); //####
+} // StatisticsOverlay::timerCallback
+
+void
+StatisticsOverlay::updateTimer(void)
+{
+    ODL_OBJENTER(); //####
+    if (isCollecting())
+    {
+        if (! isTimerRunning())
+        {
+            startTimer(kRefreshInterval);
+        }
+    }
+    else
+    {
+        stopTimer();
+    }
+    ODL_OBJEXIT(); //####
+} // StatisticsOverlay::updateTimer
+
+void
+StatisticsOverlay::writeRecord(void)
+{
+    ODL_OBJENTER(); //####
+    String record(Time::getCurrentTime().formatted("%Y-%m-%d %H:%M:%S"));
+    String scanAge;
+
+    if (0 < _lastScanTime)
+    {
+        scanAge = String(Time::currentTimeMillis() - _lastScanTime);
+    }
+    record += "," + String(_lastPaintTime, 3) + "," + String(getPaintPercentile(0.5), 3) + "," +
+              String(getPaintPercentile(0.95), 3) + "," + String(_lastUpdateTime, 3) + "," +
+              String(_lastLayoutTime, 3) + "," +
+              String(static_cast<int>(_lastCounts._entitiesDrawn)) + "," +
+              String(static_cast<int>(_lastCounts._entitiesTotal)) + "," +
+              String(static_cast<int>(_lastCounts._portsDrawn)) + "," +
+              String(static_cast<int>(_lastCounts._portsTotal)) + "," +
+              String(static_cast<int>(_lastCounts._connectionsDrawn)) + "," +
+              String(static_cast<int>(_lastCounts._connectionsTotal)) + "," + scanAge + "\n";
+    _sink->writeText(record, false, false);
+    _sink->flush();
+    ODL_OBJEXIT(); //####
+} // StatisticsOverlay::writeRecord
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
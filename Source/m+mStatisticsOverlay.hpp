@@ -0,0 +1,180 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       m+mStatisticsOverlay.hpp
+//
+//  Project:    m+m
+//
+//  Contains:   The class declaration for the display of drawing and update costs.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-18
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(mpmStatisticsOverlay_HPP_))
+# define mpmStatisticsOverlay_HPP_ /* Header guard */
+
+# include "m+mManagerDataTypes.hpp"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+
+ @brief The class declaration for the display of drawing and update costs. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+namespace MPlusM_Manager
+{
+    /*! @brief A display of the time taken to draw, update and lay out the entities.
+     The same measurements can also be appended periodically to a file, as comma-separated values,
+     for later analysis. */
+    class StatisticsOverlay : public Component,
+                              private Timer
+    {
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The first class that this class is derived from. */
+        typedef Component inherited1;
+
+        /*! @brief The second class that this class is derived from. */
+        typedef Timer inherited2;
+
+    public :
+
+        /*! @brief The constructor. */
+        StatisticsOverlay(void);
+
+        /*! @brief The destructor. */
+        virtual
+        ~StatisticsOverlay(void);
+
+        /*! @brief Return @c true if the measurements are being displayed or written to a file.
+         @returns @c true if the measurements are being used and @c false otherwise. */
+        bool
+        isCollecting(void)
+        const;
+
+        /*! @brief Record the measurements for a frame.
+         @param[in] elapsedTime The time taken to draw the frame, in milliseconds.
+         @param[in] counts The number of items that were drawn and the number that exist. */
+        void
+        recordFrame(const double          elapsedTime,
+                    const DrawingCounts & counts);
+
+        /*! @brief Record the time taken to lay out the entities.
+         @param[in] elapsedTime The time taken by the layout, in milliseconds. */
+        void
+        recordLayout(const double elapsedTime);
+
+        /*! @brief Record the time taken to update the entities from a scan.
+         @param[in] elapsedTime The time taken by the update, in milliseconds. */
+        void
+        recordUpdate(const double elapsedTime);
+
+        /*! @brief Change whether the measurements are displayed.
+         @param[in] showIt @c true if the measurements are to be displayed and @c false
+         otherwise. */
+        void
+        setShown(const bool showIt);
+
+    protected :
+
+    private :
+
+        /*! @brief Return a percentile of the recent frame times.
+         @param[in] fraction The fraction of the frame times that are at or below the result.
+         @returns The frame time in milliseconds, or zero if no frames have been recorded. */
+        double
+        getPaintPercentile(const double fraction)
+        const;
+
+        /*! @brief Draw the content of the component.
+         @param[in,out] gg The graphics context in which to draw. */
+        virtual void
+        paint(Graphics & gg);
+
+        /*! @brief Called periodically to refresh the display and write the measurements. */
+        virtual void
+        timerCallback(void);
+
+        /*! @brief Start or stop the periodic refresh, depending on whether the measurements are
+         being used. */
+        void
+        updateTimer(void);
+
+        /*! @brief Append the current measurements to the file. */
+        void
+        writeRecord(void);
+
+    public :
+
+    protected :
+
+    private :
+
+        /*! @brief The most recent frame times, in milliseconds. */
+        std::vector<double> _paintTimes;
+
+        /*! @brief The file that the measurements are written to, if any. */
+        ScopedPointer<FileOutputStream> _sink;
+
+        /*! @brief The number of items drawn in the most recent frame. */
+        DrawingCounts _lastCounts;
+
+        /*! @brief The time taken by the most recent layout, in milliseconds. */
+        double _lastLayoutTime;
+
+        /*! @brief The time taken to draw the most recent frame, in milliseconds. */
+        double _lastPaintTime;
+
+        /*! @brief The time taken by the most recent update, in milliseconds. */
+        double _lastUpdateTime;
+
+        /*! @brief The time at which the displayed scan was received, in milliseconds since the
+         epoch, or zero if no scan has been received. */
+        int64 _lastScanTime;
+
+        /*! @brief The position in the frame times for the next frame. */
+        size_t _nextPaintSlot;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StatisticsOverlay)
+
+    }; // StatisticsOverlay
+
+} // MPlusM_Manager
+
+#endif // ! defined(mpmStatisticsOverlay_HPP_)